@@ -0,0 +1,181 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <algorithm>
+#include <iterator>
+#include "ColumnAnalyzer.h"
+#include "ParallelProcessor.h"
+#include "Console.h"
+
+using namespace std;
+using namespace chrono;
+
+/**
+ * False sharing when workers publish results of many cheap columns
+ *
+ * Every column has a handful of rows, so writing the result costs about as
+ * much as computing it. Layouts compared:
+ *   shared-interleaved  workers take columns round-robin and write results[i]
+ *                       in the shared vector: neighbours write adjacent objects
+ *   shared-blocked      contiguous column ranges written into the shared
+ *                       vector (previous processWithThreads layout)
+ *   slots               each worker fills a cache-line-aligned local slot,
+ *                       published after the join (current layout)
+ *   processor           ParallelProcessor::process with THREADS
+ * plus the bare write pattern with 16-byte counters, packed vs padded to
+ * 64 bytes, where the contention is not hidden by the analysis work.
+ *
+ * Usage: bench_false_sharing [columns] [rowsPerColumn] [maxThreads] (default: 20000 4 hw)
+ */
+
+namespace {
+
+    struct alignas(64) Slot {
+        vector<ColumnResult> results;
+    };
+
+    struct PackedCounter {
+        size_t count = 0;
+        size_t column = 0;
+    };
+
+    struct alignas(64) PaddedCounter {
+        size_t count = 0;
+        size_t column = 0;
+    };
+
+    template <typename F>
+    double bestOf(size_t repeats, F&& run) {
+        double best = 1e100;
+        for (size_t r = 0; r < repeats; ++r) {
+            auto start = steady_clock::now();
+            run();
+            best = min(best, duration<double>(steady_clock::now() - start).count());
+        }
+        return best;
+    }
+
+    template <typename Worker>
+    void onThreads(size_t threads, Worker&& worker) {
+        vector<thread> pool;
+        for (size_t t = 0; t < threads; ++t) {
+            pool.emplace_back([&worker, t]() { worker(t); });
+        }
+        for (auto& thread : pool) {
+            thread.join();
+        }
+    }
+
+    template <typename Counter>
+    double counterWrites(size_t threads, size_t counters, size_t rounds) {
+        vector<Counter> slots(counters);
+        return bestOf(3, [&]() {
+            onThreads(threads, [&](size_t t) {
+                for (size_t r = 0; r < rounds; ++r) {
+                    for (size_t i = t; i < counters; i += threads) {
+                        slots[i].count += r;
+                        slots[i].column = i;
+                    }
+                }
+            });
+        });
+    }
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const size_t columnCount = argc > 1 ? stoul(argv[1]) : 20000;
+    const size_t rows = argc > 2 ? stoul(argv[2]) : 4;
+    size_t maxThreads = argc > 3 ? stoul(argv[3]) : thread::hardware_concurrency();
+    maxThreads = max<size_t>(maxThreads, 1);
+
+    vector<vector<string>> columns(columnCount);
+    for (size_t c = 0; c < columnCount; ++c) {
+        for (size_t r = 0; r < rows; ++r) {
+            columns[c].push_back(to_string((c + r) % 3));
+        }
+    }
+    AnalyzerOptions options;
+    auto analyze = [&](size_t i) { return ColumnAnalyzer::analyze(i, columns[i], options); };
+
+    cout << "=== Result publishing: " << columnCount << " columns x " << rows << " rows ===" << endl;
+    cout << "sizeof(ColumnResult) = " << sizeof(ColumnResult) << " bytes ("
+         << fixed << setprecision(1) << sizeof(ColumnResult) / 64.0 << " cache lines)" << endl;
+    cout << "Mcolumns/s, best of 3" << endl;
+    cout << setw(8) << "threads" << setw(20) << "shared-interleaved" << setw(16) << "shared-blocked"
+         << setw(10) << "slots" << setw(12) << "processor"
+         << setw(14) << "packed-16B" << setw(14) << "padded-64B" << endl;
+
+    Console::QuietScope quiet;  // ParallelProcessor logs every call
+    for (size_t threads = 1; threads <= maxThreads; threads *= 2) {
+        vector<ColumnResult> results;
+
+        // Every variant builds a fresh result vector, as process() does
+        double interleaved = bestOf(3, [&]() {
+            vector<ColumnResult> shared(columnCount);
+            onThreads(threads, [&](size_t t) {
+                for (size_t i = t; i < columnCount; i += threads) {
+                    shared[i] = analyze(i);
+                }
+            });
+            results = std::move(shared);
+        });
+
+        const size_t perThread = (columnCount + threads - 1) / threads;
+        double blocked = bestOf(3, [&]() {
+            vector<ColumnResult> shared(columnCount);
+            onThreads(threads, [&](size_t t) {
+                const size_t end = min(columnCount, (t + 1) * perThread);
+                for (size_t i = t * perThread; i < end; ++i) {
+                    shared[i] = analyze(i);
+                }
+            });
+            results = std::move(shared);
+        });
+
+        double slotted = bestOf(3, [&]() {
+            vector<Slot> slots(threads);
+            onThreads(threads, [&](size_t t) {
+                const size_t begin = min(columnCount, t * perThread);
+                const size_t end = min(columnCount, (t + 1) * perThread);
+                slots[t].results.reserve(t == 0 ? columnCount : end - begin);
+                for (size_t i = begin; i < end; ++i) {
+                    slots[t].results.push_back(analyze(i));
+                }
+            });
+            results = std::move(slots[0].results);
+            for (size_t t = 1; t < threads; ++t) {
+                move(slots[t].results.begin(), slots[t].results.end(), back_inserter(results));
+            }
+        });
+
+        ParallelProcessor processor(threads, options);
+        double processed = bestOf(3, [&]() {
+            results = processor.process(columns, ParallelStrategy::THREADS);
+        });
+
+        // Bare writes: 64 rounds over one counter per column
+        const size_t rounds = 64;
+        double packed = counterWrites<PackedCounter>(threads, columnCount, rounds);
+        double padded = counterWrites<PaddedCounter>(threads, columnCount, rounds);
+
+        auto rate = [&](double seconds, size_t work) { return work / seconds / 1e6; };
+        cout << setw(8) << threads << setprecision(2)
+             << setw(20) << rate(interleaved, columnCount)
+             << setw(16) << rate(blocked, columnCount)
+             << setw(10) << rate(slotted, columnCount)
+             << setw(12) << rate(processed, columnCount)
+             << setw(14) << rate(packed, columnCount * rounds)
+             << setw(14) << rate(padded, columnCount * rounds) << endl;
+
+        if (results.size() != columnCount || results.back().uniqueCount != min<size_t>(rows, 3)) {
+            cerr << "Unexpected result for the last column" << endl;
+            return 1;
+        }
+    }
+
+    return 0;
+}
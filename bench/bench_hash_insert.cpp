@@ -0,0 +1,121 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <string>
+#include <algorithm>
+#include "DistinctIndex.h"
+#include "CellHash.h"
+
+using namespace std;
+using namespace chrono;
+
+/**
+ * Throughput of DistinctIndex insertion vs table size
+ * Keys are 64-bit integers so the probe kernel dominates the measurement
+ *
+ * Usage: bench_hash_insert [maxLog2Distinct] (default: 22)
+ */
+
+namespace {
+
+    struct Workload {
+        vector<uint64_t> keys;
+        vector<uint64_t> hashes;
+    };
+
+    Workload makeWorkload(size_t distinct, size_t rows, mt19937_64& rng) {
+        Workload w;
+        w.keys.resize(rows);
+        w.hashes.resize(rows);
+
+        uniform_int_distribution<size_t> pick(0, distinct - 1);
+        for (size_t i = 0; i < rows; ++i) {
+            // Every key appears at least once, the rest are random repeats
+            w.keys[i] = i < distinct ? i * 0x9e3779b97f4a7c15ull : pick(rng) * 0x9e3779b97f4a7c15ull;
+        }
+        shuffle(w.keys.begin(), w.keys.end(), rng);
+
+        for (size_t i = 0; i < rows; ++i) {
+            w.hashes[i] = CellHash::hashBytes(reinterpret_cast<const char*>(&w.keys[i]), sizeof(uint64_t));
+        }
+        return w;
+    }
+
+    double runSerial(const Workload& w, size_t& distinctOut) {
+        auto start = high_resolution_clock::now();
+
+        DistinctIndex index;
+        for (size_t row = 0; row < w.keys.size(); ++row) {
+            index.insert(w.hashes[row], row, [&](size_t other) {
+                return w.keys[other] == w.keys[row];
+            });
+        }
+
+        auto end = high_resolution_clock::now();
+        distinctOut = index.size();
+        return duration<double>(end - start).count();
+    }
+
+    double runBatched(const Workload& w, size_t batchSize, size_t& distinctOut) {
+        auto start = high_resolution_clock::now();
+
+        DistinctIndex index;
+        auto equalsRows = [&](size_t a, size_t b) { return w.keys[a] == w.keys[b]; };
+        for (size_t row = 0; row < w.keys.size(); row += batchSize) {
+            size_t count = min(batchSize, w.keys.size() - row);
+            index.insertBatch(w.hashes.data() + row, row, count, equalsRows);
+        }
+
+        auto end = high_resolution_clock::now();
+        distinctOut = index.size();
+        return duration<double>(end - start).count();
+    }
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t maxLog2 = argc > 1 ? stoul(argv[1]) : 22;
+    const vector<size_t> batchSizes = {16, 32, 64};
+
+    mt19937_64 rng(12345);
+
+    cout << "=== DistinctIndex insertion throughput (Mrows/s) ===" << endl;
+    cout << setw(10) << "distinct" << setw(12) << "table_MB" << setw(10) << "serial";
+    for (size_t b : batchSizes) {
+        cout << setw(10) << ("batch" + to_string(b));
+    }
+    cout << endl;
+
+    for (size_t log2 = 12; log2 <= maxLog2; log2 += 2) {
+        const size_t distinct = size_t{1} << log2;
+        const size_t rows = distinct * 2;
+        Workload w = makeWorkload(distinct, rows, rng);
+
+        // Slot array is sized to keep load <= 3/4; each slot is 16 bytes
+        size_t slots = 16;
+        while (slots * 3 < distinct * 4) slots <<= 1;
+        double tableMB = static_cast<double>(slots * 16) / (1024.0 * 1024.0);
+
+        size_t found = 0;
+        double serial = runSerial(w, found);
+
+        cout << setw(10) << distinct
+             << setw(12) << fixed << setprecision(2) << tableMB
+             << setw(10) << setprecision(1) << rows / serial / 1e6;
+
+        for (size_t b : batchSizes) {
+            size_t foundBatched = 0;
+            double t = runBatched(w, b, foundBatched);
+            if (foundBatched != found) {
+                cerr << "Mismatch: batched found " << foundBatched << ", serial " << found << endl;
+                return 1;
+            }
+            cout << setw(10) << rows / t / 1e6;
+        }
+        cout << endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,111 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <vector>
+#include <chrono>
+#include <string>
+#include <algorithm>
+#include "ColumnAnalyzer.h"
+#include "DistinctIndex.h"
+#include "HugePageResource.h"
+#include "WorkerArena.h"
+#include "CellHash.h"
+
+using namespace std;
+using namespace chrono;
+
+/**
+ * ColumnAnalyzer throughput with analyzer scratch memory on 4 KB pages
+ * (off) vs 2 MB pages (thp, explicit)
+ *
+ * For each mode the worker arena is emptied, so the hash index slots and
+ * sort keys of the run are mapped afresh in that mode. Columns have
+ * rows / 4 distinct values spread uniformly, so index probes land on
+ * random slots. "index" times DistinctIndex insertion alone over
+ * precomputed hashes; "hash" and "sort" time the full backends.
+ * AnonHugePages shows how much memory the kernel actually backed with
+ * transparent huge pages after the run.
+ *
+ * Usage: bench_huge_pages [rows] (default: 8000000)
+ */
+
+namespace {
+
+    template <typename F>
+    double bestOf(int runs, F&& f) {
+        double best = 1e300;
+        for (int i = 0; i < runs; ++i) {
+            auto start = steady_clock::now();
+            f();
+            best = min(best, duration<double>(steady_clock::now() - start).count());
+        }
+        return best;
+    }
+
+    /**
+     * AnonHugePages of the process in kB (0 where /proc is unavailable)
+     */
+    size_t anonHugePagesKb() {
+        ifstream rollup("/proc/self/smaps_rollup");
+        string line;
+        while (getline(rollup, line)) {
+            if (line.rfind("AnonHugePages:", 0) == 0) {
+                return stoul(line.substr(line.find(':') + 1));
+            }
+        }
+        return 0;
+    }
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const size_t rows = argc > 1 ? stoul(argv[1]) : 8000000;
+    const size_t distinct = max<size_t>(rows / 4, 1);
+
+    // Multiplicative scatter keeps repeats of a value far apart
+    vector<string> column;
+    vector<uint64_t> hashes;
+    column.reserve(rows);
+    hashes.reserve(rows);
+    for (size_t i = 0; i < rows; ++i) {
+        column.push_back("k" + to_string((i * 2654435761ull) % distinct));
+        hashes.push_back(CellHash::hash(column.back()));
+    }
+
+    cout << "=== Huge pages: " << rows << " rows, " << distinct << " distinct ===" << endl;
+    cout << "Mrows/s, best of 3" << endl;
+    cout << setw(10) << "mode" << setw(10) << "index" << setw(10) << "hash" << setw(10) << "sort"
+         << setw(14) << "mapped MB" << setw(12) << "fallbacks" << setw(18) << "AnonHugePages MB" << endl;
+
+    auto& resource = HugePageResource::instance();
+    const double mrows = static_cast<double>(rows) / 1e6;
+
+    for (auto [name, mode] : {pair{"off", HugePageMode::OFF},
+                              pair{"thp", HugePageMode::TRANSPARENT},
+                              pair{"explicit", HugePageMode::EXPLICIT}}) {
+        WorkerArena::local().release();
+        resource.setMode(mode);
+
+        double index = bestOf(3, [&]() {
+            DistinctIndex distinctIndex(0, &WorkerArena::local());
+            for (size_t row = 0; row < rows; row += 32) {
+                distinctIndex.insertBatch(hashes.data() + row, row, min<size_t>(32, rows - row),
+                                          [&](size_t a, size_t b) { return column[a] == column[b]; });
+            }
+        });
+
+        AnalyzerOptions options;
+        double hashed = bestOf(3, [&]() { ColumnAnalyzer::analyze(0, column, options, &hashes); });
+        options.backend = DistinctBackend::SORT;
+        double sorted = bestOf(3, [&]() { ColumnAnalyzer::analyze(0, column, options); });
+
+        // Blocks are still cached in the arena, so the mappings are live here
+        auto stats = resource.stats();
+        cout << setw(10) << name << fixed << setprecision(1)
+             << setw(10) << mrows / index << setw(10) << mrows / hashed << setw(10) << mrows / sorted
+             << setw(14) << static_cast<double>(stats.transparentBytes + stats.explicitBytes) / (1 << 20)
+             << setw(12) << stats.fallbacks
+             << setw(18) << static_cast<double>(anonHugePagesKb()) / 1024 << endl;
+    }
+    return 0;
+}
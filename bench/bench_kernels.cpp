@@ -0,0 +1,172 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <string>
+#include <memory>
+#include <functional>
+#include <algorithm>
+#include "ColumnAnalyzer.h"
+#include "ColumnStatistics.h"
+#include "DistinctIndex.h"
+#include "CellHash.h"
+
+using namespace std;
+using namespace chrono;
+
+/**
+ * Compile-time specialized kernels (ColumnAnalyzer::analyze) vs the same
+ * algorithm assembled at runtime: std::function hash, virtual set interface,
+ * virtual statistics aggregations and per-cell option branches
+ *
+ * Usage: bench_kernels [rows] (default: 1000000)
+ */
+
+namespace {
+
+    // ---- Runtime-polymorphic version ----
+
+    class RuntimeSet {
+    public:
+        virtual ~RuntimeSet() = default;
+        virtual void add(uint64_t hash, size_t row) = 0;
+        virtual void fill(ColumnResult& result) const = 0;
+    };
+
+    class RuntimeIndexSet : public RuntimeSet {
+    public:
+        explicit RuntimeIndexSet(const vector<string>& data) : data_(data) {}
+
+        void add(uint64_t hash, size_t row) override {
+            index_.insert(hash, row, [&](size_t other) { return data_[other] == data_[row]; });
+        }
+
+        void fill(ColumnResult& result) const override {
+            result.uniqueValues.reserve(index_.size());
+            for (size_t row : index_.rows()) {
+                result.uniqueValues.insert(data_[row]);
+            }
+            result.uniqueCount = index_.size();
+        }
+
+    private:
+        const vector<string>& data_;
+        DistinctIndex index_;
+    };
+
+    ColumnResult analyzeRuntime(const vector<string>& data,
+                                const AnalyzerOptions& options,
+                                const vector<uint64_t>* cellHashes) {
+        ColumnResult result;
+
+        function<uint64_t(const string&, size_t)> hash;
+        if (cellHashes != nullptr) {
+            hash = [cellHashes](const string&, size_t row) { return (*cellHashes)[row]; };
+        } else {
+            hash = [](const string& value, size_t) { return CellHash::hash(value); };
+        }
+
+        unique_ptr<StatisticsAccumulator> stats;
+        if (options.statistics != STAT_NONE) {
+            stats = make_unique<StatisticsAccumulator>(options.statistics);
+        }
+
+        unique_ptr<RuntimeSet> set = make_unique<RuntimeIndexSet>(data);
+        for (size_t row = 0; row < data.size(); ++row) {
+            set->add(hash(data[row], row), row);
+            if (stats) stats->update(data[row]);
+        }
+
+        set->fill(result);
+        if (stats) {
+            result.statistics = stats->finish();
+        }
+        return result;
+    }
+
+    // ---- Harness ----
+
+    vector<string> makeColumn(size_t rows, size_t distinct, mt19937_64& rng) {
+        uniform_int_distribution<size_t> pick(0, distinct - 1);
+        vector<string> column;
+        column.reserve(rows);
+        for (size_t i = 0; i < rows; ++i) {
+            column.push_back(to_string(pick(rng) * 7919 % 1000003));
+        }
+        return column;
+    }
+
+    template <typename F>
+    double bestOf(size_t repeats, size_t& distinctOut, F&& analyze) {
+        double best = 1e30;
+        for (size_t i = 0; i < repeats; ++i) {
+            auto start = high_resolution_clock::now();
+            ColumnResult result = analyze();
+            auto end = high_resolution_clock::now();
+            distinctOut = result.uniqueCount;
+            best = min(best, duration<double>(end - start).count());
+        }
+        return best;
+    }
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t rows = argc > 1 ? stoul(argv[1]) : 1000000;
+    mt19937_64 rng(12345);
+
+    struct Workload {
+        string name;
+        vector<string> column;
+        vector<uint64_t> hashes;
+    };
+
+    vector<Workload> workloads;
+    workloads.push_back({"distinct=100", makeColumn(rows, 100, rng), {}});
+    workloads.push_back({"distinct=rows/2", makeColumn(rows, max<size_t>(rows / 2, 1), rng), {}});
+    for (auto& w : workloads) {
+        for (const auto& value : w.column) {
+            w.hashes.push_back(CellHash::hash(value));
+        }
+    }
+
+    cout << "=== Specialized vs runtime-polymorphic analysis (" << rows << " rows, Mrows/s) ===" << endl;
+    cout << left << setw(18) << "column" << setw(12) << "stats" << setw(12) << "hashes"
+         << right << setw(10) << "runtime" << setw(12) << "templated" << setw(10) << "speedup" << endl;
+
+    for (const auto& w : workloads) {
+        for (unsigned flags : {unsigned{STAT_NONE}, unsigned{STAT_ALL}}) {
+            for (bool precomputed : {false, true}) {
+                AnalyzerOptions options;
+                options.statistics = flags;
+                const vector<uint64_t>* hashes = precomputed ? &w.hashes : nullptr;
+
+                size_t runtimeDistinct = 0;
+                size_t templatedDistinct = 0;
+                double runtimeTime = bestOf(3, runtimeDistinct, [&]() {
+                    return analyzeRuntime(w.column, options, hashes);
+                });
+                double templatedTime = bestOf(3, templatedDistinct, [&]() {
+                    return ColumnAnalyzer::analyze(0, w.column, options, hashes);
+                });
+
+                if (runtimeDistinct != templatedDistinct) {
+                    cerr << "Mismatch: runtime " << runtimeDistinct
+                         << ", templated " << templatedDistinct << endl;
+                    return 1;
+                }
+
+                cout << left << setw(18) << w.name
+                     << setw(12) << (flags == STAT_NONE ? "none" : "all")
+                     << setw(12) << (precomputed ? "reader" : "scan")
+                     << right << fixed << setprecision(1)
+                     << setw(10) << rows / runtimeTime / 1e6
+                     << setw(12) << rows / templatedTime / 1e6
+                     << setw(9) << setprecision(2) << runtimeTime / templatedTime << "x" << endl;
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,199 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <filesystem>
+#include <algorithm>
+#include <functional>
+#include "CSVReader.h"
+#include "Console.h"
+#include "ParallelProcessor.h"
+#include "PipelineExecutor.h"
+#include "ResultAggregator.h"
+
+using namespace std;
+using namespace chrono;
+
+/**
+ * End-to-end file analysis: read the whole table, analyze it with each
+ * fork/join ParallelStrategy and write the full results CSV, vs PIPELINE,
+ * where chunks are read, parsed and analyzed as coroutines and columns are
+ * written as they finish
+ *
+ * Every variant starts from the file (page cache warm after the first run)
+ * and uses the same block reader. Peak RSS is the process high-water mark
+ * of the run (reset through /proc/self/clear_refs where available).
+ *
+ * Usage: bench_pipeline [threads] [scale] (default: hardware threads, 1.0)
+ */
+
+namespace {
+
+    struct Shape {
+        string name;
+        size_t rows;
+        vector<size_t> distinct;  // Distinct values per column
+    };
+
+    string writeShape(const Shape& shape, const filesystem::path& dir) {
+        const string filename = (dir / ("pipeline_" + shape.name + ".csv")).string();
+        ofstream file(filename);
+        if (!file.is_open()) {
+            throw runtime_error("Failed to open benchmark file: " + filename);
+        }
+
+        mt19937_64 rng(12345);
+        for (size_t c = 0; c < shape.distinct.size(); ++c) {
+            file << (c ? "," : "") << "col" << c;
+        }
+        file << '\n';
+
+        string line;
+        for (size_t row = 0; row < shape.rows; ++row) {
+            line.clear();
+            for (size_t c = 0; c < shape.distinct.size(); ++c) {
+                if (c) line += ',';
+                line += "v";
+                line += to_string(rng() % max<size_t>(shape.distinct[c], 1) * 7919 % 1000003);
+            }
+            line += '\n';
+            file << line;
+        }
+        return filename;
+    }
+
+    /**
+     * Reset the peak RSS counter (Linux); false if not supported
+     */
+    bool resetPeakRss() {
+        ofstream clear("/proc/self/clear_refs");
+        clear << "5";
+        return static_cast<bool>(clear);
+    }
+
+    /**
+     * Peak RSS in MB since the last reset (0 if unknown)
+     */
+    double peakRssMb() {
+        ifstream status("/proc/self/status");
+        string line;
+        while (getline(status, line)) {
+            if (line.rfind("VmHWM:", 0) == 0) {
+                return stod(line.substr(6)) / 1024.0;
+            }
+        }
+        return 0.0;
+    }
+
+    /**
+     * Best of `runs` wall times; peak RSS of the best run
+     */
+    pair<double, double> measure(int runs, const function<size_t()>& f, size_t expectedDistinct) {
+        double best = 1e300;
+        double peak = 0.0;
+        for (int i = 0; i < runs; ++i) {
+            resetPeakRss();
+            auto start = steady_clock::now();
+            const size_t distinct = f();
+            const double seconds = duration<double>(steady_clock::now() - start).count();
+            if (distinct != expectedDistinct) {
+                throw runtime_error("Variants disagree: " + to_string(distinct) +
+                                    " vs " + to_string(expectedDistinct) + " distinct values");
+            }
+            if (seconds < best) {
+                best = seconds;
+                peak = peakRssMb();
+            }
+        }
+        return {best, peak};
+    }
+
+    /**
+     * Full results CSV as the fork/join strategies write it after analysis
+     */
+    void writeFullResults(const vector<ColumnResult>& results, const string& filename) {
+        ofstream file(filename);
+        file << ResultAggregator::kFullResultsHeader << '\n';
+        for (const auto& result : results) {
+            ResultAggregator::writeFullResultsLine(file, result, result.uniqueValues);
+        }
+    }
+
+    size_t totalDistinct(const vector<ColumnResult>& results) {
+        size_t total = 0;
+        for (const auto& result : results) {
+            total += result.uniqueCount;
+        }
+        return total;
+    }
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t threads = argc > 1 ? stoul(argv[1]) : thread::hardware_concurrency();
+    threads = max<size_t>(threads, 1);
+    const double scale = argc > 2 ? stod(argv[2]) : 1.0;
+    auto scaled = [scale](size_t rows) { return max<size_t>(static_cast<size_t>(rows * scale), 1); };
+
+    vector<Shape> shapes;
+    shapes.push_back({"low-cardinality", scaled(2000000), vector<size_t>(8, 100)});
+    shapes.push_back({"high-cardinality", scaled(1000000), vector<size_t>(4, 500000)});
+    {
+        Shape mixed{"mixed", scaled(500000), {}};
+        for (size_t c = 0; c < 12; ++c) {
+            mixed.distinct.push_back(size_t{4} << c);  // 4 .. 8K distinct
+        }
+        shapes.push_back(mixed);
+    }
+
+    const filesystem::path dir = filesystem::temp_directory_path() / "bench_pipeline";
+    filesystem::create_directories(dir);
+
+    cout << "=== Read + analyze + write: fork/join strategies vs pipeline (" << threads << " threads) ===" << endl;
+    cout << "Wall ms and peak RSS MB, best of 3" << endl;
+    cout << left << setw(18) << "shape" << setw(18) << "strategy" << right
+         << setw(10) << "wall ms" << setw(10) << "Mrows/s" << setw(12) << "peak MB" << endl;
+
+    Console::QuietScope quiet;
+    for (const auto& shape : shapes) {
+        const string filename = writeShape(shape, dir);
+        const string output = (dir / "pipeline_full.csv").string();
+        const double mrows = static_cast<double>(shape.rows) / 1e6;
+
+        AsyncReadOptions io;
+        const size_t expected = totalDistinct(PipelineExecutor(threads).run(filename));
+
+        auto report = [&](const string& name, pair<double, double> result) {
+            cout << left << setw(18) << shape.name << setw(18) << name << right << fixed
+                 << setprecision(0) << setw(10) << result.first * 1000.0
+                 << setprecision(2) << setw(10) << mrows / result.first
+                 << setprecision(0) << setw(12) << result.second << endl;
+        };
+
+        for (auto strategy : {ParallelStrategy::EXECUTION_POLICY, ParallelStrategy::THREADS,
+                              ParallelStrategy::ASYNC}) {
+            report(strategyToString(strategy), measure(3, [&]() {
+                CSVTable table = CSVReader::readTableAsync(filename, io);
+                ParallelProcessor processor(threads);
+                auto results = processor.process(table.columns, strategy);
+                writeFullResults(results, output);
+                return totalDistinct(results);
+            }, expected));
+        }
+
+        report("pipeline", measure(3, [&]() {
+            PipelineOptions pipeline;
+            pipeline.io = io;
+            pipeline.fullResultsFile = output;
+            return totalDistinct(PipelineExecutor(threads, {}, pipeline).run(filename));
+        }, expected));
+
+        filesystem::remove(filename);
+        filesystem::remove(output);
+    }
+    return 0;
+}
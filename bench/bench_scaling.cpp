@@ -0,0 +1,369 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <filesystem>
+#include <algorithm>
+#include <functional>
+#include <ctime>
+#include <unistd.h>
+#include "CSVReader.h"
+#include "ParallelProcessor.h"
+
+using namespace std;
+using namespace chrono;
+
+/**
+ * Scalability of the reader and of every ParallelStrategy
+ *
+ * For each table shape the CSV is read once per read path, then analyzed
+ * with THREADS at 1, 2, 4, ... max threads and once with the execution
+ * policy and std::async strategies (their parallelism is not set by the
+ * thread count, so they run at the hardware thread count). Every run
+ * records wall and CPU time, throughput, speedup and parallel efficiency
+ * against the 1-thread run, and bytes/s as a share of the memory bandwidth
+ * measured with a STREAM-style triad at the same thread count.
+ *
+ * Usage: bench_scaling [--threads N] [--scale S] [--repeats R] [--out prefix]
+ *   --threads  Largest thread count (default: hardware threads)
+ *   --scale    Multiplies the row count of every shape (default: 1.0)
+ *   --repeats  Best-of repeats per measurement (default: 3)
+ *   --out      Report files <prefix>.csv and <prefix>.json (default: scaling)
+ */
+
+namespace {
+
+    struct Shape {
+        string name;
+        size_t rows;
+        vector<size_t> distinct;  // Distinct values per column
+    };
+
+    struct Measurement {
+        string shape;
+        string phase;       // "read" or "analyze"
+        string variant;     // Read path or strategy
+        size_t threads = 1;
+        double wallSeconds = 0.0;
+        double cpuSeconds = 0.0;
+        size_t rows = 0;
+        size_t cells = 0;
+        size_t bytes = 0;   // Bytes streamed from memory (file bytes for reads)
+        double speedup = 1.0;
+        double efficiency = 1.0;
+        double bandwidth = 0.0;  // Measured triad bytes/s at this thread count
+    };
+
+    double cpuNow() {
+        timespec ts{};
+        clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+        return static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec) * 1e-9;
+    }
+
+    /**
+     * Silences the library's progress messages while measuring
+     */
+    class QuietCout {
+    public:
+        QuietCout() : saved_(cout.rdbuf(sink_.rdbuf())) {}
+        ~QuietCout() { cout.rdbuf(saved_); }
+
+    private:
+        ostringstream sink_;
+        streambuf* saved_;
+    };
+
+    /**
+     * Best wall time of `repeats` runs and the CPU time of that run
+     */
+    template <typename F>
+    pair<double, double> bestOf(size_t repeats, F&& body) {
+        double bestWall = 1e30;
+        double bestCpu = 0.0;
+        for (size_t i = 0; i < repeats; ++i) {
+            QuietCout quiet;
+            const double cpuStart = cpuNow();
+            auto start = steady_clock::now();
+            body();
+            const double wall = duration<double>(steady_clock::now() - start).count();
+            const double cpu = cpuNow() - cpuStart;
+            if (wall < bestWall) {
+                bestWall = wall;
+                bestCpu = cpu;
+            }
+        }
+        return {bestWall, bestCpu};
+    }
+
+    /**
+     * STREAM triad a[i] = b[i] + s * c[i] over arrays well beyond the LLC
+     * @return Bytes moved per second (three arrays of doubles)
+     */
+    double triadBandwidth(size_t threads, size_t repeats) {
+        const size_t n = size_t{8} << 20;
+        vector<double> a(n, 0.0), b(n, 1.0), c(n, 2.0);
+
+        auto [wall, cpu] = bestOf(repeats, [&]() {
+            vector<thread> workers;
+            const size_t chunk = (n + threads - 1) / threads;
+            for (size_t t = 0; t < threads; ++t) {
+                const size_t begin = min(n, t * chunk);
+                const size_t end = min(n, begin + chunk);
+                workers.emplace_back([&, begin, end]() {
+                    for (size_t i = begin; i < end; ++i) {
+                        a[i] = b[i] + 3.0 * c[i];
+                    }
+                });
+            }
+            for (auto& worker : workers) {
+                worker.join();
+            }
+        });
+        (void)cpu;
+        return 3.0 * static_cast<double>(n * sizeof(double)) / wall;
+    }
+
+    string writeShape(const Shape& shape, const filesystem::path& dir) {
+        const string filename = (dir / ("scaling_" + shape.name + ".csv")).string();
+        ofstream file(filename);
+        if (!file.is_open()) {
+            throw runtime_error("Failed to open benchmark file: " + filename);
+        }
+
+        mt19937_64 rng(12345);
+        for (size_t c = 0; c < shape.distinct.size(); ++c) {
+            file << (c ? "," : "") << "col" << c;
+        }
+        file << '\n';
+
+        string line;
+        for (size_t row = 0; row < shape.rows; ++row) {
+            line.clear();
+            for (size_t c = 0; c < shape.distinct.size(); ++c) {
+                if (c) line += ',';
+                const size_t value = rng() % max<size_t>(shape.distinct[c], 1);
+                line += "v";
+                line += to_string(value * 7919 % 1000003);
+            }
+            line += '\n';
+            file << line;
+        }
+        return filename;
+    }
+
+    size_t tableBytes(const vector<vector<string>>& columns) {
+        // String objects plus heap payload of values outside the SSO buffer
+        const size_t inlineCapacity = string().capacity();
+        size_t bytes = 0;
+        for (const auto& column : columns) {
+            for (const auto& value : column) {
+                bytes += sizeof(string) + (value.size() > inlineCapacity ? value.size() : 0);
+            }
+        }
+        return bytes;
+    }
+
+    vector<size_t> threadCounts(size_t maxThreads) {
+        vector<size_t> counts;
+        for (size_t t = 1; t < maxThreads; t *= 2) {
+            counts.push_back(t);
+        }
+        counts.push_back(maxThreads);
+        return counts;
+    }
+
+    string cpuModel() {
+        ifstream cpuinfo("/proc/cpuinfo");
+        string line;
+        while (getline(cpuinfo, line)) {
+            if (line.rfind("model name", 0) == 0) {
+                auto colon = line.find(':');
+                return colon == string::npos ? "" : line.substr(colon + 2);
+            }
+        }
+        return "unknown";
+    }
+
+    string jsonEscape(const string& s) {
+        string out;
+        for (char ch : s) {
+            if (ch == '"' || ch == '\\') out += '\\';
+            out += ch;
+        }
+        return out;
+    }
+
+    void writeReport(const vector<Measurement>& results, const string& prefix,
+                     size_t maxThreads, double scale) {
+        ofstream csv(prefix + ".csv");
+        csv << "shape,phase,variant,threads,rows,cells,bytes,wall_s,cpu_s,"
+               "mrows_per_s,mb_per_s,speedup,efficiency,bandwidth_gb_per_s,bandwidth_share\n";
+        csv << setprecision(6);
+        for (const auto& m : results) {
+            csv << m.shape << "," << m.phase << "," << m.variant << "," << m.threads << ","
+                << m.rows << "," << m.cells << "," << m.bytes << ","
+                << m.wallSeconds << "," << m.cpuSeconds << ","
+                << m.rows / m.wallSeconds / 1e6 << "," << m.bytes / m.wallSeconds / 1e6 << ","
+                << m.speedup << "," << m.efficiency << ","
+                << m.bandwidth / 1e9 << "," << m.bytes / m.wallSeconds / m.bandwidth << "\n";
+        }
+
+        char host[256] = {};
+        gethostname(host, sizeof(host) - 1);
+
+        ofstream json(prefix + ".json");
+        json << setprecision(6);
+        json << "{\n  \"machine\": {\"host\": \"" << jsonEscape(host)
+             << "\", \"cpu\": \"" << jsonEscape(cpuModel())
+             << "\", \"hardware_threads\": " << thread::hardware_concurrency()
+             << ", \"compiler\": \"" << jsonEscape(__VERSION__) << "\"},\n";
+        json << "  \"max_threads\": " << maxThreads << ",\n  \"scale\": " << scale << ",\n";
+        json << "  \"results\": [\n";
+        for (size_t i = 0; i < results.size(); ++i) {
+            const auto& m = results[i];
+            json << "    {\"shape\": \"" << m.shape << "\", \"phase\": \"" << m.phase
+                 << "\", \"variant\": \"" << m.variant << "\", \"threads\": " << m.threads
+                 << ", \"rows\": " << m.rows << ", \"cells\": " << m.cells
+                 << ", \"bytes\": " << m.bytes << ", \"wall_s\": " << m.wallSeconds
+                 << ", \"cpu_s\": " << m.cpuSeconds
+                 << ", \"mrows_per_s\": " << m.rows / m.wallSeconds / 1e6
+                 << ", \"mb_per_s\": " << m.bytes / m.wallSeconds / 1e6
+                 << ", \"speedup\": " << m.speedup
+                 << ", \"efficiency\": " << m.efficiency
+                 << ", \"bandwidth_gb_per_s\": " << m.bandwidth / 1e9
+                 << ", \"bandwidth_share\": " << m.bytes / m.wallSeconds / m.bandwidth << "}"
+                 << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+        json << "  ]\n}\n";
+    }
+
+    void printRow(const Measurement& m) {
+        cout << left << setw(14) << m.shape << setw(9) << m.phase << setw(18) << m.variant
+             << right << setw(4) << m.threads << fixed << setprecision(1)
+             << setw(10) << m.wallSeconds * 1e3
+             << setw(10) << m.cpuSeconds * 1e3
+             << setw(10) << m.rows / m.wallSeconds / 1e6
+             << setw(10) << m.bytes / m.wallSeconds / 1e6
+             << setprecision(2) << setw(9) << m.speedup
+             << setw(8) << m.efficiency
+             << setprecision(1) << setw(8) << 100.0 * m.bytes / m.wallSeconds / m.bandwidth << "%"
+             << endl;
+    }
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t maxThreads = max<size_t>(thread::hardware_concurrency(), 1);
+    double scale = 1.0;
+    size_t repeats = 3;
+    string prefix = "scaling";
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        string option = argv[i];
+        if (option == "--threads") maxThreads = max<size_t>(stoul(argv[i + 1]), 1);
+        else if (option == "--scale") scale = stod(argv[i + 1]);
+        else if (option == "--repeats") repeats = max<size_t>(stoul(argv[i + 1]), 1);
+        else if (option == "--out") prefix = argv[i + 1];
+        else {
+            cerr << "Unknown option: " << option << endl;
+            return 1;
+        }
+    }
+
+    auto scaled = [scale](size_t rows) { return max<size_t>(static_cast<size_t>(rows * scale), 1); };
+
+    vector<Shape> shapes;
+    shapes.push_back({"wide-short", scaled(20000), vector<size_t>(128, 1000)});
+    shapes.push_back({"narrow-tall", scaled(2000000), vector<size_t>(4, 100000)});
+    {
+        Shape mixed{"mixed", scaled(300000), {}};
+        for (size_t c = 0; c < 16; ++c) {
+            mixed.distinct.push_back(size_t{4} << c);  // 4 .. 128K distinct
+        }
+        shapes.push_back(mixed);
+    }
+
+    const auto counts = threadCounts(maxThreads);
+    const size_t hardwareThreads = max<size_t>(thread::hardware_concurrency(), 1);
+
+    // Memory bandwidth at every thread count used below
+    auto bandwidthAt = [&, cache = vector<pair<size_t, double>>()](size_t threads) mutable {
+        for (const auto& [t, bw] : cache) {
+            if (t == threads) return bw;
+        }
+        cache.emplace_back(threads, triadBandwidth(threads, repeats));
+        return cache.back().second;
+    };
+
+    cout << "=== Scaling (" << maxThreads << " threads max, scale " << scale << ") ===" << endl;
+    cout << left << setw(14) << "shape" << setw(9) << "phase" << setw(18) << "variant"
+         << right << setw(4) << "thr" << setw(10) << "wall ms" << setw(10) << "cpu ms"
+         << setw(10) << "Mrows/s" << setw(10) << "MB/s" << setw(9) << "speedup"
+         << setw(8) << "effic." << setw(9) << "% bw" << endl;
+
+    const auto dir = filesystem::temp_directory_path();
+    vector<Measurement> results;
+
+    for (const auto& shape : shapes) {
+        const string filename = writeShape(shape, dir);
+        const size_t fileBytes = filesystem::file_size(filename);
+        const size_t cells = shape.rows * shape.distinct.size();
+
+        // Reader: one thread per file
+        CSVTable table;
+        for (const string variant : {"stream", "pread"}) {
+            auto [wall, cpu] = bestOf(repeats, [&]() {
+                if (variant == "stream") {
+                    table = CSVReader::readTable(filename);
+                } else {
+                    AsyncReadOptions options;
+                    options.backend = IoBackend::PREAD;
+                    table = CSVReader::readTableAsync(filename, options);
+                }
+            });
+
+            Measurement m{shape.name, "read", variant, 1, wall, cpu, shape.rows, cells, fileBytes};
+            m.bandwidth = bandwidthAt(1);
+            results.push_back(m);
+            printRow(m);
+        }
+
+        const size_t bytes = tableBytes(table.columns);
+        double baseline = 0.0;
+
+        auto analyze = [&](ParallelStrategy strategy, size_t threads) {
+            ParallelProcessor processor(threads);
+            auto [wall, cpu] = bestOf(repeats, [&]() {
+                processor.process(table.columns, strategy);
+            });
+
+            Measurement m{shape.name, "analyze", strategyToString(strategy), threads,
+                          wall, cpu, shape.rows, cells, bytes};
+            if (baseline == 0.0) {
+                baseline = wall;
+            }
+            m.speedup = baseline / wall;
+            m.efficiency = m.speedup / static_cast<double>(threads);
+            m.bandwidth = bandwidthAt(threads);
+            results.push_back(m);
+            printRow(m);
+        };
+
+        for (size_t threads : counts) {
+            analyze(ParallelStrategy::THREADS, threads);
+        }
+        analyze(ParallelStrategy::EXECUTION_POLICY, hardwareThreads);
+        analyze(ParallelStrategy::ASYNC, hardwareThreads);
+
+        filesystem::remove(filename);
+    }
+
+    writeReport(results, prefix, maxThreads, scale);
+    cout << "\nReport saved to: " << prefix << ".csv, " << prefix << ".json" << endl;
+    return 0;
+}
@@ -3,10 +3,23 @@
 #include <vector>
 #include <chrono>
 #include <filesystem>
+#include <memory>
+#include <algorithm>
 #include "DataGenerator.h"
 #include "CSVReader.h"
 #include "ParallelProcessor.h"
 #include "ResultAggregator.h"
+#include "AnalyzerServer.h"
+#include "InputResolver.h"
+#include "MultiFileAnalyzer.h"
+#include "ProgressReporter.h"
+#include "SampleEstimator.h"
+#include "ThreadPool.h"
+#include "CancellationToken.h"
+#include "PerfCounters.h"
+#include "HugePageResource.h"
+#include "PipelineExecutor.h"
+#include <cmath>
 
 using namespace std;
 using namespace chrono;
@@ -17,20 +30,72 @@ void printHelp() {
     cout << "  Generate CSV:\n";
     cout << "    ./ColumnAnalyzer --generate --output <file> --rows <N> --cols <M>\n\n";
     cout << "  Analyze CSV:\n";
-    cout << "    ./ColumnAnalyzer --analyze --input <file> [--strategy <mode>] [--threads <N>]\n\n";
+    cout << "    ./ColumnAnalyzer --analyze --input <file> [--strategy <mode>] [--threads <N>] [--hash-once] [--batch <N>] [--stats <list>]\n";
+    cout << "                        [--io <stream|pread|uring>] [--direct] [--backend <hash|sort|bitmap|fingerprint|auto>]\n";
+    cout << "                        [--format <text|binary>] [--progress] [--status-file <path>] [--sample <N>]\n";
+    cout << "                        [--deadline <ms>] [--combinations <groups>] [--combination-mode <exact|hll>]\n";
+    cout << "                        [--perf-counters] [--huge-pages <off|thp|explicit>]\n";
+    cout << "                        [--fingerprint-bits <64|128>] [--verify-fingerprints] [--sorted]\n\n";
+    cout << "  Serve requests on a Unix domain socket:\n";
+    cout << "    ./ColumnAnalyzer --serve [--socket <path>] [--threads <N>] [--cache <N>]\n";
+    cout << "                        [--backend <name>] [--batch <N>] [--stats <list>]\n\n";
     cout << "  Options:\n";
     cout << "    --help              Show this help message\n";
     cout << "    --generate          Generate CSV file\n";
     cout << "    --analyze           Analyze CSV file\n";
+    cout << "    --serve             Run resident server (protocol: ANALYZE <path>, PING, STATS, SHUTDOWN)\n";
+    cout << "    --socket <path>     Server socket path (default: /tmp/column-analyzer.sock)\n";
+    cout << "    --cache <N>         Parsed tables kept in server LRU cache (default: 16)\n";
     cout << "    --output <file>     Output file path (default: data.csv)\n";
-    cout << "    --input <file>      Input file path\n";
+    cout << "    --input <spec>      Input file, directory, glob (\"shards/*.csv\") or comma-separated list;\n";
+    cout << "                        several files are merged by column header name\n";
     cout << "    --rows <N>          Number of rows (default: 10000)\n";
     cout << "    --cols <M>          Number of columns (default: 50)\n";
     cout << "    --strategy <mode>   Parallel strategy mode (default: 2)\n";
     cout << "                        1 = execution-policy (C++17 std::execution::par)\n";
     cout << "                        2 = threads (manual std::thread management)\n";
     cout << "                        3 = async (std::async tasks)\n";
-    cout << "    --threads <N>       Number of threads for mode 2 (default: 8)\n\n";
+    cout << "                        4 = pipeline (chunks read, parsed, analyzed and written as\n";
+    cout << "                            coroutines on the worker threads;\n";
+    cout << "                            a single input file; elsewhere the same as 2)\n";
+    cout << "    --threads <N>       Number of threads for modes 2 and 4 (default: 8)\n";
+    cout << "    --hash-once         Hash cells during parsing and reuse the hashes in analysis\n";
+    cout << "    --batch <N>         Batched prefetching hash-set insertion, N values per block (1-64)\n";
+    cout << "    --stats <list>      Extra per-column statistics in the same scan:\n";
+    cout << "                        nulls,minmax,lengths,numeric or all\n";
+    cout << "    --io <backend>      Read path (default: stream)\n";
+    cout << "                        stream = buffered line reader\n";
+    cout << "                        pread  = large block reads with readahead hints\n";
+    cout << "                        uring  = io_uring with several reads in flight (fails when unavailable)\n";
+    cout << "    --direct            Open input with O_DIRECT for pread/uring\n";
+    cout << "    --backend <name>    Distinct counting backend (default: hash)\n";
+    cout << "                        hash = hash set insertion\n";
+    cout << "                        sort = parallel sort + adjacent-unique count\n";
+    cout << "                        bitmap = roaring bitmap of single-byte or integer keys\n";
+    cout << "                        fingerprint = set of value hashes only, no values kept or written\n";
+    cout << "                        auto = per column, bitmap for small domains, sort for mostly-unique columns\n";
+    cout << "    --fingerprint-bits  Fingerprint width of the fingerprint backend: 64 (default) or 128\n";
+    cout << "    --verify-fingerprints  Recount exactly against the values and report fingerprint collisions\n";
+    cout << "    --format <name>     Unique values output (default: text)\n";
+    cout << "                        text   = <base>_full.csv, values joined with ';'\n";
+    cout << "                        binary = <base>_full.pcol, length-prefixed string arrays\n";
+    cout << "    --sorted            Write and print unique values in ascending byte order, so output files\n";
+    cout << "                        are identical across runs and strategies (parallel sort per column)\n";
+    cout << "    --progress          Print rows, rate, MB/s and ETA every second (generate/analyze)\n";
+    cout << "    --status-file <p>   Rewrite progress as JSON to <p> every second\n";
+    cout << "    --sample <N>        Preview: read N random 1 MB ranges spread across the file and\n";
+    cout << "                        estimate distinct counts and frequent values with 95% intervals\n";
+    cout << "    --deadline <ms>     Stop after <ms> milliseconds and write the columns finished so far\n";
+    cout << "                        (Ctrl-C stops the same way; press twice to kill)\n";
+    cout << "    --combinations <g>  Distinct tuple counts of column groups, e.g. \"0+1,city+zip\"\n";
+    cout << "                        (columns by index or header name; saved to <base>_combinations.csv)\n";
+    cout << "    --combination-mode  exact (default) or hll (HyperLogLog estimate, ~0.8% error)\n";
+    cout << "    --perf-counters     Cycles, instructions, cache and branch misses per phase (perf_event_open),\n";
+    cout << "                        reported as IPC and events per row\n";
+    cout << "    --huge-pages <mode> Pages for hash tables and sort keys of 2 MB and more (default: thp)\n";
+    cout << "                        off      = ordinary heap memory\n";
+    cout << "                        thp      = 2 MB-aligned mappings with madvise(MADV_HUGEPAGE)\n";
+    cout << "                        explicit = MAP_HUGETLB pool (vm.nr_hugepages), else thp\n\n";
     cout << "Examples:\n";
     cout << "  ./ColumnAnalyzer --generate --output data.csv --rows 10000 --cols 50\n";
     cout << "  ./ColumnAnalyzer --analyze --input data.csv --strategy 1\n";
@@ -39,13 +104,34 @@ void printHelp() {
 }
 
 struct Config {
-    string mode;           // "generate" or "analyze"
+    string mode;           // "generate", "analyze" or "serve"
     string outputFile = "data.csv";
+    bool outputGiven = false;
     string inputFile;
     size_t rows = 10000;
     size_t cols = 50;
     int strategyMode = 2;
     size_t numThreads = 8;
+    bool hashOnce = false;
+    size_t insertBatchSize = 0;
+    unsigned statistics = STAT_NONE;
+    string socketPath = "/tmp/column-analyzer.sock";
+    size_t cacheCapacity = 16;
+    string ioMode = "stream";
+    bool directIo = false;
+    string backend = "hash";
+    string format = "text";
+    bool progress = false;
+    string statusFile;
+    size_t sampleBlocks = 0;  // 0 = read the whole file
+    size_t deadlineMs = 0;    // 0 = no deadline
+    string combinations;      // Column groups, empty = none
+    string combinationMode = "exact";
+    bool perfCounters = false;
+    string hugePages = "thp";
+    unsigned fingerprintBits = 64;
+    bool verifyFingerprints = false;
+    bool sortedOutput = false;
 };
 
 Config parseArgs(int argc, char* argv[]) {
@@ -65,10 +151,15 @@ Config parseArgs(int argc, char* argv[]) {
         char firstChar = option.empty() ? '\0' : option[0];
 
         switch (firstChar) {
-            case 'h':  // --help
+            case 'h':  // --help, --hash-once, --huge-pages
                 if (option == "help") {
                     printHelp();
                     exit(0);
+                } else if (option == "hash-once") {
+                    config.hashOnce = true;
+                } else if (option == "huge-pages" && i + 1 < argc) {
+                    config.hugePages = argv[++i];
+                    hugePageModeFromString(config.hugePages);  // Validate early
                 }
                 break;
 
@@ -87,12 +178,51 @@ Config parseArgs(int argc, char* argv[]) {
             case 'o':  // --output
                 if (option == "output" && i + 1 < argc) {
                     config.outputFile = argv[++i];
+                    config.outputGiven = true;
                 }
                 break;
 
-            case 'i':  // --input
+            case 'i':  // --input, --io
                 if (option == "input" && i + 1 < argc) {
                     config.inputFile = argv[++i];
+                } else if (option == "io" && i + 1 < argc) {
+                    config.ioMode = argv[++i];
+                    if (config.ioMode != "stream" && config.ioMode != "pread" && config.ioMode != "uring") {
+                        cerr << "Invalid --io value: " << config.ioMode << endl;
+                        exit(1);
+                    }
+                }
+                break;
+
+            case 'd':  // --direct, --deadline
+                if (option == "direct") {
+                    config.directIo = true;
+                } else if (option == "deadline" && i + 1 < argc) {
+                    config.deadlineMs = stoul(argv[++i]);
+                }
+                break;
+
+            case 'f':  // --format, --fingerprint-bits
+                if (option == "format" && i + 1 < argc) {
+                    config.format = argv[++i];
+                    if (config.format != "text" && config.format != "binary") {
+                        cerr << "Invalid --format value: " << config.format << endl;
+                        exit(1);
+                    }
+                } else if (option == "fingerprint-bits" && i + 1 < argc) {
+                    config.fingerprintBits = static_cast<unsigned>(stoul(argv[++i]));
+                    if (config.fingerprintBits != 64 && config.fingerprintBits != 128) {
+                        cerr << "Invalid --fingerprint-bits value: " << config.fingerprintBits << endl;
+                        exit(1);
+                    }
+                }
+                break;
+
+            case 'p':  // --progress, --perf-counters
+                if (option == "progress") {
+                    config.progress = true;
+                } else if (option == "perf-counters") {
+                    config.perfCounters = true;
                 }
                 break;
 
@@ -102,15 +232,43 @@ Config parseArgs(int argc, char* argv[]) {
                 }
                 break;
 
-            case 'c':  // --cols
+            case 'b':  // --batch, --backend
+                if (option == "batch" && i + 1 < argc) {
+                    config.insertBatchSize = stoul(argv[++i]);
+                } else if (option == "backend" && i + 1 < argc) {
+                    config.backend = argv[++i];
+                    backendFromString(config.backend);  // Validate early
+                }
+                break;
+
+            case 'c':  // --cols, --cache, --combinations, --combination-mode
                 if (option == "cols" && i + 1 < argc) {
                     config.cols = stoul(argv[++i]);
+                } else if (option == "cache" && i + 1 < argc) {
+                    config.cacheCapacity = stoul(argv[++i]);
+                } else if (option == "combinations" && i + 1 < argc) {
+                    config.combinations = argv[++i];
+                } else if (option == "combination-mode" && i + 1 < argc) {
+                    config.combinationMode = argv[++i];
+                    combinationModeFromString(config.combinationMode);  // Validate early
                 }
                 break;
 
-            case 's':  // --strategy
+            case 's':  // --strategy, --stats, --serve, --socket, --status-file, --sample, --sorted
                 if (option == "strategy" && i + 1 < argc) {
                     config.strategyMode = stoi(argv[++i]);
+                } else if (option == "stats" && i + 1 < argc) {
+                    config.statistics = statisticsFromString(argv[++i]);
+                } else if (option == "serve") {
+                    config.mode = "serve";
+                } else if (option == "socket" && i + 1 < argc) {
+                    config.socketPath = argv[++i];
+                } else if (option == "status-file" && i + 1 < argc) {
+                    config.statusFile = argv[++i];
+                } else if (option == "sample" && i + 1 < argc) {
+                    config.sampleBlocks = stoul(argv[++i]);
+                } else if (option == "sorted") {
+                    config.sortedOutput = true;
                 }
                 break;
 
@@ -120,6 +278,12 @@ Config parseArgs(int argc, char* argv[]) {
                 }
                 break;
 
+            case 'v':  // --verify-fingerprints
+                if (option == "verify-fingerprints") {
+                    config.verifyFingerprints = true;
+                }
+                break;
+
             default:
                 cerr << "Unknown argument: " << arg << endl;
                 cerr << "Use --help for usage information" << endl;
@@ -130,6 +294,16 @@ Config parseArgs(int argc, char* argv[]) {
     return config;
 }
 
+/**
+ * Background progress reporter requested on the command line, if any
+ */
+unique_ptr<ProgressReporter> makeProgressReporter(const Config& config) {
+    if (!config.progress && config.statusFile.empty()) {
+        return nullptr;
+    }
+    return make_unique<ProgressReporter>(milliseconds(1000), config.progress, config.statusFile);
+}
+
 void generateMode(const Config& config) {
     cout << "=== Generate Mode ===" << endl;
     cout << "Output file: " << config.outputFile << endl;
@@ -141,15 +315,173 @@ void generateMode(const Config& config) {
     }
 
     DataGenerator generator;
+    auto progress = makeProgressReporter(config);
+    if (progress) progress->beginPhase("generate", config.rows);
 
     auto start = chrono::high_resolution_clock::now();
     generator.generateCSV(config.outputFile, config.rows, config.cols);
     auto end = chrono::high_resolution_clock::now();
 
+    if (progress) progress->endPhase();
+
     auto duration = chrono::duration_cast<chrono::milliseconds>(end - start);
     cout << "\nGeneration completed in " << duration.count() << " ms" << endl;
 }
 
+AnalyzerOptions analyzerOptionsFromConfig(const Config& config) {
+    AnalyzerOptions options;
+    options.insertBatchSize = config.insertBatchSize;
+    options.statistics = config.statistics;
+    options.backend = backendFromString(config.backend);
+    options.fingerprintBits = config.fingerprintBits;
+    options.verifyFingerprints = config.verifyFingerprints;
+    options.sortThreads = 0;  // Spare threads go to sorting wide columns
+    return options;
+}
+
+string stripExtension(const string& filename) {
+    string baseName = filename;
+
+    size_t dotPos = baseName.find_last_of('.');
+    if (dotPos != string::npos) {
+        baseName = baseName.substr(0, dotPos);
+    }
+    return baseName;
+}
+
+void writeResults(const Config& config,
+                  const vector<ColumnResult>& results,
+                  const string& outputBaseName,
+                  bool fullResultsWritten = false) {
+    ResultAggregator aggregator(config.sortedOutput, config.numThreads);
+    aggregator.printResults(results);
+    aggregator.printSummary(results);
+
+    aggregator.saveCountsToFile(results, outputBaseName + "_counts.csv");
+
+    // The fingerprint backend keeps counts only
+    const bool valuesKept = none_of(results.begin(), results.end(), [](const ColumnResult& result) {
+        return result.fingerprints.bits() != 0;
+    });
+
+    if (!valuesKept) {
+        cout << "Fingerprint backend: unique values not kept, " << outputBaseName
+             << (config.format == "binary" ? "_full.pcol" : "_full.csv") << " not written" << endl;
+    } else if (fullResultsWritten) {
+        // Streamed by the pipeline's write stage
+    } else if (config.format == "binary") {
+        aggregator.saveBinaryResultsToFile(results, outputBaseName + "_full.pcol");
+    } else {
+        aggregator.saveFullResultsToFile(results, outputBaseName + "_full.csv");
+    }
+
+    if (config.statistics != STAT_NONE) {
+        aggregator.printStatistics(results);
+        aggregator.saveStatisticsToFile(results, outputBaseName + "_stats.csv");
+    }
+
+    // For small CSVs
+    if (valuesKept && !results.empty() && results.size() <= 10) {
+        aggregator.printDetailedResults(results, 5);
+    }
+}
+
+/**
+ * Drop columns a cancelled run did not finish, listing them
+ */
+vector<ColumnResult> completedOnly(vector<ColumnResult>& results,
+                                   const vector<size_t>& incomplete) {
+    cout << "Incomplete columns (not written):";
+    for (size_t index : incomplete) {
+        cout << " " << index;
+    }
+    cout << endl;
+
+    vector<ColumnResult> completed;
+    for (auto& result : results) {
+        if (result.complete) {
+            completed.push_back(std::move(result));
+        }
+    }
+    return completed;
+}
+
+void analyzeFilesMode(const Config& config, const vector<string>& files) {
+    cout << "=== Analyze Mode (multiple files) ===" << endl;
+    cout << "Input: " << config.inputFile << " (" << files.size() << " files)" << endl;
+    cout << "Threads: " << config.numThreads << "\n" << endl;
+
+    MultiFileAnalyzer analyzer(config.numThreads, analyzerOptionsFromConfig(config));
+
+    // Reads and column analyses overlap, so progress follows the bytes read
+    auto progress = makeProgressReporter(config);
+    if (progress) {
+        uintmax_t totalBytes = 0;
+        for (const auto& file : files) {
+            error_code ec;
+            uintmax_t size = std::filesystem::file_size(file, ec);
+            totalBytes += ec ? 0 : size;
+        }
+        progress->beginPhase("read+analyze", 0, totalBytes);
+    }
+
+    auto start = high_resolution_clock::now();
+    auto results = analyzer.analyze(files);
+    auto end = high_resolution_clock::now();
+
+    if (progress) progress->endPhase();
+    auto duration = duration_cast<milliseconds>(end - start);
+
+    vector<size_t> incomplete;
+    for (const auto& result : results) {
+        if (!result.complete) {
+            incomplete.push_back(result.columnIndex);
+        }
+    }
+    if (!incomplete.empty()) {
+        results = completedOnly(results, incomplete);
+    }
+
+    writeResults(config, results,
+                 config.outputGiven ? stripExtension(config.outputFile) : "merged");
+
+    cout << "\n=== Performance ===" << endl;
+    cout << "Read + analysis + merge time: " << duration.count() << " ms" << endl;
+}
+
+/**
+ * Counters around consecutive phases of analyze mode (--perf-counters)
+ * Each phase gets a fresh counter group, so counts of threads started
+ * in one phase never leak into the next
+ */
+class PhaseProfiler {
+public:
+    explicit PhaseProfiler(bool enabled) : enabled_(enabled) {}
+
+    void begin() {
+        if (!enabled_) return;
+        counters_ = make_unique<PerfCounters>();
+        if (error_.empty()) error_ = counters_->error();
+        counters_->start();
+    }
+
+    void end(const string& name, size_t rows) {
+        if (!counters_) return;
+        phases_.push_back(PerfPhase{name, rows, counters_->stop()});
+        counters_.reset();
+    }
+
+    void print() const {
+        if (enabled_) ResultAggregator().printPerfCounters(phases_, error_);
+    }
+
+private:
+    bool enabled_;
+    unique_ptr<PerfCounters> counters_;
+    vector<PerfPhase> phases_;
+    string error_;
+};
+
 void analyzeMode(const Config& config) {
     cout << "=== Analyze Mode ===" << endl;
     cout << "Input file: " << config.inputFile << endl;
@@ -159,15 +491,48 @@ void analyzeMode(const Config& config) {
     if (strategy == ParallelStrategy::THREADS) {
         cout << "Threads: " << config.numThreads << endl;
     }
+    if (config.hashOnce) {
+        cout << "Hash-once: enabled" << endl;
+    }
+    if (config.insertBatchSize > 0) {
+        cout << "Batched insert: " << config.insertBatchSize << " values per block" << endl;
+    }
+    if (config.statistics != STAT_NONE) {
+        cout << "Statistics: enabled" << endl;
+    }
+    cout << "Backend: " << config.backend << endl;
     cout << endl;
 
     try {
         cout << "Reading CSV..." << endl;
 
+        auto progress = makeProgressReporter(config);
+        if (progress) {
+            error_code ec;
+            uintmax_t fileSize = std::filesystem::file_size(config.inputFile, ec);
+            progress->beginPhase("read", 0, ec ? 0 : fileSize);
+        }
+
+        // The readers parse each block as it arrives: read and parse are one phase
+        PhaseProfiler profiler(config.perfCounters);
+        profiler.begin();
+
         auto startRead = high_resolution_clock::now();
-        auto columns = CSVReader::readColumns(config.inputFile);
+        CSVTable table;
+        if (config.ioMode == "stream") {
+            table = CSVReader::readTable(config.inputFile, config.hashOnce);
+        } else {
+            AsyncReadOptions ioOptions;
+            ioOptions.backend = config.ioMode == "uring" ? IoBackend::IO_URING : IoBackend::PREAD;
+            ioOptions.direct = config.directIo;
+            table = CSVReader::readTableAsync(config.inputFile, ioOptions, config.hashOnce);
+        }
+        const auto& columns = table.columns;
         auto endRead = high_resolution_clock::now();
         auto readDuration = duration_cast<milliseconds>(endRead - startRead);
+        const size_t rowCount = columns.empty() ? 0 : columns[0].size();
+        profiler.end("read+parse", rowCount);
+        if (progress) progress->endPhase();
 
         cout << "Reading completed in " << readDuration.count() << " ms" << endl;
         cout << "Loaded: " << columns.size() << " columns × "
@@ -175,46 +540,197 @@ void analyzeMode(const Config& config) {
 
         cout << "Analyzing columns..." << endl;
 
-        ParallelProcessor processor(config.numThreads);
+        ParallelProcessor processor(config.numThreads, analyzerOptionsFromConfig(config));
+        if (progress) {
+            size_t rows = columns.empty() ? 0 : columns[0].size();
+            progress->beginPhase("analyze", rows * columns.size(), 0, columns.size());
+        }
 
+        profiler.begin();
         auto startAnalysis = high_resolution_clock::now();
-        auto results = processor.process(columns, strategy);
+        auto results = config.hashOnce
+                       ? processor.process(columns, table.cellHashes, strategy)
+                       : processor.process(columns, strategy);
         auto endAnalysis = high_resolution_clock::now();
+        profiler.end("analyze", rowCount);
         auto analysisDuration = duration_cast<milliseconds>(endAnalysis - startAnalysis);
+        if (progress) progress->endPhase();
 
         cout << "\nAnalysis completed in " << analysisDuration.count() << " ms" << endl;
 
-        ResultAggregator aggregator;
-        aggregator.printResults(results);
-        aggregator.printSummary(results);
-
-        string outputBaseName = config.inputFile;
-
-        size_t dotPos = outputBaseName.find_last_of('.');
-        if (dotPos != string::npos) {
-            outputBaseName = outputBaseName.substr(0, dotPos);
+        if (!processor.incompleteColumns().empty()) {
+            results = completedOnly(results, processor.incompleteColumns());
         }
-
-        aggregator.saveCountsToFile(results, outputBaseName + "_counts.csv");
-
-        aggregator.saveFullResultsToFile(results, outputBaseName + "_full.csv");
-
-        // For small CSVs
-        if (!results.empty() && results.size() <= 10) {
-            aggregator.printDetailedResults(results, 5);
+        profiler.begin();
+        writeResults(config, results, stripExtension(config.inputFile));
+        profiler.end("write", rowCount);
+
+        milliseconds combinationDuration{0};
+        if (!config.combinations.empty()) {
+            cout << endl;
+            auto groups = parseColumnGroups(config.combinations, table.headers);
+
+            profiler.begin();
+            auto startCombinations = high_resolution_clock::now();
+            auto combinations = processor.processCombinations(
+                    columns, table.cellHashes, groups,
+                    combinationModeFromString(config.combinationMode), strategy);
+            combinationDuration = duration_cast<milliseconds>(high_resolution_clock::now() - startCombinations);
+            profiler.end("combinations", rowCount);
+
+            ResultAggregator aggregator;
+            aggregator.printCombinations(combinations);
+            aggregator.saveCombinationsToFile(combinations,
+                                              stripExtension(config.inputFile) + "_combinations.csv");
         }
 
         cout << "\n=== Performance ===" << endl;
         cout << "Reading time:  " << readDuration.count() << " ms" << endl;
         cout << "Analysis time: " << analysisDuration.count() << " ms" << endl;
-        cout << "Total time:    " << (readDuration + analysisDuration).count() << " ms" << endl;
+        if (!config.combinations.empty()) {
+            cout << "Combinations:  " << combinationDuration.count() << " ms" << endl;
+        }
+        cout << "Total time:    " << (readDuration + analysisDuration + combinationDuration).count() << " ms" << endl;
+        profiler.print();
 
+    } catch (const OperationCancelled&) {
+        throw;
     } catch (const exception& e) {
         cerr << "Error: " << e.what() << endl;
         throw;
     }
 }
 
+/**
+ * Strategy 4: read, parse, analyze and write overlap over chunks of the file
+ */
+void pipelineMode(const Config& config) {
+    cout << "=== Analyze Mode (pipeline) ===" << endl;
+    cout << "Input file: " << config.inputFile << endl;
+    cout << "Workers: " << config.numThreads << endl;
+    cout << "Backend: " << config.backend << "\n" << endl;
+
+    PipelineOptions pipeline;
+    pipeline.computeHashes = config.hashOnce;
+    pipeline.io.backend = config.ioMode == "uring" ? IoBackend::IO_URING
+                          : config.ioMode == "pread" ? IoBackend::PREAD : IoBackend::AUTO;
+    pipeline.io.direct = config.directIo;
+    // Write stage: the text format is appended column by column; the binary
+    // format needs every column's size up front and the fingerprint backend
+    // keeps no values, so those are written after the pipeline as usual
+    const string outputBaseName = stripExtension(config.inputFile);
+    if (config.format != "binary" && backendFromString(config.backend) != DistinctBackend::FINGERPRINT) {
+        pipeline.fullResultsFile = outputBaseName + "_full.csv";
+        pipeline.sortedValues = config.sortedOutput;
+    }
+    PipelineExecutor executor(config.numThreads, analyzerOptionsFromConfig(config), pipeline);
+
+    // Stages overlap, so progress follows the bytes read
+    auto progress = makeProgressReporter(config);
+    if (progress) {
+        error_code ec;
+        uintmax_t fileSize = std::filesystem::file_size(config.inputFile, ec);
+        progress->beginPhase("pipeline", 0, ec ? 0 : fileSize);
+    }
+
+    PhaseProfiler profiler(config.perfCounters);
+    profiler.begin();
+    auto start = high_resolution_clock::now();
+    auto results = executor.run(config.inputFile);
+    auto duration = duration_cast<milliseconds>(high_resolution_clock::now() - start);
+    const size_t rowCount = executor.stats().rows;
+    profiler.end("pipeline", rowCount);
+    if (progress) progress->endPhase();
+
+    vector<size_t> incomplete;
+    for (const auto& result : results) {
+        if (!result.complete) {
+            incomplete.push_back(result.columnIndex);
+        }
+    }
+    if (!incomplete.empty()) {
+        results = completedOnly(results, incomplete);
+    }
+
+    profiler.begin();
+    writeResults(config, results, outputBaseName, executor.stats().fullResultsWritten);
+    profiler.end("write", rowCount);
+
+    const auto& stats = executor.stats();
+    cout << "\n=== Performance ===" << endl;
+    cout << "Read + parse + analysis + write time: " << duration.count() << " ms" << endl;
+    cout << "Chunks:        " << stats.chunks << " (" << stats.rows << " rows)" << endl;
+    cout << "Reader blocked: " << static_cast<long long>(stats.readerBlockedSeconds * 1000.0)
+         << " ms, workers idle: " << static_cast<long long>(stats.workerIdleSeconds * 1000.0)
+         << " ms (summed)" << endl;
+    profiler.print();
+}
+
+void sampleMode(const Config& config) {
+    cout << "=== Sample Mode ===" << endl;
+    cout << "Input file: " << config.inputFile << endl;
+
+    ParallelStrategy strategy = strategyFromInt(config.strategyMode);
+    cout << "Strategy: " << strategyToString(strategy) << "\n" << endl;
+
+    SampleOptions sampleOptions;
+    sampleOptions.blocks = config.sampleBlocks;
+
+    auto start = high_resolution_clock::now();
+
+    SampleInfo info;
+    CSVTable table = CSVReader::readSample(config.inputFile, sampleOptions, &info);
+    const auto& columns = table.columns;
+
+    cout << "Sampled " << info.sampledRows << " rows (" << info.sampledBytes / 1024
+         << " KB of " << info.fileBytes / 1024 << " KB), estimated rows in file: "
+         << info.estimatedRows << "\n" << endl;
+
+    ParallelProcessor processor(config.numThreads, analyzerOptionsFromConfig(config));
+    auto results = processor.process(columns, strategy);
+
+    // Extrapolate each column from its sample
+    {
+        ThreadPool pool(config.numThreads);
+        vector<future<DistinctEstimate>> estimates;
+        for (const auto& column : columns) {
+            estimates.push_back(pool.submit([&column, &info]() {
+                return SampleEstimator::estimate(column, info);
+            }));
+        }
+        for (size_t c = 0; c < results.size(); ++c) {
+            results[c].estimate = estimates[c].get();
+            results[c].uniqueCount = static_cast<size_t>(llround(results[c].estimate.estimate));
+        }
+    }
+
+    auto end = high_resolution_clock::now();
+
+    const string base = stripExtension(config.inputFile) + "_sample";
+    writeResults(config, results, base);
+
+    ResultAggregator aggregator;
+    aggregator.printEstimates(results);
+    aggregator.saveEstimatesToFile(results, base + "_estimates.csv");
+
+    cout << "\n=== Performance ===" << endl;
+    cout << "Sample + analysis time: " << duration_cast<milliseconds>(end - start).count() << " ms" << endl;
+}
+
+void serveMode(const Config& config) {
+    cout << "=== Serve Mode ===" << endl;
+
+    ServerOptions options;
+    options.socketPath = config.socketPath;
+    options.numThreads = config.numThreads;
+    options.cacheCapacity = config.cacheCapacity;
+    options.analyzerOptions = analyzerOptionsFromConfig(config);
+    options.analyzerOptions.sortThreads = 1;  // Columns already run in parallel on the pool
+
+    AnalyzerServer server(options);
+    server.run();
+}
+
 int main(int argc, char* argv[]) {
     std::cout << "=== Testing C++17 Execution Policy Support ===" << std::endl;
     std::cout << "C++ Standard: " << __cplusplus << std::endl;
@@ -238,8 +754,20 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
+    // Analysis stops cooperatively on Ctrl-C or at the deadline
+    CancellationToken& cancellation = CancellationToken::interrupt();
+    CancellationToken::Scope cancellationScope(&cancellation);
+
     try {
         Config config = parseArgs(argc, argv);
+        HugePageResource::instance().setMode(hugePageModeFromString(config.hugePages));
+
+        if (config.mode == "analyze") {
+            CancellationToken::installInterruptHandler();
+            if (config.deadlineMs > 0) {
+                cancellation.setTimeout(milliseconds(config.deadlineMs));
+            }
+        }
 
         if (config.mode == "generate") {
             generateMode(config);
@@ -249,18 +777,39 @@ int main(int argc, char* argv[]) {
                 cerr << "Error: --input <file> is required for --analyze mode" << endl;
                 return 1;
             }
-            analyzeMode(config);
+            const bool pipelined = strategyFromInt(config.strategyMode) == ParallelStrategy::PIPELINE;
+            if (!config.combinations.empty() &&
+                (InputResolver::isMultiInput(config.inputFile) || config.sampleBlocks > 0 || pipelined)) {
+                cerr << "Warning: --combinations needs a single, fully read input; ignored" << endl;
+            }
+            if (InputResolver::isMultiInput(config.inputFile)) {
+                analyzeFilesMode(config, InputResolver::resolve(config.inputFile));
+            } else if (config.sampleBlocks > 0) {
+                sampleMode(config);
+            } else if (pipelined) {
+                pipelineMode(config);
+            } else {
+                analyzeMode(config);
+            }
+        }
+        else if (config.mode == "serve") {
+            serveMode(config);
         }
         else {
-            cerr << "Error: specify --generate or --analyze" << endl;
+            cerr << "Error: specify --generate, --analyze or --serve" << endl;
             printHelp();
             return 1;
         }
 
+    } catch (const OperationCancelled&) {
+        cerr << "Cancelled before any column finished" << endl;
     } catch (const exception& e) {
         cerr << "Error: " << e.what() << endl;
         return 1;
     }
 
+    if (cancellation.isCancelled()) {
+        return cancellation.deadlineExpired() ? 124 : 130;
+    }
     return 0;
 }
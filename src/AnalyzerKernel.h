@@ -0,0 +1,378 @@
+#ifndef COLUMNANALYZER_ANALYZERKERNEL_H
+#define COLUMNANALYZER_ANALYZERKERNEL_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "CancellationToken.h"
+#include "CellHash.h"
+#include "ColumnAnalyzer.h"
+#include "DistinctIndex.h"
+#include "FingerprintSet.h"
+#include "ProgressReporter.h"
+#include "SortDistinct.h"
+#include "ValueBitmap.h"
+#include "WorkerArena.h"
+
+/**
+ * Compile-time specialized distinct counting kernels
+ *
+ * A kernel is fixed by four policies: value type, hash, set and statistics.
+ * ColumnAnalyzer resolves the runtime configuration to one instantiation per
+ * column; inside the row loop there are no virtual calls and no branches on
+ * options, so every policy call is inlined. Set scratch memory comes from
+ * the worker's WorkerArena.
+ */
+namespace AnalyzerKernel {
+
+    /**
+     * How a value type is hashed and turned into a result string
+     */
+    template <typename Value, typename = void>
+    struct ValueTraits;
+
+    template <>
+    struct ValueTraits<std::string> {
+        static uint64_t hash(const std::string& value) { return CellHash::hash(value); }
+        static const std::string& toString(const std::string& value) { return value; }
+    };
+
+    template <>
+    struct ValueTraits<std::string_view> {
+        static uint64_t hash(std::string_view value) { return CellHash::hashBytes(value.data(), value.size()); }
+        static std::string toString(std::string_view value) { return std::string(value); }
+    };
+
+    template <typename Value>
+    struct ValueTraits<Value, std::enable_if_t<std::is_integral_v<Value>>> {
+        static uint64_t hash(Value value) {
+            return CellHash::hashBytes(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+        static std::string toString(Value value) { return std::to_string(value); }
+    };
+
+    // ---- Hash policies ----
+
+    /**
+     * Hash each value while scanning
+     */
+    struct HashValues {
+        template <typename Value>
+        uint64_t operator()(const Value& value, size_t) const {
+            return ValueTraits<Value>::hash(value);
+        }
+    };
+
+    /**
+     * Reuse hashes computed by the reader
+     */
+    struct ReuseCellHashes {
+        const uint64_t* hashes;
+
+        template <typename Value>
+        uint64_t operator()(const Value&, size_t row) const {
+            return hashes[row];
+        }
+    };
+
+    // ---- Set policies ----
+
+    /**
+     * Split a row range into chunks and publish progress after each one,
+     * keeping the progress counter out of the inner loop
+     * Throws OperationCancelled before a chunk if the thread's token is cancelled
+     * @param count Number of rows
+     * @param body Callable(begin, end) scanning rows [begin, end)
+     */
+    template <typename Body>
+    void forEachChunk(size_t count, Body&& body) {
+        auto& progress = ProgressReporter::counters();
+        for (size_t begin = 0; begin < count; begin += ProgressReporter::kChunkRows) {
+            CancellationToken::throwIfCancelled();
+            const size_t end = std::min(count, begin + ProgressReporter::kChunkRows);
+            body(begin, end);
+            progress.addRows(end - begin);
+        }
+    }
+
+    /**
+     * Materialize distinct values from their first-occurrence rows
+     */
+    template <typename Value>
+    void fillFromIndex(ColumnResult& result, const DistinctIndex& index,
+                       const std::vector<Value>& columnData) {
+        result.uniqueValues.reserve(index.size());
+        size_t copied = 0;
+        for (size_t row : index.rows()) {
+            if ((copied++ & (ProgressReporter::kChunkRows - 1)) == 0) {
+                CancellationToken::throwIfCancelled();
+            }
+            result.uniqueValues.insert(ValueTraits<Value>::toString(columnData[row]));
+        }
+        result.uniqueCount = index.size();
+    }
+
+    /**
+     * Open-addressing index, one value at a time
+     */
+    struct IndexSet {
+        template <typename Value, typename Hash, typename Stats>
+        void build(const std::vector<Value>& columnData, const Hash& hash,
+                   Stats& stats, ColumnResult& result) const {
+            DistinctIndex index(0, &WorkerArena::local());
+
+            // Probe by hash, compare values only on hash match
+            forEachChunk(columnData.size(), [&](size_t begin, size_t end) {
+                for (size_t row = begin; row < end; ++row) {
+                    const Value& value = columnData[row];
+                    index.insert(hash(value, row), row, [&](size_t other) {
+                        return columnData[other] == value;
+                    });
+                    stats.update(value);
+                }
+            });
+
+            fillFromIndex(result, index, columnData);
+        }
+    };
+
+    /**
+     * Open-addressing index, blocks of values with bucket prefetching
+     */
+    struct BatchedIndexSet {
+        size_t batchSize;
+
+        template <typename Value, typename Hash, typename Stats>
+        void build(const std::vector<Value>& columnData, const Hash& hash,
+                   Stats& stats, ColumnResult& result) const {
+            const size_t block = std::clamp<size_t>(batchSize, 1, ColumnAnalyzer::kMaxBatchSize);
+
+            DistinctIndex index(0, &WorkerArena::local());
+            uint64_t blockHashes[ColumnAnalyzer::kMaxBatchSize];
+
+            auto equalsRows = [&](size_t a, size_t b) {
+                return columnData[a] == columnData[b];
+            };
+
+            forEachChunk(columnData.size(), [&](size_t begin, size_t end) {
+                for (size_t start = begin; start < end; start += block) {
+                    const size_t count = std::min(block, end - start);
+
+                    for (size_t i = 0; i < count; ++i) {
+                        blockHashes[i] = hash(columnData[start + i], start + i);
+                    }
+                    index.insertBatch(blockHashes, start, count, equalsRows);
+
+                    for (size_t i = 0; i < count; ++i) {
+                        stats.update(columnData[start + i]);
+                    }
+                }
+            });
+
+            fillFromIndex(result, index, columnData);
+        }
+    };
+
+    /**
+     * Parallel sort of string views, then adjacent-unique count
+     * The hash policy is not used
+     */
+    struct SortedSet {
+        size_t numThreads;
+
+        template <typename Value, typename Hash, typename Stats>
+        void build(const std::vector<Value>& columnData, const Hash&,
+                   Stats& stats, ColumnResult& result) const {
+            static_assert(std::is_convertible_v<const Value&, std::string_view>,
+                          "SortedSet needs string-like values");
+
+            std::pmr::vector<std::string_view> keys(&WorkerArena::local());
+            keys.reserve(columnData.size());
+            forEachChunk(columnData.size(), [&](size_t begin, size_t end) {
+                for (size_t row = begin; row < end; ++row) {
+                    keys.emplace_back(columnData[row]);
+                    stats.update(columnData[row]);
+                }
+            });
+
+            CancellationToken::throwIfCancelled();
+            SortDistinct::parallelSort(keys, std::max<size_t>(numThreads, 1));
+            result.uniqueCount = SortDistinct::uniqueSorted(keys);
+
+            result.uniqueValues.reserve(keys.size());
+            for (size_t i = 0; i < keys.size(); ++i) {
+                if ((i & (ProgressReporter::kChunkRows - 1)) == 0) {
+                    CancellationToken::throwIfCancelled();
+                }
+                result.uniqueValues.emplace(keys[i]);
+            }
+        }
+    };
+
+    /**
+     * Keys of a small-domain column in a bit vector (keys < 2^16, one
+     * 8 KB array that stays in L1/L2) plus a roaring bitmap for larger keys
+     * From the first cell that does not fit the encoding, the rows seen so
+     * far are moved into an open-addressing index and hashing continues
+     */
+    struct BitmapSet {
+        BitmapEncoding encoding;
+
+        static constexpr size_t kDirectKeys = 1 << 16;
+
+        template <typename Value, typename Hash, typename Stats>
+        void build(const std::vector<Value>& columnData, const Hash& hash,
+                   Stats& stats, ColumnResult& result) const {
+            static_assert(std::is_convertible_v<const Value&, std::string_view>,
+                          "BitmapSet needs string-like values");
+
+            std::array<uint64_t, kDirectKeys / 64> direct{};
+            RoaringBitmap large;
+            bool bitmapMode = true;
+
+            DistinctIndex index(0, &WorkerArena::local());
+            auto insertRow = [&](size_t row) {
+                const Value& value = columnData[row];
+                index.insert(hash(value, row), row, [&](size_t other) {
+                    return columnData[other] == value;
+                });
+            };
+
+            forEachChunk(columnData.size(), [&](size_t begin, size_t end) {
+                size_t row = begin;
+                if (bitmapMode) {
+                    for (; row < end; ++row) {
+                        uint32_t key;
+                        if (!ValueBitmap::encode(encoding, columnData[row], key)) {
+                            break;
+                        }
+                        if (key < kDirectKeys) {
+                            direct[key >> 6] |= uint64_t{1} << (key & 63);
+                        } else {
+                            large.add(key);
+                        }
+                        stats.update(columnData[row]);
+                    }
+                    if (row < end) {
+                        bitmapMode = false;
+                        for (size_t seen = 0; seen < row; ++seen) {
+                            insertRow(seen);
+                        }
+                    }
+                }
+                for (; row < end; ++row) {
+                    insertRow(row);
+                    stats.update(columnData[row]);
+                }
+            });
+
+            if (!bitmapMode) {
+                fillFromIndex(result, index, columnData);
+                return;
+            }
+
+            result.bitmap.encoding = encoding;
+            result.bitmap.keys = RoaringBitmap::fromBits(direct.data(), direct.size());
+            result.bitmap.keys.merge(large);
+            result.uniqueCount = result.bitmap.keys.cardinality();
+
+            result.uniqueValues.reserve(result.uniqueCount);
+            result.bitmap.keys.forEach([&](uint32_t key) {
+                result.uniqueValues.insert(ValueBitmap::decode(encoding, key));
+            });
+        }
+    };
+
+    /**
+     * Flat set of value fingerprints; no value is copied into the result
+     * With verify, a second pass counts exactly by comparing the original
+     * bytes on hash matches (scratch only, from the worker arena); the
+     * difference to the fingerprint count is the number of values that
+     * share a fingerprint with another value
+     */
+    struct FingerprintedSet {
+        unsigned bits;
+        bool verify;
+
+        template <typename Value, typename Hash, typename Stats>
+        void build(const std::vector<Value>& columnData, const Hash& hash,
+                   Stats& stats, ColumnResult& result) const {
+            static_assert(std::is_convertible_v<const Value&, std::string_view>,
+                          "FingerprintedSet needs string-like values");
+
+            FingerprintSet set(bits);
+            forEachChunk(columnData.size(), [&](size_t begin, size_t end) {
+                for (size_t row = begin; row < end; ++row) {
+                    const Value& value = columnData[row];
+                    set.insert(hash(value, row), bits == 128 ? FingerprintSet::highHash(value) : 0);
+                    stats.update(value);
+                }
+            });
+            result.uniqueCount = set.size();
+
+            if (verify) {
+                DistinctIndex index(set.size(), &WorkerArena::local());
+                for (size_t row = 0; row < columnData.size(); ++row) {
+                    if ((row & (ProgressReporter::kChunkRows - 1)) == 0) {
+                        CancellationToken::throwIfCancelled();
+                    }
+                    const Value& value = columnData[row];
+                    index.insert(hash(value, row), row, [&](size_t other) {
+                        return columnData[other] == value;
+                    });
+                }
+                result.fingerprintCollisions = index.size() - set.size();
+                result.fingerprintsVerified = true;
+                result.uniqueCount = index.size();
+            }
+            result.fingerprints = std::move(set);
+        }
+    };
+
+    /**
+     * Run one specialized kernel over a column
+     * @tparam Stats StaticStatistics<Flags>
+     * @param columnIndex Column index
+     * @param columnData Column values
+     * @param hash Hash policy
+     * @param set Set policy
+     * @return Analysis result
+     */
+    template <typename Stats, typename Value, typename Hash, typename Set>
+    ColumnResult run(size_t columnIndex, const std::vector<Value>& columnData,
+                     const Hash& hash, const Set& set) {
+        ColumnResult result(columnIndex);
+        Stats stats;
+
+        set.build(columnData, hash, stats, result);
+
+        if constexpr (Stats::kFlags != STAT_NONE) {
+            result.statistics = stats.finish();
+        }
+        return result;
+    }
+
+    /**
+     * Call f with a StaticStatistics instance matching runtime flags
+     * @param flags Combination of StatisticFlags
+     * @param f Generic callable taking the statistics type tag
+     */
+    template <unsigned Flags = STAT_NONE, typename F>
+    decltype(auto) withStatistics(unsigned flags, F&& f) {
+        if constexpr (Flags == STAT_ALL) {
+            return f(StaticStatistics<Flags>{});
+        } else {
+            if ((flags & STAT_ALL) == Flags) {
+                return f(StaticStatistics<Flags>{});
+            }
+            return withStatistics<Flags + 1>(flags, std::forward<F>(f));
+        }
+    }
+
+} // namespace AnalyzerKernel
+
+#endif //COLUMNANALYZER_ANALYZERKERNEL_H
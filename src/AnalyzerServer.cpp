@@ -0,0 +1,352 @@
+#include "AnalyzerServer.h"
+#include <iostream>
+#include <sstream>
+#include <map>
+#include <future>
+#include <stdexcept>
+#include <cstring>
+#include <cerrno>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <poll.h>
+#include <unistd.h>
+
+using namespace std;
+
+namespace {
+
+    string jsonEscape(const string& value) {
+        string out;
+        out.reserve(value.size() + 2);
+        for (char c : value) {
+            switch (c) {
+                case '"':  out += "\\\""; break;
+                case '\\': out += "\\\\"; break;
+                case '\n': out += "\\n"; break;
+                case '\r': out += "\\r"; break;
+                case '\t': out += "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        char buf[8];
+                        snprintf(buf, sizeof(buf), "\\u%04x", c);
+                        out += buf;
+                    } else {
+                        out += c;
+                    }
+            }
+        }
+        return out;
+    }
+
+    string errorJson(const string& message) {
+        return R"({"status":"error","message":")" + jsonEscape(message) + "\"}";
+    }
+
+} // namespace
+
+AnalyzerServer::Connection::~Connection() {
+    close(fd);
+}
+
+void AnalyzerServer::Connection::send(const string& line) {
+    lock_guard<mutex> lock(writeMutex);
+    string data = line + "\n";
+    size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t n = ::send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (n <= 0) {
+            if (n < 0 && errno == EINTR) continue;
+            return;  // Client went away
+        }
+        sent += static_cast<size_t>(n);
+    }
+}
+
+AnalyzerServer::AnalyzerServer(ServerOptions options)
+    : options_(std::move(options)),
+      pool_(options_.numThreads),
+      cache_(options_.cacheCapacity) {}
+
+AnalyzerServer::~AnalyzerServer() {
+    stop();
+}
+
+void AnalyzerServer::stop() {
+    stopping_ = true;
+    queueCv_.notify_all();
+}
+
+bool AnalyzerServer::waitUntilListening(chrono::milliseconds timeout) {
+    unique_lock<mutex> lock(listeningMutex_);
+    return listeningCv_.wait_for(lock, timeout, [this]() { return listening_; });
+}
+
+void AnalyzerServer::run() {
+    listenFd_ = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd_ < 0) {
+        throw runtime_error(string("Failed to create socket: ") + strerror(errno));
+    }
+
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (options_.socketPath.size() >= sizeof(addr.sun_path)) {
+        close(listenFd_);
+        throw invalid_argument("Socket path too long: " + options_.socketPath);
+    }
+    strncpy(addr.sun_path, options_.socketPath.c_str(), sizeof(addr.sun_path) - 1);
+    unlink(options_.socketPath.c_str());
+
+    if (bind(listenFd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+        listen(listenFd_, 64) < 0) {
+        string error = strerror(errno);
+        close(listenFd_);
+        throw runtime_error("Failed to listen on " + options_.socketPath + ": " + error);
+    }
+
+    cout << "Listening on " << options_.socketPath
+         << " (" << pool_.size() << " warm threads, cache of "
+         << options_.cacheCapacity << " tables)" << endl;
+
+    {
+        lock_guard<mutex> lock(listeningMutex_);
+        listening_ = true;
+    }
+    listeningCv_.notify_all();
+
+    thread dispatcher([this]() { dispatchLoop(); });
+
+    acceptLoop();
+
+    // Shutdown: unblock the remaining readers, drain the queue, release the socket
+    map<size_t, Client> clients;
+    {
+        lock_guard<mutex> lock(clientsMutex_);
+        clients.swap(clients_);
+        finishedClients_.clear();
+    }
+    for (auto& [id, client] : clients) {
+        shutdown(client.connection->fd, SHUT_RDWR);
+    }
+    for (auto& [id, client] : clients) {
+        client.reader.join();
+    }
+    queueCv_.notify_all();
+    dispatcher.join();
+    clients.clear();
+
+    close(listenFd_);
+    unlink(options_.socketPath.c_str());
+    cout << "Server stopped" << endl;
+}
+
+void AnalyzerServer::acceptLoop() {
+    while (!stopping_) {
+        pollfd pfd{listenFd_, POLLIN, 0};
+        int ready = poll(&pfd, 1, 100);  // Wake up regularly to check stopping_
+        reapClients();
+        if (ready <= 0) {
+            continue;
+        }
+
+        int fd = accept(listenFd_, nullptr, nullptr);
+        if (fd < 0) {
+            continue;
+        }
+
+        auto connection = make_shared<Connection>(fd);
+        lock_guard<mutex> lock(clientsMutex_);
+        const size_t id = nextClientId_++;
+        Client& client = clients_[id];
+        client.connection = connection;
+        client.reader = thread([this, id, connection]() { readLoop(id, connection); });
+    }
+}
+
+void AnalyzerServer::reapClients() {
+    vector<Client> finished;
+    {
+        lock_guard<mutex> lock(clientsMutex_);
+        for (size_t id : finishedClients_) {
+            auto it = clients_.find(id);
+            if (it != clients_.end()) {
+                finished.push_back(std::move(it->second));
+                clients_.erase(it);
+            }
+        }
+        finishedClients_.clear();
+    }
+    // Joined outside the lock; the fd closes once queued requests are answered
+    for (auto& client : finished) {
+        client.reader.join();
+    }
+}
+
+void AnalyzerServer::readLoop(size_t clientId, shared_ptr<Connection> connection) {
+    string buffer;
+    char chunk[4096];
+
+    while (true) {
+        ssize_t n = recv(connection->fd, chunk, sizeof(chunk), 0);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        buffer.append(chunk, static_cast<size_t>(n));
+
+        size_t newline;
+        while ((newline = buffer.find('\n')) != string::npos) {
+            string line = buffer.substr(0, newline);
+            buffer.erase(0, newline + 1);
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            if (line.empty()) {
+                continue;
+            }
+
+            ++requestCount_;
+
+            size_t space = line.find(' ');
+            string command = line.substr(0, space);
+            string argument = space == string::npos ? "" : line.substr(space + 1);
+
+            if (command == "ANALYZE" && !argument.empty()) {
+                {
+                    lock_guard<mutex> lock(queueMutex_);
+                    queue_.push_back(Request{connection, argument});
+                }
+                queueCv_.notify_one();
+            } else if (command == "PING") {
+                connection->send(R"({"status":"ok"})");
+            } else if (command == "STATS") {
+                connection->send(statsJson());
+            } else if (command == "SHUTDOWN") {
+                connection->send(R"({"status":"ok"})");
+                stop();
+            } else {
+                connection->send(errorJson("Unknown command: " + line));
+            }
+        }
+    }
+
+    lock_guard<mutex> lock(clientsMutex_);
+    finishedClients_.push_back(clientId);
+}
+
+void AnalyzerServer::dispatchLoop() {
+    while (true) {
+        {
+            unique_lock<mutex> lock(queueMutex_);
+            queueCv_.wait(lock, [this]() { return stopping_ || !queue_.empty(); });
+            if (queue_.empty()) {
+                return;  // Stopping and drained
+            }
+        }
+
+        // Let requests arriving at the same moment join this batch
+        this_thread::sleep_for(options_.batchWindow);
+
+        vector<Request> batch;
+        {
+            lock_guard<mutex> lock(queueMutex_);
+            batch.assign(make_move_iterator(queue_.begin()), make_move_iterator(queue_.end()));
+            queue_.clear();
+        }
+
+        ++batchCount_;
+        processBatch(std::move(batch));
+    }
+}
+
+void AnalyzerServer::processBatch(vector<Request> batch) {
+    // Identical paths within a batch are loaded and analyzed once
+    map<string, vector<shared_ptr<Connection>>> waiters;
+    for (auto& request : batch) {
+        waiters[request.path].push_back(request.connection);
+    }
+
+    struct TableJob {
+        string path;
+        bool cached = false;
+        shared_ptr<const CSVTable> table;
+        string error;
+        vector<future<ColumnResult>> columns;
+    };
+
+    vector<TableJob> jobs;
+    vector<future<shared_ptr<const CSVTable>>> loads;
+    for (const auto& [path, connections] : waiters) {
+        jobs.push_back(TableJob{path});
+    }
+    for (auto& job : jobs) {
+        loads.push_back(pool_.submit([this, &job]() { return cache_.get(job.path, &job.cached); }));
+    }
+
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        try {
+            jobs[i].table = loads[i].get();
+        } catch (const exception& e) {
+            jobs[i].error = e.what();
+        }
+    }
+
+    // All columns of all tables in the batch share the pool
+    const AnalyzerOptions& analyzerOptions = options_.analyzerOptions;
+    for (auto& job : jobs) {
+        if (!job.table) continue;
+        const auto& columns = job.table->columns;
+        for (size_t c = 0; c < columns.size(); ++c) {
+            job.columns.push_back(pool_.submit([&columns, c, &analyzerOptions]() {
+                return ColumnAnalyzer::analyze(c, columns[c], analyzerOptions);
+            }));
+        }
+    }
+
+    for (auto& job : jobs) {
+        // Every column is waited for even after one failed: the tasks
+        // read the table, which the job keeps alive
+        vector<ColumnResult> results;
+        for (auto& column : job.columns) {
+            try {
+                results.push_back(column.get());
+            } catch (const exception& e) {
+                if (job.error.empty()) {
+                    job.error = e.what();
+                }
+            }
+        }
+
+        string response;
+        if (!job.error.empty()) {
+            response = errorJson(job.error);
+        } else {
+            ostringstream json;
+            const auto& table = *job.table;
+            json << R"({"status":"ok","file":")" << jsonEscape(job.path) << "\""
+                 << ",\"cached\":" << (job.cached ? "true" : "false")
+                 << ",\"rows\":" << (table.columns.empty() ? 0 : table.columns[0].size())
+                 << ",\"columns\":[";
+            for (size_t c = 0; c < results.size(); ++c) {
+                if (c > 0) json << ",";
+                json << "{\"index\":" << c
+                     << ",\"name\":\"" << jsonEscape(c < table.headers.size() ? table.headers[c] : "") << "\""
+                     << ",\"unique\":" << results[c].uniqueCount << "}";
+            }
+            json << "]}";
+            response = json.str();
+        }
+
+        for (auto& connection : waiters[job.path]) {
+            connection->send(response);
+        }
+    }
+}
+
+string AnalyzerServer::statsJson() const {
+    ostringstream json;
+    json << R"({"status":"ok","requests":)" << requestCount_.load()
+         << ",\"batches\":" << batchCount_.load()
+         << ",\"threads\":" << pool_.size()
+         << ",\"cached_tables\":" << cache_.size()
+         << ",\"cache_hits\":" << cache_.hits()
+         << ",\"cache_misses\":" << cache_.misses() << "}";
+    return json.str();
+}
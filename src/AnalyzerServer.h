@@ -0,0 +1,137 @@
+#ifndef COLUMNANALYZER_ANALYZERSERVER_H
+#define COLUMNANALYZER_ANALYZERSERVER_H
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <condition_variable>
+#include "ColumnAnalyzer.h"
+#include "TableCache.h"
+#include "ThreadPool.h"
+
+/**
+ * Resident server settings
+ */
+struct ServerOptions {
+    std::string socketPath = "/tmp/column-analyzer.sock";
+    size_t numThreads = 8;
+    size_t cacheCapacity = 16;
+    std::chrono::milliseconds batchWindow{2};  // Requests arriving within the window share a batch
+    AnalyzerOptions analyzerOptions;
+};
+
+/**
+ * Long-running analyzer listening on a Unix domain socket
+ *
+ * Line-based protocol, one JSON object per response line:
+ *   ANALYZE <path>   -> {"status":"ok","file":...,"rows":N,"columns":[{"index":0,"name":"col0","unique":N},...]}
+ *   PING             -> {"status":"ok"}
+ *   STATS            -> request/batch/cache counters
+ *   SHUTDOWN         -> stops the server
+ */
+class AnalyzerServer {
+public:
+    /**
+     * Constructor
+     * @param options Server settings
+     */
+    explicit AnalyzerServer(ServerOptions options);
+
+    ~AnalyzerServer();
+
+    AnalyzerServer(const AnalyzerServer&) = delete;
+    AnalyzerServer& operator=(const AnalyzerServer&) = delete;
+
+    /**
+     * Bind the socket and serve until SHUTDOWN or stop()
+     */
+    void run();
+
+    /**
+     * Request shutdown (safe from any thread)
+     */
+    void stop();
+
+    /**
+     * Block until the socket is accepting connections
+     * @param timeout Maximum wait
+     * @return true if the server is listening
+     */
+    bool waitUntilListening(std::chrono::milliseconds timeout);
+
+private:
+    /**
+     * Client socket; closed when the last reference (reader or queued
+     * request) goes away
+     */
+    struct Connection {
+        int fd;
+        std::mutex writeMutex;
+
+        explicit Connection(int socketFd) : fd(socketFd) {}
+        ~Connection();
+        Connection(const Connection&) = delete;
+        Connection& operator=(const Connection&) = delete;
+        void send(const std::string& line);
+    };
+
+    struct Client {
+        std::shared_ptr<Connection> connection;
+        std::thread reader;
+    };
+
+    struct Request {
+        std::shared_ptr<Connection> connection;
+        std::string path;
+    };
+
+    ServerOptions options_;
+    ThreadPool pool_;
+    TableCache cache_;
+
+    int listenFd_ = -1;
+    std::atomic<bool> stopping_{false};
+
+    std::mutex queueMutex_;
+    std::condition_variable queueCv_;
+    std::deque<Request> queue_;
+
+    // Live clients by id; readers report their id in finishedClients_
+    // when the peer disconnects and the accept loop joins them
+    std::mutex clientsMutex_;
+    std::map<size_t, Client> clients_;
+    std::vector<size_t> finishedClients_;
+    size_t nextClientId_ = 0;
+
+    std::mutex listeningMutex_;
+    std::condition_variable listeningCv_;
+    bool listening_ = false;
+
+    std::atomic<size_t> requestCount_{0};
+    std::atomic<size_t> batchCount_{0};
+
+    void acceptLoop();
+    void readLoop(size_t clientId, std::shared_ptr<Connection> connection);
+
+    /**
+     * Join the readers of disconnected clients and drop their connections
+     */
+    void reapClients();
+    void dispatchLoop();
+
+    /**
+     * Analyze one batch: each distinct table is loaded once and all of
+     * its columns run on the warm pool together with the other tables
+     */
+    void processBatch(std::vector<Request> batch);
+
+    [[nodiscard]] std::string statsJson() const;
+};
+
+#endif //COLUMNANALYZER_ANALYZERSERVER_H
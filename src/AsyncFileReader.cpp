@@ -0,0 +1,439 @@
+#include "AsyncFileReader.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#ifdef __linux__
+#  include <sys/mman.h>
+#  include <sys/syscall.h>
+#  include <linux/io_uring.h>
+#  if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#    define HAS_IO_URING
+#  endif
+#endif
+
+using namespace std;
+using namespace chrono;
+
+string ioBackendToString(IoBackend backend) {
+    switch (backend) {
+        case IoBackend::AUTO:
+            return "auto";
+        case IoBackend::IO_URING:
+            return "io_uring";
+        case IoBackend::PREAD:
+            return "pread";
+        default:
+            return "unknown";
+    }
+}
+
+namespace {
+
+    constexpr size_t kAlignment = 4096;
+
+    struct AlignedFree {
+        void operator()(char* p) const { free(p); }
+    };
+    using AlignedBuffer = unique_ptr<char, AlignedFree>;
+
+    AlignedBuffer allocateAligned(size_t size) {
+        void* p = nullptr;
+        if (posix_memalign(&p, kAlignment, size) != 0) {
+            throw bad_alloc();
+        }
+        return AlignedBuffer(static_cast<char*>(p));
+    }
+
+    size_t alignUp(size_t value) {
+        return (value + kAlignment - 1) / kAlignment * kAlignment;
+    }
+
+    /**
+     * Buffer position to continue from after a short read. O_DIRECT needs
+     * offset, buffer and length aligned, so the partial tail is read again
+     * from the last aligned byte.
+     * @param filled Bytes received into the buffer so far
+     * @param requested Buffer position the short read started at
+     * @throws std::runtime_error if the read made no aligned progress
+     */
+    size_t resumePosition(size_t filled, size_t requested, bool direct) {
+        if (!direct) {
+            return filled;
+        }
+        const size_t aligned = filled / kAlignment * kAlignment;
+        if (aligned <= requested) {
+            throw runtime_error("O_DIRECT read returned less than one aligned block");
+        }
+        return aligned;
+    }
+
+#ifdef HAS_IO_URING
+    /**
+     * Minimal io_uring wrapper over the raw syscalls (no liburing dependency)
+     */
+    class Ring {
+    public:
+        ~Ring() {
+            if (sqes_ != MAP_FAILED) munmap(sqes_, sqesSize_);
+            if (cqPtr_ != MAP_FAILED && cqPtr_ != sqPtr_) munmap(cqPtr_, cqRingSize_);
+            if (sqPtr_ != MAP_FAILED) munmap(sqPtr_, sqRingSize_);
+            if (fd_ >= 0) close(fd_);
+        }
+
+        bool init(unsigned entries) {
+            io_uring_params params{};
+            fd_ = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+            if (fd_ < 0) {
+                return false;
+            }
+
+            sqRingSize_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+            cqRingSize_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+            const bool singleMmap = params.features & IORING_FEAT_SINGLE_MMAP;
+            if (singleMmap) {
+                sqRingSize_ = cqRingSize_ = max(sqRingSize_, cqRingSize_);
+            }
+
+            sqPtr_ = mmap(nullptr, sqRingSize_, PROT_READ | PROT_WRITE,
+                          MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQ_RING);
+            if (sqPtr_ == MAP_FAILED) return false;
+
+            cqPtr_ = singleMmap ? sqPtr_
+                                : mmap(nullptr, cqRingSize_, PROT_READ | PROT_WRITE,
+                                       MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_CQ_RING);
+            if (cqPtr_ == MAP_FAILED) return false;
+
+            sqesSize_ = params.sq_entries * sizeof(io_uring_sqe);
+            sqes_ = mmap(nullptr, sqesSize_, PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQES);
+            if (sqes_ == MAP_FAILED) return false;
+
+            auto* sq = static_cast<char*>(sqPtr_);
+            sqTail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+            sqMask_ = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+            sqArray_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+
+            auto* cq = static_cast<char*>(cqPtr_);
+            cqHead_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+            cqTail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+            cqMask_ = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+            cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+            return true;
+        }
+
+        void queueRead(int fd, char* buffer, unsigned length, uint64_t offset, uint64_t userData) {
+            const unsigned tail = *sqTail_;
+            const unsigned index = tail & *sqMask_;
+
+            auto* sqe = static_cast<io_uring_sqe*>(sqes_) + index;
+            memset(sqe, 0, sizeof(*sqe));
+            sqe->opcode = IORING_OP_READ;
+            sqe->fd = fd;
+            sqe->addr = reinterpret_cast<uint64_t>(buffer);
+            sqe->len = length;
+            sqe->off = offset;
+            sqe->user_data = userData;
+
+            sqArray_[index] = index;
+            __atomic_store_n(sqTail_, tail + 1, __ATOMIC_RELEASE);
+            ++unsubmitted_;
+        }
+
+        /**
+         * Submit queued reads and wait for at least one completion
+         */
+        void submitAndWait() {
+            while (true) {
+                long rc = syscall(__NR_io_uring_enter, fd_, unsubmitted_, 1,
+                                  IORING_ENTER_GETEVENTS, nullptr, 0);
+                if (rc >= 0) {
+                    unsubmitted_ -= static_cast<unsigned>(rc);
+                    return;
+                }
+                if (errno != EINTR) {
+                    throw runtime_error(string("io_uring_enter failed: ") + strerror(errno));
+                }
+            }
+        }
+
+        bool popCompletion(io_uring_cqe& out) {
+            const unsigned head = *cqHead_;
+            if (head == __atomic_load_n(cqTail_, __ATOMIC_ACQUIRE)) {
+                return false;
+            }
+            out = cqes_[head & *cqMask_];
+            __atomic_store_n(cqHead_, head + 1, __ATOMIC_RELEASE);
+            return true;
+        }
+
+    private:
+        int fd_ = -1;
+        void* sqPtr_ = MAP_FAILED;
+        void* cqPtr_ = MAP_FAILED;
+        void* sqes_ = MAP_FAILED;
+        size_t sqRingSize_ = 0;
+        size_t cqRingSize_ = 0;
+        size_t sqesSize_ = 0;
+
+        unsigned* sqTail_ = nullptr;
+        unsigned* sqMask_ = nullptr;
+        unsigned* sqArray_ = nullptr;
+        unsigned* cqHead_ = nullptr;
+        unsigned* cqTail_ = nullptr;
+        unsigned* cqMask_ = nullptr;
+        io_uring_cqe* cqes_ = nullptr;
+        unsigned unsubmitted_ = 0;
+    };
+#endif
+
+} // namespace
+
+AsyncFileReader::AsyncFileReader(AsyncReadOptions options)
+    : options_(options) {
+    options_.blockSize = alignUp(max<size_t>(options_.blockSize, kAlignment));
+    options_.queueDepth = max<size_t>(options_.queueDepth, 1);
+}
+
+bool AsyncFileReader::ioUringAvailable() {
+#ifdef HAS_IO_URING
+    Ring ring;
+    return ring.init(2);
+#else
+    return false;
+#endif
+}
+
+FileHandle::~FileHandle() {
+    if (fd >= 0) {
+        close(fd);
+    }
+}
+
+ReadStats AsyncFileReader::read(const string& filename, const BlockHandler& onBlock) const {
+    FileHandle file;
+    bool direct = false;
+
+#ifdef O_DIRECT
+    if (options_.direct) {
+        file.fd = open(filename.c_str(), O_RDONLY | O_DIRECT);
+        direct = file.fd >= 0;  // Not supported on every filesystem (e.g. tmpfs)
+    }
+#endif
+    if (file.fd < 0) {
+        file.fd = open(filename.c_str(), O_RDONLY);
+    }
+    if (file.fd < 0) {
+        throw runtime_error("Failed to open file: " + filename);
+    }
+
+    struct stat st{};
+    if (fstat(file.fd, &st) != 0) {
+        throw runtime_error("Failed to stat file: " + filename);
+    }
+    const auto fileSize = static_cast<size_t>(st.st_size);
+
+    ReadStats stats;
+    if (options_.backend != IoBackend::PREAD) {
+        // Errors after the ring is set up (including ones thrown by onBlock)
+        // propagate: blocks may already have been handed over
+        stats = readWithIoUring(file.fd, fileSize, direct, onBlock);
+        if (stats.backend != IoBackend::IO_URING && options_.backend == IoBackend::IO_URING) {
+            throw runtime_error("io_uring unavailable: " + filename);
+        }
+    }
+    if (stats.backend != IoBackend::IO_URING) {
+        // AUTO with io_uring unavailable (old kernel, seccomp, ...)
+        stats = readWithPread(file.fd, fileSize, direct, onBlock);
+    }
+
+    stats.direct = direct;
+    return stats;
+}
+
+ReadStats AsyncFileReader::readWithIoUring(int fd, size_t fileSize, bool direct,
+                                           const BlockHandler& onBlock) const {
+#ifdef HAS_IO_URING
+    const size_t depth = options_.queueDepth;
+    const size_t blockSize = options_.blockSize;
+
+    Ring ring;
+    if (!ring.init(static_cast<unsigned>(depth))) {
+        return {};  // Nothing read; backend stays AUTO
+    }
+
+    ReadStats stats;
+    stats.backend = IoBackend::IO_URING;
+    auto start = steady_clock::now();
+
+    const size_t numBlocks = (fileSize + blockSize - 1) / blockSize;
+
+    // Block b lives in buffer b % depth; filled[slot] counts bytes received,
+    // requested[slot] is where the read in flight started
+    vector<AlignedBuffer> buffers;
+    vector<size_t> filled(depth, 0);
+    vector<size_t> requested(depth, 0);
+    vector<bool> done(depth, false);
+    for (size_t i = 0; i < depth; ++i) {
+        buffers.push_back(allocateAligned(blockSize));
+    }
+
+    auto blockLength = [&](size_t block) {
+        return min(blockSize, fileSize - block * blockSize);
+    };
+
+    size_t inFlight = 0;  // Reads queued and not yet completed
+
+    auto queueBlock = [&](size_t block) {
+        const size_t slot = block % depth;
+        filled[slot] = 0;
+        requested[slot] = 0;
+        done[slot] = false;
+        // Request the whole aligned buffer so O_DIRECT constraints hold at EOF
+        ring.queueRead(fd, buffers[slot].get(), static_cast<unsigned>(blockSize),
+                       block * blockSize, block);
+        ++inFlight;
+    };
+
+    // The kernel may still write into the buffers; wait before they are freed
+    auto drain = [&]() {
+        while (inFlight > 0) {
+            ring.submitAndWait();
+            io_uring_cqe cqe{};
+            while (ring.popCompletion(cqe)) {
+                --inFlight;
+            }
+        }
+    };
+
+    size_t nextToQueue = 0;
+    for (; nextToQueue < min(depth, numBlocks); ++nextToQueue) {
+        queueBlock(nextToQueue);
+    }
+
+    size_t nextToDeliver = 0;
+    while (nextToDeliver < numBlocks) {
+        const size_t slot = nextToDeliver % depth;
+
+        while (!done[slot]) {
+            ring.submitAndWait();
+
+            io_uring_cqe cqe{};
+            while (ring.popCompletion(cqe)) {
+                const size_t block = cqe.user_data;
+                const size_t s = block % depth;
+                --inFlight;
+                if (cqe.res < 0) {
+                    drain();
+                    throw runtime_error(string("io_uring read failed: ") + strerror(-cqe.res));
+                }
+
+                filled[s] += static_cast<size_t>(cqe.res);
+                if (filled[s] >= blockLength(block) || cqe.res == 0) {
+                    done[s] = true;
+                } else {
+                    // Short read: request the remainder into the same buffer
+                    try {
+                        filled[s] = resumePosition(filled[s], requested[s], direct);
+                    } catch (...) {
+                        drain();
+                        throw;
+                    }
+                    requested[s] = filled[s];
+                    ring.queueRead(fd, buffers[s].get() + filled[s],
+                                   static_cast<unsigned>(blockSize - filled[s]),
+                                   block * blockSize + filled[s], block);
+                    ++inFlight;
+                }
+            }
+        }
+
+        if (nextToDeliver == 0) {
+            stats.firstBlockSeconds = duration<double>(steady_clock::now() - start).count();
+        }
+
+        const size_t length = min(filled[slot], blockLength(nextToDeliver));
+        try {
+            onBlock(buffers[slot].get(), length);
+        } catch (...) {
+            // Handler failed or was cancelled
+            drain();
+            throw;
+        }
+        stats.bytes += length;
+        ++nextToDeliver;
+
+        // Reuse the delivered buffer for the next block
+        if (nextToQueue < numBlocks) {
+            queueBlock(nextToQueue++);
+        }
+    }
+
+    stats.seconds = duration<double>(steady_clock::now() - start).count();
+    return stats;
+#else
+    (void)fd;
+    (void)fileSize;
+    (void)direct;
+    (void)onBlock;
+    return {};  // Not supported on this platform; backend stays AUTO
+#endif
+}
+
+ReadStats AsyncFileReader::readWithPread(int fd, size_t fileSize, bool direct,
+                                         const BlockHandler& onBlock) const {
+    const size_t blockSize = options_.blockSize;
+
+    ReadStats stats;
+    stats.backend = IoBackend::PREAD;
+    auto start = steady_clock::now();
+
+#ifdef POSIX_FADV_SEQUENTIAL
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+
+    AlignedBuffer buffer = allocateAligned(blockSize);
+
+    for (size_t offset = 0; offset < fileSize; offset += blockSize) {
+#ifdef __linux__
+        // Ask the kernel to start fetching the blocks after this one
+        ::readahead(fd, static_cast<off_t>(offset + blockSize), blockSize * options_.queueDepth);
+#endif
+
+        const size_t length = min(blockSize, fileSize - offset);
+        size_t got = 0;
+        while (got < length) {
+            ssize_t n = pread(fd, buffer.get() + got, blockSize - got,
+                              static_cast<off_t>(offset + got));
+            if (n < 0 && errno == EINTR) continue;
+            if (n < 0) {
+                throw runtime_error(string("pread failed: ") + strerror(errno));
+            }
+            if (n == 0) break;
+            const size_t requested = got;
+            got += static_cast<size_t>(n);
+            if (got < length) {
+                got = resumePosition(got, requested, direct);
+            }
+        }
+
+        if (offset == 0) {
+            stats.firstBlockSeconds = duration<double>(steady_clock::now() - start).count();
+        }
+
+        got = min(got, length);
+        onBlock(buffer.get(), got);
+        stats.bytes += got;
+        if (got < length) break;  // File shrank while reading
+    }
+
+    stats.seconds = duration<double>(steady_clock::now() - start).count();
+    return stats;
+}
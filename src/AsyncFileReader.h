@@ -0,0 +1,99 @@
+#ifndef COLUMNANALYZER_ASYNCFILEREADER_H
+#define COLUMNANALYZER_ASYNCFILEREADER_H
+
+#include <string>
+#include <functional>
+
+/**
+ * Block I/O backend
+ */
+enum class IoBackend {
+    AUTO,      // io_uring if available, otherwise pread
+    IO_URING,  // Linux io_uring, several reads in flight (fails if unavailable)
+    PREAD      // pread with readahead hints
+};
+
+/**
+ * Convert I/O backend to string for output
+ */
+std::string ioBackendToString(IoBackend backend);
+
+/**
+ * Block reader settings
+ */
+struct AsyncReadOptions {
+    IoBackend backend = IoBackend::AUTO;
+    size_t blockSize = 4 << 20;  // Bytes per read (multiple of 4096)
+    size_t queueDepth = 4;       // Reads kept in flight
+    bool direct = false;         // O_DIRECT, bypassing the page cache
+};
+
+/**
+ * Measurements of one file read
+ */
+struct ReadStats {
+    IoBackend backend = IoBackend::AUTO;  // Backend actually used
+    bool direct = false;                  // O_DIRECT actually used
+    size_t bytes = 0;
+    double seconds = 0.0;
+    double firstBlockSeconds = 0.0;       // Time until the first block was handed over
+
+    [[nodiscard]] double megabytesPerSecond() const {
+        return seconds > 0.0 ? static_cast<double>(bytes) / (1024.0 * 1024.0) / seconds : 0.0;
+    }
+};
+
+/**
+ * Owns a file descriptor, closed when the handle goes out of scope
+ */
+struct FileHandle {
+    int fd = -1;
+
+    FileHandle() = default;
+    explicit FileHandle(int descriptor) : fd(descriptor) {}
+    ~FileHandle();
+
+    FileHandle(const FileHandle&) = delete;
+    FileHandle& operator=(const FileHandle&) = delete;
+};
+
+/**
+ * Reads a file in large aligned blocks and hands them over in file order
+ * While a block is being processed, the following reads are already in flight
+ */
+class AsyncFileReader {
+public:
+    /**
+     * Called for each block in file order; data is valid only during the call
+     */
+    using BlockHandler = std::function<void(const char* data, size_t size)>;
+
+    /**
+     * Constructor
+     * @param options Reader settings
+     */
+    explicit AsyncFileReader(AsyncReadOptions options = {});
+
+    /**
+     * Read the whole file
+     * @param filename Path to file
+     * @param onBlock Block consumer
+     * @return Read measurements
+     * @throws runtime_error If the file cannot be read, or IO_URING was
+     *         requested and io_uring cannot be set up
+     */
+    ReadStats read(const std::string& filename, const BlockHandler& onBlock) const;
+
+    /**
+     * Check whether io_uring can be set up in this process
+     */
+    static bool ioUringAvailable();
+
+private:
+    AsyncReadOptions options_;
+
+    ReadStats readWithIoUring(int fd, size_t fileSize, bool direct, const BlockHandler& onBlock) const;
+    ReadStats readWithPread(int fd, size_t fileSize, bool direct, const BlockHandler& onBlock) const;
+};
+
+#endif //COLUMNANALYZER_ASYNCFILEREADER_H
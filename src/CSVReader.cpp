@@ -1,77 +1,366 @@
 #include "CSVReader.h"
+#include "CancellationToken.h"
+#include "CellHash.h"
+#include "Console.h"
+#include "ProgressReporter.h"
 #include <fstream>
 #include <sstream>
-#include <iostream>
 #include <stdexcept>
+#include <cerrno>
+#include <cstring>
+#include <algorithm>
+#include <random>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
 
 using namespace std;
 
-vector<vector<string>> CSVReader::readColumns(const string& filename) {
-    cout << "Reading CSV file: " << filename << endl;
+/**
+ * Accumulates parsed lines into a column-oriented table
+ * Shared by the line-stream and block readers
+ */
+class CSVReader::TableBuilder {
+public:
+    explicit TableBuilder(bool computeHashes) : computeHashes_(computeHashes) {}
 
-    ifstream file(filename);
-    if (!file.is_open()) {
-        throw runtime_error("Failed to open file: " + filename);
+    /**
+     * Builder for rows without a header line
+     */
+    TableBuilder(bool computeHashes, size_t columnCount)
+        : computeHashes_(computeHashes), isFirstLine_(false) {
+        table_.columns.resize(columnCount);
+        if (computeHashes_) {
+            table_.cellHashes.resize(columnCount);
+        }
     }
 
-    vector<vector<string>> columns;
-    string line;
-    size_t rowCount = 0;
-    bool isFirstLine = true;
+    void addLine(string_view line) {
+        pendingBytes_ += line.size() + 1;
 
-    while (getline(file, line)) {
         if (line.empty()) {
-            continue; // Skip empty lines
+            return; // Skip empty lines
         }
 
         auto values = parseLine(line);
+        auto& columns = table_.columns;
 
-        if (isFirstLine) {
+        if (isFirstLine_) {
             // Header, init columns
             columns.resize(values.size());
-            cout << "Detected " << values.size() << " columns" << endl;
-            isFirstLine = false;
-            continue;  // Skip header
+            if (computeHashes_) {
+                table_.cellHashes.resize(values.size());
+            }
+            table_.headers = std::move(values);
+            Console::out() << "Detected " << columns.size() << " columns" << endl;
+            isFirstLine_ = false;
+            return;  // Skip header
         }
 
         // Validation: number of values must match number of columns
         if (values.size() != columns.size()) {
-            cerr << "Warning: Row " << rowCount
+            Console::err() << "Warning: Row " << rowCount_
                  << " has " << values.size() << " values, expected " << columns.size()
                  << ". Skipping." << endl;
-            continue;
+            return;
         }
 
         // Distribute values across columns
         for (size_t col = 0; col < values.size(); ++col) {
-            columns[col].push_back(values[col]);
+            if (computeHashes_) {
+                // Hash while the cell is still hot in cache
+                table_.cellHashes[col].push_back(CellHash::hash(values[col]));
+            }
+            columns[col].push_back(std::move(values[col]));
         }
 
-        rowCount++;
+        rowCount_++;
 
-        // Progress (every 1000 rows)
-        if (rowCount % 1000 == 0) {
-            cout << "Read " << rowCount << " rows..." << endl;
+        // Progress and cancellation: once per chunk, never print here
+        if (++pendingRows_ == kPublishRows) {
+            publishProgress();
+            CancellationToken::throwIfCancelled();
         }
     }
 
+    [[nodiscard]] size_t rows() const { return rowCount_; }
+
+    CSVTable finish() {
+        Console::out() << "CSV reading completed: " << rowCount_ << " rows, "
+             << table_.columns.size() << " columns" << endl;
+        return take();
+    }
+
+    /**
+     * The table so far, without the completion message
+     */
+    CSVTable take() {
+        publishProgress();
+        return std::move(table_);
+    }
+
+private:
+    static constexpr size_t kPublishRows = 1024;
+
+    bool computeHashes_;
+    bool isFirstLine_ = true;
+    size_t rowCount_ = 0;
+    size_t pendingRows_ = 0;
+    size_t pendingBytes_ = 0;
+    CSVTable table_;
+
+    void publishProgress() {
+        auto& progress = ProgressReporter::counters();
+        progress.addRows(pendingRows_);
+        progress.addBytes(pendingBytes_);
+        pendingRows_ = 0;
+        pendingBytes_ = 0;
+    }
+};
+
+vector<vector<string>> CSVReader::readColumns(const string& filename) {
+    return readTable(filename).columns;
+}
+
+CSVTable CSVReader::readTable(const string& filename, bool computeHashes) {
+    Console::out() << "Reading CSV file: " << filename << endl;
+
+    ifstream file(filename);
+    if (!file.is_open()) {
+        throw runtime_error("Failed to open file: " + filename);
+    }
+
+    TableBuilder builder(computeHashes);
+    string line;
+
+    while (getline(file, line)) {
+        builder.addLine(line);
+    }
+
     file.close();
 
-    cout << "CSV reading completed: " << rowCount << " rows, "
-         << columns.size() << " columns" << endl;
+    return builder.finish();
+}
+
+CSVTable CSVReader::parseBuffer(string_view data, bool computeHashes) {
+    TableBuilder builder(computeHashes);
+
+    size_t lineStart = 0;
+    size_t newline;
+    while ((newline = data.find('\n', lineStart)) != string_view::npos) {
+        builder.addLine(data.substr(lineStart, newline - lineStart));
+        lineStart = newline + 1;
+    }
+    if (lineStart < data.size()) {
+        builder.addLine(data.substr(lineStart));
+    }
+
+    return builder.finish();
+}
+
+CSVTable CSVReader::parseRows(string_view data, size_t columnCount, bool computeHashes) {
+    TableBuilder builder(computeHashes, columnCount);
+
+    size_t lineStart = 0;
+    size_t newline;
+    while ((newline = data.find('\n', lineStart)) != string_view::npos) {
+        builder.addLine(data.substr(lineStart, newline - lineStart));
+        lineStart = newline + 1;
+    }
+    if (lineStart < data.size()) {
+        builder.addLine(data.substr(lineStart));
+    }
+
+    return builder.take();
+}
+
+CSVTable CSVReader::readTableAsync(const string& filename,
+                                   const AsyncReadOptions& options,
+                                   bool computeHashes,
+                                   ReadStats* stats) {
+    Console::out() << "Reading CSV file: " << filename
+         << " (block reader, " << ioBackendToString(options.backend) << ")" << endl;
 
-    return columns;
+    TableBuilder builder(computeHashes);
+    string carry;  // Incomplete last line of the previous block
+
+    AsyncFileReader reader(options);
+    ReadStats readStats = reader.read(filename, [&](const char* data, size_t size) {
+        string_view block(data, size);
+        size_t lineStart = 0;
+        size_t newline;
+
+        while ((newline = block.find('\n', lineStart)) != string_view::npos) {
+            string_view line = block.substr(lineStart, newline - lineStart);
+            if (!carry.empty()) {
+                carry.append(line);
+                builder.addLine(carry);
+                carry.clear();
+            } else {
+                builder.addLine(line);
+            }
+            lineStart = newline + 1;
+        }
+
+        carry.append(block.substr(lineStart));
+    });
+
+    if (!carry.empty()) {
+        builder.addLine(carry);
+    }
+
+    Console::out() << "I/O: " << ioBackendToString(readStats.backend)
+         << (readStats.direct ? " (O_DIRECT)" : "")
+         << ", first block after " << readStats.firstBlockSeconds * 1000.0 << " ms"
+         << ", " << readStats.megabytesPerSecond() << " MB/s" << endl;
+
+    if (stats) {
+        *stats = readStats;
+    }
+
+    return builder.finish();
+}
+
+namespace {
+
+    /**
+     * pread until the buffer is full or the file ends
+     */
+    size_t readAt(int fd, char* buffer, size_t size, size_t offset) {
+        size_t done = 0;
+        while (done < size) {
+            ssize_t n = pread(fd, buffer + done, size - done, static_cast<off_t>(offset + done));
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) break;
+            done += static_cast<size_t>(n);
+        }
+        return done;
+    }
+
+} // namespace
+
+CSVTable CSVReader::readSample(const string& filename,
+                               const SampleOptions& options,
+                               SampleInfo* info) {
+    FileHandle file(open(filename.c_str(), O_RDONLY));
+    if (file.fd < 0) {
+        throw runtime_error("Failed to open file: " + filename);
+    }
+
+    struct stat st{};
+    if (fstat(file.fd, &st) != 0) {
+        throw runtime_error("Failed to stat file: " + filename + ": " + strerror(errno));
+    }
+    const auto fileBytes = static_cast<size_t>(st.st_size);
+
+    // Header line
+    string header;
+    size_t headerEnd = 0;
+    {
+        vector<char> buffer(64 * 1024);
+        size_t newline = string::npos;
+        while (newline == string::npos) {
+            size_t n = readAt(file.fd, buffer.data(), buffer.size(), headerEnd);
+            if (n == 0) break;
+            string_view chunk(buffer.data(), n);
+            newline = chunk.find('\n');
+            header.append(chunk.substr(0, newline));
+            headerEnd += newline == string::npos ? n : newline + 1;
+        }
+    }
+
+    const size_t dataBytes = fileBytes - headerEnd;
+    const size_t blocks = max<size_t>(options.blocks, 1);
+    const size_t blockSize = max<size_t>(options.blockSize, 4096);
+
+    SampleInfo sample;
+    sample.fileBytes = fileBytes;
+
+    if (blocks * blockSize >= dataBytes) {
+        Console::out() << "Sample covers the whole file, reading it completely" << endl;
+        CSVTable table = readTable(filename);
+        sample.exact = true;
+        sample.sampledBytes = dataBytes;
+        sample.sampledRows = table.columns.empty() ? 0 : table.columns[0].size();
+        sample.estimatedRows = sample.sampledRows;
+        sample.blockRows.push_back(sample.sampledRows);
+        if (info) *info = std::move(sample);
+        return table;
+    }
+
+    Console::out() << "Sampling CSV file: " << filename << " (" << blocks << " blocks of "
+         << blockSize / 1024 << " KB)" << endl;
+
+    TableBuilder builder(false);
+    builder.addLine(header);
+
+    // One random range inside each of `blocks` equal strata
+    mt19937_64 rng(options.seed);
+    const size_t stratum = dataBytes / blocks;
+    vector<char> buffer(blockSize + 1);
+
+    for (size_t b = 0; b < blocks; ++b) {
+        const size_t slack = stratum > blockSize ? stratum - blockSize : 0;
+        const size_t offset = headerEnd + b * stratum +
+                              (slack > 0 ? uniform_int_distribution<size_t>(0, slack)(rng) : 0);
+
+        // Read from one byte earlier: if that byte is a newline, the range
+        // starts exactly at a line and no line is lost
+        const size_t readOffset = offset - 1;
+        const size_t n = readAt(file.fd, buffer.data(), blockSize + 1, readOffset);
+        string_view block(buffer.data(), n);
+
+        size_t start = block.find('\n');
+        if (start == string_view::npos) {
+            sample.blockRows.push_back(0);
+            continue;  // Range lies inside one long line
+        }
+        ++start;
+
+        const bool atEnd = readOffset + n >= fileBytes;
+        size_t end = atEnd ? n : block.rfind('\n') + 1;
+
+        const size_t rowsBefore = builder.rows();
+        size_t lineStart = start;
+        while (lineStart < end) {
+            size_t newline = block.find('\n', lineStart);
+            size_t lineEnd = newline == string_view::npos || newline >= end ? end : newline;
+            builder.addLine(block.substr(lineStart, lineEnd - lineStart));
+            lineStart = lineEnd + 1;
+        }
+        if (end > start) {
+            sample.sampledBytes += end - start;
+        }
+        sample.blockRows.push_back(builder.rows() - rowsBefore);
+    }
+
+    CSVTable table = builder.finish();
+    sample.sampledRows = table.columns.empty() ? 0 : table.columns[0].size();
+    sample.estimatedRows = sample.sampledBytes > 0
+                           ? static_cast<size_t>(static_cast<double>(sample.sampledRows) *
+                                                 static_cast<double>(dataBytes) /
+                                                 static_cast<double>(sample.sampledBytes))
+                           : 0;
+
+    if (info) *info = std::move(sample);
+    return table;
 }
 
-vector<string> CSVReader::parseLine(const string& line) {
+vector<string> CSVReader::parseLine(string_view line) {
     vector<string> values;
-    stringstream ss(line);
-    string value;
 
-    // Simple parsing: split by comma
-    while (getline(ss, value, ',')) {
-        values.push_back(std::move(value));
+    // Simple parsing: split by comma (a trailing empty field is dropped,
+    // matching getline-based splitting)
+    size_t start = 0;
+    while (start < line.size()) {
+        size_t comma = line.find(',', start);
+        if (comma == string_view::npos) {
+            values.emplace_back(line.substr(start));
+            break;
+        }
+        values.emplace_back(line.substr(start, comma - start));
+        start = comma + 1;
     }
 
     return values;
-}
\ No newline at end of file
+}
@@ -1,9 +1,46 @@
 #ifndef COLUMNANALYZER_CSVREADER_H
 #define COLUMNANALYZER_CSVREADER_H
 
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <functional>
+#include "AsyncFileReader.h"
+
+/**
+ * Parsed CSV table stored by columns
+ */
+struct CSVTable {
+    std::vector<std::string> headers;
+    std::vector<std::vector<std::string>> columns;
+    std::vector<std::vector<uint64_t>> cellHashes;  // Empty unless requested
+};
+
+/**
+ * Settings of a sampled read
+ */
+struct SampleOptions {
+    size_t blocks = 64;             // Byte ranges spread evenly across the file
+    size_t blockSize = 1 << 20;     // Bytes per range
+    uint64_t seed = 42;             // Position of each range within its stratum
+};
+
+/**
+ * What a sampled read covered
+ */
+struct SampleInfo {
+    bool exact = false;             // Sample covers the whole file
+    size_t fileBytes = 0;
+    size_t sampledBytes = 0;        // Bytes of the complete lines kept
+    size_t sampledRows = 0;
+    size_t estimatedRows = 0;       // Data rows in the whole file (extrapolated)
+    std::vector<size_t> blockRows;  // Rows kept from each block, in table order
+
+    [[nodiscard]] double sampleFraction() const {
+        return estimatedRows > 0 ? static_cast<double>(sampledRows) / static_cast<double>(estimatedRows) : 1.0;
+    }
+};
 
 class CSVReader {
 public:
@@ -14,13 +51,69 @@ public:
      */
     static std::vector<std::vector<std::string>> readColumns(const std::string& filename);
 
-private:
+    /**
+     * Reads CSV file into a table with header names
+     * @param filename Path to CSV file
+     * @param computeHashes Hash each cell during parsing (see CellHash.h)
+     * @return Parsed table
+     */
+    static CSVTable readTable(const std::string& filename, bool computeHashes = false);
+
+    /**
+     * Parses CSV text already in memory (header line first)
+     * Lines are parsed in place; the caller keeps ownership of the buffer
+     * @param data CSV text; the last line may lack a newline
+     * @param computeHashes Hash each cell during parsing (see CellHash.h)
+     * @return Parsed table
+     */
+    static CSVTable parseBuffer(std::string_view data, bool computeHashes = false);
+
+    /**
+     * Parses data rows of a known width (no header line), e.g. one chunk
+     * of a file; rows in warnings are counted from the start of data
+     * @param data Whole CSV lines; the last one may lack a newline
+     * @param columnCount Expected values per row; other rows are skipped
+     * @param computeHashes Hash each cell during parsing (see CellHash.h)
+     * @return Table without headers
+     */
+    static CSVTable parseRows(std::string_view data, size_t columnCount, bool computeHashes = false);
+
+    /**
+     * Reads CSV file with the block reader (io_uring or pread fallback)
+     * Completed blocks are parsed while the next reads are in flight
+     * @param filename Path to CSV file
+     * @param options Block reader settings
+     * @param computeHashes Hash each cell during parsing (see CellHash.h)
+     * @param stats Optional read measurements (backend, MB/s, time to first block)
+     * @return Parsed table
+     */
+    static CSVTable readTableAsync(const std::string& filename,
+                                   const AsyncReadOptions& options,
+                                   bool computeHashes = false,
+                                   ReadStats* stats = nullptr);
+
+    /**
+     * Reads the header and random byte ranges spread evenly across the file
+     * Each range is realigned to whole lines (the partial first and last
+     * lines are dropped); files smaller than the sample are read whole
+     * @param filename Path to CSV file
+     * @param options Sample size and seed
+     * @param info Optional description of the sample
+     * @return Table with the sampled rows
+     */
+    static CSVTable readSample(const std::string& filename,
+                               const SampleOptions& options,
+                               SampleInfo* info = nullptr);
+
     /**
      * Parses a single CSV line
      * @param line Line from file
      * @return Vector of values (cells)
      */
-    static std::vector<std::string> parseLine(const std::string& line);
+    static std::vector<std::string> parseLine(std::string_view line);
+
+private:
+    class TableBuilder;
 };
 
 #endif //COLUMNANALYZER_CSVREADER_H
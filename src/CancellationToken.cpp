@@ -0,0 +1,22 @@
+#include "CancellationToken.h"
+#include <csignal>
+
+using namespace std;
+
+CancellationToken CancellationToken::interrupt_;
+thread_local const CancellationToken* CancellationToken::current_ = nullptr;
+
+namespace {
+    void onInterrupt(int) {
+        CancellationToken::interrupt().cancel();
+    }
+} // namespace
+
+void CancellationToken::installInterruptHandler() {
+    struct sigaction action {};
+    action.sa_handler = onInterrupt;
+    sigemptyset(&action.sa_mask);
+    // One-shot: the default action is restored, so a second Ctrl-C kills
+    action.sa_flags = SA_RESETHAND;
+    sigaction(SIGINT, &action, nullptr);
+}
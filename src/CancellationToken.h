@@ -0,0 +1,129 @@
+#ifndef COLUMNANALYZER_CANCELLATIONTOKEN_H
+#define COLUMNANALYZER_CANCELLATIONTOKEN_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+/**
+ * Thrown by scanning loops that observe a cancelled token
+ */
+class OperationCancelled : public std::runtime_error {
+public:
+    OperationCancelled() : std::runtime_error("Operation cancelled") {}
+};
+
+/**
+ * Cooperative cancellation with an optional deadline
+ *
+ * Long loops check the token between chunks (see AnalyzerKernel::forEachChunk
+ * and the CSV readers), so stopping costs one relaxed load per chunk. A
+ * token is made visible to a thread with CancellationToken::Scope; code
+ * that runs without a scope is never cancelled.
+ */
+class CancellationToken {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * Request cancellation (async-signal-safe)
+     */
+    void cancel() { cancelled_.store(true, std::memory_order_relaxed); }
+
+    /**
+     * Cancel automatically once the deadline passes
+     * @param deadline Point in time after which work stops
+     */
+    void setDeadline(Clock::time_point deadline) {
+        deadline_.store(deadline.time_since_epoch().count(), std::memory_order_relaxed);
+    }
+
+    /**
+     * Cancel automatically after a timeout from now
+     * @param timeout Time budget
+     */
+    void setTimeout(std::chrono::milliseconds timeout) {
+        setDeadline(Clock::now() + timeout);
+    }
+
+    /**
+     * Cancellation was requested or the deadline has passed
+     */
+    [[nodiscard]] bool isCancelled() const {
+        return cancelled_.load(std::memory_order_relaxed) || deadlineExpired();
+    }
+
+    /**
+     * The deadline has passed (as opposed to an explicit cancel)
+     */
+    [[nodiscard]] bool deadlineExpired() const {
+        const auto deadline = deadline_.load(std::memory_order_relaxed);
+        return deadline != kNoDeadline && Clock::now().time_since_epoch().count() >= deadline;
+    }
+
+    /**
+     * Clear the cancel request and the deadline
+     */
+    void reset() {
+        cancelled_.store(false, std::memory_order_relaxed);
+        deadline_.store(kNoDeadline, std::memory_order_relaxed);
+    }
+
+    /**
+     * Process-wide token, cancelled by SIGINT once installInterruptHandler() ran
+     */
+    static CancellationToken& interrupt() { return interrupt_; }
+
+    /**
+     * Cancel interrupt() on the first Ctrl-C; a second one terminates the process
+     */
+    static void installInterruptHandler();
+
+    /**
+     * Token of the calling thread's innermost Scope (nullptr if none)
+     */
+    static const CancellationToken* current() { return current_; }
+
+    /**
+     * Throw OperationCancelled if the calling thread's token is cancelled
+     */
+    static void throwIfCancelled() {
+        if (current_ != nullptr && current_->isCancelled()) {
+            throw OperationCancelled();
+        }
+    }
+
+    /**
+     * Makes a token current for the calling thread for its lifetime
+     */
+    class Scope {
+    public:
+        explicit Scope(const CancellationToken* token) : previous_(current_) {
+            current_ = token;
+        }
+
+        ~Scope() { current_ = previous_; }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        const CancellationToken* previous_;
+    };
+
+private:
+    using Ticks = Clock::duration::rep;
+    static constexpr Ticks kNoDeadline = std::numeric_limits<Ticks>::max();
+
+    static_assert(std::atomic<bool>::is_always_lock_free, "cancel() must be signal-safe");
+
+    std::atomic<bool> cancelled_{false};
+    std::atomic<Ticks> deadline_{kNoDeadline};
+
+    static CancellationToken interrupt_;
+    static thread_local const CancellationToken* current_;
+};
+
+#endif //COLUMNANALYZER_CANCELLATIONTOKEN_H
@@ -0,0 +1,103 @@
+#ifndef COLUMNANALYZER_CELLHASH_H
+#define COLUMNANALYZER_CELLHASH_H
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+/**
+ * Fast 64-bit hash for CSV cells (wyhash-style multiply-mix)
+ * Computed once by the reader while the bytes are still in cache
+ */
+namespace CellHash {
+
+    namespace detail {
+        constexpr uint64_t kSecret0 = 0xa0761d6478bd642full;
+        constexpr uint64_t kSecret1 = 0xe7037ed1a0b428dbull;
+        constexpr uint64_t kSecret2 = 0x8ebc6af09c88c6e3ull;
+        constexpr uint64_t kSecret3 = 0x589965cc75374cc3ull;
+
+        inline uint64_t mix(uint64_t a, uint64_t b) {
+            __uint128_t r = static_cast<__uint128_t>(a) * b;
+            return static_cast<uint64_t>(r) ^ static_cast<uint64_t>(r >> 64);
+        }
+
+        inline uint64_t read64(const unsigned char* p) {
+            uint64_t v;
+            std::memcpy(&v, p, sizeof(v));
+            return v;
+        }
+
+        inline uint64_t read32(const unsigned char* p) {
+            uint32_t v;
+            std::memcpy(&v, p, sizeof(v));
+            return v;
+        }
+    }
+
+    /**
+     * Hash a byte range
+     * @param data Pointer to bytes
+     * @param len Number of bytes
+     * @param seed Optional seed
+     * @return 64-bit hash
+     */
+    inline uint64_t hashBytes(const char* data, size_t len, uint64_t seed = 0) {
+        using namespace detail;
+        const auto* p = reinterpret_cast<const unsigned char*>(data);
+
+        seed ^= mix(seed ^ kSecret0, kSecret1);
+        uint64_t a;
+        uint64_t b;
+
+        if (len <= 16) {
+            if (len >= 4) {
+                const size_t shift = (len >> 3) << 2;
+                a = (read32(p) << 32) | read32(p + shift);
+                b = (read32(p + len - 4) << 32) | read32(p + len - 4 - shift);
+            } else if (len > 0) {
+                a = (static_cast<uint64_t>(p[0]) << 16) |
+                    (static_cast<uint64_t>(p[len >> 1]) << 8) |
+                    p[len - 1];
+                b = 0;
+            } else {
+                a = b = 0;
+            }
+        } else {
+            size_t i = len;
+            if (i > 48) {
+                uint64_t see1 = seed;
+                uint64_t see2 = seed;
+                do {
+                    seed = mix(read64(p) ^ kSecret1, read64(p + 8) ^ seed);
+                    see1 = mix(read64(p + 16) ^ kSecret2, read64(p + 24) ^ see1);
+                    see2 = mix(read64(p + 32) ^ kSecret3, read64(p + 40) ^ see2);
+                    p += 48;
+                    i -= 48;
+                } while (i > 48);
+                seed ^= see1 ^ see2;
+            }
+            while (i > 16) {
+                seed = mix(read64(p) ^ kSecret1, read64(p + 8) ^ seed);
+                i -= 16;
+                p += 16;
+            }
+            a = read64(p + i - 16);
+            b = read64(p + i - 8);
+        }
+
+        a ^= kSecret1;
+        b ^= seed;
+        __uint128_t r = static_cast<__uint128_t>(a) * b;
+        a = static_cast<uint64_t>(r);
+        b = static_cast<uint64_t>(r >> 64);
+        return mix(a ^ kSecret0 ^ len, b ^ kSecret1);
+    }
+
+    inline uint64_t hash(const std::string& value) {
+        return hashBytes(value.data(), value.size());
+    }
+
+} // namespace CellHash
+
+#endif //COLUMNANALYZER_CELLHASH_H
@@ -0,0 +1,53 @@
+#include "ColumnAccumulator.h"
+#include "AnalyzerKernel.h"
+#include <stdexcept>
+
+using namespace std;
+
+ColumnAccumulator::ColumnAccumulator(size_t columnIndex, const AnalyzerOptions& options)
+    : options_(options), merged_(columnIndex) {}
+
+void ColumnAccumulator::add(vector<string>& columnData, const vector<uint64_t>* cellHashes) {
+    if (cellHashes != nullptr && cellHashes->size() != columnData.size()) {
+        throw invalid_argument("Column " + to_string(merged_.columnIndex) + ": " +
+                               to_string(cellHashes->size()) + " hashes for " +
+                               to_string(columnData.size()) + " values");
+    }
+
+    DistinctBackend backend = ColumnAnalyzer::chooseBackend(columnData, options_);
+    if (backend == DistinctBackend::SORT && options_.backend == DistinctBackend::AUTO) {
+        backend = DistinctBackend::HASH;
+    }
+    if (backend != DistinctBackend::HASH || options_.statistics != STAT_NONE) {
+        merged_.merge(ColumnAnalyzer::analyze(merged_.columnIndex, columnData, options_, cellHashes));
+        return;
+    }
+
+    AnalyzerKernel::forEachChunk(columnData.size(), [&](size_t begin, size_t end) {
+        for (size_t row = begin; row < end; ++row) {
+            string& value = columnData[row];
+            const uint64_t hash = cellHashes != nullptr ? (*cellHashes)[row] : CellHash::hash(value);
+            if (index_.insert(hash, values_.size(), [&](size_t other) { return values_[other] == value; })) {
+                values_.push_back(std::move(value));
+            }
+        }
+    });
+}
+
+ColumnResult ColumnAccumulator::finish() {
+    ColumnResult result(merged_.columnIndex);
+    result.uniqueValues.reserve(values_.size());
+    for (size_t i = 0; i < values_.size(); ++i) {
+        if ((i & (ProgressReporter::kChunkRows - 1)) == 0) {
+            CancellationToken::throwIfCancelled();
+        }
+        result.uniqueValues.insert(std::move(values_[i]));
+    }
+    result.uniqueCount = result.uniqueValues.size();
+
+    vector<string>().swap(values_);
+    index_ = DistinctIndex();
+    result.merge(std::move(merged_));
+    merged_ = ColumnResult(result.columnIndex);
+    return result;
+}
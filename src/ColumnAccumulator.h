@@ -0,0 +1,53 @@
+#ifndef COLUMNANALYZER_COLUMNACCUMULATOR_H
+#define COLUMNANALYZER_COLUMNACCUMULATOR_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "ColumnAnalyzer.h"
+#include "DistinctIndex.h"
+
+/**
+ * Distinct values of one column fed chunk by chunk (streaming analysis)
+ *
+ * With the hash backend and no statistics, every chunk is probed in one
+ * open-addressing index that lives for the whole run, and only values not
+ * seen before are moved out of the chunk: a duplicate costs one probe, a
+ * new value one string move. This is the IndexSet kernel of a materialized
+ * column spread over chunks, with no value set per chunk and nothing to
+ * merge. Other backends and statistics analyze each chunk on its own and
+ * merge the results. AUTO does not pick SORT here, since a running set
+ * cannot be extended by sorting. Not thread-safe: callers serialize add().
+ */
+class ColumnAccumulator {
+public:
+    /**
+     * Constructor
+     * @param columnIndex Column index
+     * @param options Analyzer options applied to every chunk
+     */
+    ColumnAccumulator(size_t columnIndex, const AnalyzerOptions& options);
+
+    /**
+     * Add a chunk of the column
+     * @param columnData Chunk values; values not seen before are moved out
+     * @param cellHashes Optional precomputed cell hashes of the chunk; give
+     *                   them for every chunk or for none
+     * @throws std::invalid_argument if cellHashes and columnData differ in size
+     */
+    void add(std::vector<std::string>& columnData,
+             const std::vector<uint64_t>* cellHashes = nullptr);
+
+    /**
+     * Result over every chunk added; leaves the accumulator empty
+     */
+    ColumnResult finish();
+
+private:
+    AnalyzerOptions options_;
+    DistinctIndex index_;
+    std::vector<std::string> values_;  // Distinct values, index rows point here
+    ColumnResult merged_;              // Chunks analyzed on their own
+};
+
+#endif //COLUMNANALYZER_COLUMNACCUMULATOR_H
@@ -1,18 +1,195 @@
 #include "ColumnAnalyzer.h"
+#include "AnalyzerKernel.h"
+#include "SortDistinct.h"
+#include <stdexcept>
 
 using namespace std;
 
+void ColumnResult::merge(ColumnResult&& other) {
+    // A part without values says nothing about the encoding; adopt the other's
+    if (uniqueValues.empty()) {
+        bitmap = std::move(other.bitmap);
+    } else if (!other.uniqueValues.empty()) {
+        bitmap.merge(other.bitmap);
+    }
+
+    if (fingerprints.empty()) {
+        // Empty part: identity, adopt the other's fingerprints and audit
+        if (!other.fingerprints.empty() || fingerprints.bits() == 0) {
+            fingerprints = std::move(other.fingerprints);
+            fingerprintCollisions = other.fingerprintCollisions;
+            fingerprintsVerified = other.fingerprintsVerified;
+        }
+    } else if (!other.fingerprints.empty()) {
+        fingerprints.merge(other.fingerprints);
+        fingerprintCollisions += other.fingerprintCollisions;
+        fingerprintsVerified = false;
+    }
+    const size_t verifiedCount = fingerprints.empty() ? 0 : max(uniqueCount, other.uniqueCount);
+
+    if (uniqueValues.size() < other.uniqueValues.size()) {
+        swap(uniqueValues, other.uniqueValues);
+    }
+    uniqueValues.merge(other.uniqueValues);  // Node splicing
+    other.uniqueValues.clear();              // Duplicates left behind
+    uniqueCount = uniqueValues.size();
+    if (!fingerprints.empty()) {
+        // A verified count is exact; otherwise the fingerprint count
+        uniqueCount = fingerprintsVerified ? verifiedCount : fingerprints.size();
+    }
+
+    statistics.merge(other.statistics);
+    complete = complete && other.complete;
+    if (columnName.empty()) {
+        columnName = std::move(other.columnName);
+    }
+}
+
+DistinctBackend backendFromString(const string& name) {
+    if (name == "hash") return DistinctBackend::HASH;
+    if (name == "sort") return DistinctBackend::SORT;
+    if (name == "bitmap") return DistinctBackend::BITMAP;
+    if (name == "fingerprint") return DistinctBackend::FINGERPRINT;
+    if (name == "auto") return DistinctBackend::AUTO;
+    throw invalid_argument("Unknown backend: " + name +
+                           ". Valid values: hash, sort, bitmap, fingerprint, auto");
+}
+
+namespace {
+
+    using namespace AnalyzerKernel;
+    using NoStatistics = StaticStatistics<STAT_NONE>;
+
+    void checkHashes(size_t columnIndex,
+                     const vector<string>& columnData,
+                     const vector<uint64_t>& cellHashes) {
+        if (cellHashes.size() != columnData.size()) {
+            throw invalid_argument("Column " + to_string(columnIndex) + ": " +
+                                   to_string(cellHashes.size()) + " hashes for " +
+                                   to_string(columnData.size()) + " values");
+        }
+    }
+
+    /**
+     * Pick the set policy, then the hash policy, for an already chosen
+     * statistics set; every combination is a separate kernel
+     */
+    template <typename Stats>
+    ColumnResult dispatchKernel(size_t columnIndex,
+                                const vector<string>& columnData,
+                                const AnalyzerOptions& options,
+                                DistinctBackend backend,
+                                const vector<uint64_t>* cellHashes) {
+        if (backend == DistinctBackend::SORT) {
+            return run<Stats>(columnIndex, columnData, HashValues{},
+                              SortedSet{options.sortThreads});
+        }
+
+        if (backend == DistinctBackend::FINGERPRINT) {
+            FingerprintedSet set{options.fingerprintBits, options.verifyFingerprints};
+            if (cellHashes != nullptr) {
+                return run<Stats>(columnIndex, columnData, ReuseCellHashes{cellHashes->data()}, set);
+            }
+            return run<Stats>(columnIndex, columnData, HashValues{}, set);
+        }
+
+        if (backend == DistinctBackend::BITMAP) {
+            const BitmapEncoding encoding = ValueBitmap::detect(columnData);
+            if (encoding != BitmapEncoding::NONE) {
+                BitmapSet set{encoding};
+                if (cellHashes != nullptr) {
+                    return run<Stats>(columnIndex, columnData, ReuseCellHashes{cellHashes->data()}, set);
+                }
+                return run<Stats>(columnIndex, columnData, HashValues{}, set);
+            }
+        }
+
+        if (options.insertBatchSize > 0) {
+            BatchedIndexSet set{options.insertBatchSize};
+            if (cellHashes != nullptr) {
+                return run<Stats>(columnIndex, columnData, ReuseCellHashes{cellHashes->data()}, set);
+            }
+            return run<Stats>(columnIndex, columnData, HashValues{}, set);
+        }
+
+        if (cellHashes != nullptr) {
+            return run<Stats>(columnIndex, columnData, ReuseCellHashes{cellHashes->data()}, IndexSet{});
+        }
+        return run<Stats>(columnIndex, columnData, HashValues{}, IndexSet{});
+    }
+
+} // namespace
+
 ColumnResult ColumnAnalyzer::analyze(size_t columnIndex,
                                      const vector<string>& columnData) {
-    ColumnResult result(columnIndex);
+    return run<NoStatistics>(columnIndex, columnData, HashValues{}, IndexSet{});
+}
+
+ColumnResult ColumnAnalyzer::analyze(size_t columnIndex,
+                                     const vector<string>& columnData,
+                                     const vector<uint64_t>& cellHashes) {
+    checkHashes(columnIndex, columnData, cellHashes);
+    return run<NoStatistics>(columnIndex, columnData, ReuseCellHashes{cellHashes.data()}, IndexSet{});
+}
+
+ColumnResult ColumnAnalyzer::analyze(size_t columnIndex,
+                                     const vector<string>& columnData,
+                                     const AnalyzerOptions& options,
+                                     const vector<uint64_t>* cellHashes) {
+    if (cellHashes != nullptr) {
+        checkHashes(columnIndex, columnData, *cellHashes);
+    }
+
+    // Runtime configuration is resolved here, once per column
+    const DistinctBackend backend = chooseBackend(columnData, options);
+    return withStatistics(options.statistics, [&](auto statistics) {
+        using Stats = decltype(statistics);
+        return dispatchKernel<Stats>(columnIndex, columnData, options, backend, cellHashes);
+    });
+}
 
-    // Add to unordered_set — O(1) avg
-    // Auto duplicates filtering
-    for (const auto& value : columnData) {
-        result.uniqueValues.insert(value);
+ColumnResult ColumnAnalyzer::analyzeBatched(size_t columnIndex,
+                                            const vector<string>& columnData,
+                                            size_t batchSize,
+                                            const vector<uint64_t>* cellHashes) {
+    if (cellHashes != nullptr) {
+        checkHashes(columnIndex, columnData, *cellHashes);
+        return run<NoStatistics>(columnIndex, columnData, ReuseCellHashes{cellHashes->data()},
+                                 BatchedIndexSet{batchSize});
     }
+    return run<NoStatistics>(columnIndex, columnData, HashValues{}, BatchedIndexSet{batchSize});
+}
 
-    result.uniqueCount = result.uniqueValues.size();
+ColumnResult ColumnAnalyzer::analyzeSorted(size_t columnIndex,
+                                           const vector<string>& columnData,
+                                           size_t numThreads) {
+    return run<NoStatistics>(columnIndex, columnData, HashValues{}, SortedSet{numThreads});
+}
+
+ColumnResult ColumnAnalyzer::analyzeBitmap(size_t columnIndex,
+                                           const vector<string>& columnData,
+                                           BitmapEncoding encoding) {
+    if (encoding == BitmapEncoding::NONE) {
+        encoding = ValueBitmap::detect(columnData);
+    }
+    if (encoding == BitmapEncoding::NONE) {
+        return run<NoStatistics>(columnIndex, columnData, HashValues{}, IndexSet{});
+    }
+    return run<NoStatistics>(columnIndex, columnData, HashValues{}, BitmapSet{encoding});
+}
 
-    return result;
-}
\ No newline at end of file
+DistinctBackend ColumnAnalyzer::chooseBackend(const vector<string>& columnData,
+                                              const AnalyzerOptions& options) {
+    if (options.backend != DistinctBackend::AUTO) {
+        return options.backend;
+    }
+    if (ValueBitmap::detect(columnData, 1024, ValueBitmap::kMaxAutoKey) != BitmapEncoding::NONE) {
+        return DistinctBackend::BITMAP;
+    }
+    if (columnData.size() < kMinSortRows) {
+        return DistinctBackend::HASH;
+    }
+    return SortDistinct::estimateDistinctRatio(columnData) >= options.sortDistinctRatio
+           ? DistinctBackend::SORT
+           : DistinctBackend::HASH;
+}
@@ -1,20 +1,84 @@
 #ifndef COLUMNANALYZER_COLUMNANALYZER_H
 #define COLUMNANALYZER_COLUMNANALYZER_H
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <unordered_set>
+#include "ColumnStatistics.h"
+#include "FingerprintSet.h"
+#include "ValueBitmap.h"
 
 /**
  * Result of analyzing a single column
  */
 struct ColumnResult {
     size_t columnIndex;
+    std::string columnName;  // Header name, set when results are merged by name
     std::unordered_set<std::string> uniqueValues;
     size_t uniqueCount;
+    ColumnStatistics statistics;  // Filled when AnalyzerOptions::statistics is set
+    DistinctEstimate estimate;    // Filled in sample mode; uniqueCount is then the estimate
+    bool complete = true;         // False if cancelled before the column finished
+    ValueBitmap bitmap;           // Distinct keys, filled by the bitmap backend
+    FingerprintSet fingerprints;  // Fingerprint backend: value hashes instead of uniqueValues
+    size_t fingerprintCollisions = 0;   // Values sharing a fingerprint, found by verification
+    bool fingerprintsVerified = false;  // uniqueCount checked against the original bytes
 
     explicit ColumnResult(size_t index = 0)
             : columnIndex(index), uniqueCount(0) {}
+
+    /**
+     * Absorb a partial result of the same column (another chunk, thread,
+     * file or run). The smaller value set is spliced into the larger one,
+     * so no strings are copied. Associative and commutative up to floating
+     * point rounding of the numeric statistics; an empty result is the
+     * identity. Keeps this result's index and name. Fingerprint sets are
+     * united; a merge of two non-empty parts is no longer verified, since
+     * values of different parts were never compared.
+     * @param other Partial result, left empty
+     */
+    void merge(ColumnResult&& other);
+};
+
+/**
+ * Distinct counting backend
+ */
+enum class DistinctBackend {
+    HASH,         // Hash set insertion
+    SORT,         // Sort string_views, count adjacent-unique runs
+    BITMAP,       // Bit vector / roaring bitmap of keys for small-domain columns
+    FINGERPRINT,  // Flat set of 64/128-bit value hashes; counts only, values are not kept
+    AUTO          // Per column, from a sampled domain and cardinality estimate
+};
+
+/**
+ * Convert backend name ("hash", "sort", "bitmap", "fingerprint", "auto") to backend
+ */
+DistinctBackend backendFromString(const std::string& name);
+
+/**
+ * Analyzer tuning options
+ */
+struct AnalyzerOptions {
+    DistinctBackend backend = DistinctBackend::HASH;
+
+    // Threads for the sort backend within one column (0 = decided by ParallelProcessor)
+    size_t sortThreads = 1;
+
+    // AUTO picks SORT when the sampled distinct ratio is at least this high
+    double sortDistinctRatio = 0.95;
+
+    // Values hashed and prefetched per block; 0 = insert one at a time
+    size_t insertBatchSize = 0;
+
+    // StatisticFlags computed in the same scan as the distinct count
+    unsigned statistics = STAT_NONE;
+
+    // FINGERPRINT: width (64 or 128) and a second pass that counts exactly
+    // over the original bytes and reports the values lost to collisions
+    unsigned fingerprintBits = 64;
+    bool verifyFingerprints = false;
 };
 
 /**
@@ -30,6 +94,85 @@ public:
      */
     static ColumnResult analyze(size_t columnIndex,
                          const std::vector<std::string>& columnData) ;
+
+    /**
+     * Analyzes a column using cell hashes precomputed by the reader
+     * Values are compared byte-wise only when their hashes collide
+     * @param columnIndex Column index
+     * @param columnData Column data (vector of strings)
+     * @param cellHashes Hash of each cell (same size as columnData)
+     * @return Analysis result
+     */
+    static ColumnResult analyze(size_t columnIndex,
+                                const std::vector<std::string>& columnData,
+                                const std::vector<uint64_t>& cellHashes);
+
+    /**
+     * Analyzes a column with the given options
+     * @param columnIndex Column index
+     * @param columnData Column data (vector of strings)
+     * @param options Analyzer options
+     * @param cellHashes Optional precomputed cell hashes
+     * @return Analysis result
+     */
+    static ColumnResult analyze(size_t columnIndex,
+                                const std::vector<std::string>& columnData,
+                                const AnalyzerOptions& options,
+                                const std::vector<uint64_t>* cellHashes = nullptr);
+
+    /**
+     * Batched insertion kernel: hash a block of values, prefetch their
+     * buckets, then probe, so the cache misses of the block overlap
+     * @param columnIndex Column index
+     * @param columnData Column data (vector of strings)
+     * @param batchSize Values per block (clamped to 1..kMaxBatchSize)
+     * @param cellHashes Optional precomputed cell hashes
+     * @return Analysis result
+     */
+    static ColumnResult analyzeBatched(size_t columnIndex,
+                                       const std::vector<std::string>& columnData,
+                                       size_t batchSize,
+                                       const std::vector<uint64_t>* cellHashes = nullptr);
+
+    /**
+     * Sort-based backend: parallel sort of the column's string_views
+     * followed by an adjacent-unique pass
+     * @param columnIndex Column index
+     * @param columnData Column data (vector of strings)
+     * @param numThreads Threads for sorting
+     * @return Analysis result
+     */
+    static ColumnResult analyzeSorted(size_t columnIndex,
+                                      const std::vector<std::string>& columnData,
+                                      size_t numThreads = 1);
+
+    /**
+     * Bitmap backend: single-byte or small integer cells become keys in a
+     * direct bit vector (keys < 2^16) or a roaring bitmap; the column falls
+     * back to hashing from the first cell that does not fit the encoding
+     * @param columnIndex Column index
+     * @param columnData Column data (vector of strings)
+     * @param encoding Key encoding (NONE = detect from a sample)
+     * @return Analysis result with ColumnResult::bitmap filled
+     */
+    static ColumnResult analyzeBitmap(size_t columnIndex,
+                                      const std::vector<std::string>& columnData,
+                                      BitmapEncoding encoding = BitmapEncoding::NONE);
+
+    /**
+     * Backend AUTO resolves to for a column
+     * @param columnData Column data
+     * @param options Analyzer options
+     * @return HASH, SORT or BITMAP (FINGERPRINT only when asked for,
+     *         since it drops the values)
+     */
+    static DistinctBackend chooseBackend(const std::vector<std::string>& columnData,
+                                         const AnalyzerOptions& options);
+
+    static constexpr size_t kMaxBatchSize = 64;
+
+    // AUTO never sorts columns smaller than this (hashing small columns is cheap)
+    static constexpr size_t kMinSortRows = 1 << 14;
 };
 
 #endif //COLUMNANALYZER_COLUMNANALYZER_H
@@ -0,0 +1,130 @@
+#include "ColumnStatistics.h"
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+using namespace std;
+
+unsigned statisticsFromString(const string& list) {
+    unsigned flags = STAT_NONE;
+    stringstream ss(list);
+    string name;
+
+    while (getline(ss, name, ',')) {
+        if (name == "all") {
+            flags |= STAT_ALL;
+        } else if (name == "nulls") {
+            flags |= STAT_NULLS;
+        } else if (name == "minmax") {
+            flags |= STAT_MINMAX;
+        } else if (name == "lengths") {
+            flags |= STAT_LENGTHS;
+        } else if (name == "numeric") {
+            flags |= STAT_NUMERIC;
+        } else if (!name.empty()) {
+            throw invalid_argument("Unknown statistic: " + name +
+                                   ". Valid values: nulls, minmax, lengths, numeric, all");
+        }
+    }
+
+    return flags;
+}
+
+string ColumnStatistics::lengthBucketLabel(size_t bucket) {
+    if (bucket == 0) return "0";
+    if (bucket == 1) return "1";
+    size_t low = size_t{1} << (bucket - 1);
+    if (bucket + 1 == kLengthBuckets) return to_string(low) + "+";
+    return to_string(low) + "-" + to_string((low << 1) - 1);
+}
+
+void ColumnStatistics::merge(const ColumnStatistics& other) {
+    if (other.rowCount == 0) {
+        return;
+    }
+    if (rowCount == 0) {
+        *this = other;
+        return;
+    }
+
+    if (computed & STAT_NULLS) {
+        nullCount += other.nullCount;
+    }
+    if (computed & STAT_MINMAX) {
+        minValue = min(minValue, other.minValue);
+        maxValue = max(maxValue, other.maxValue);
+    }
+    if (computed & STAT_LENGTHS) {
+        lengthHistogram.resize(max(lengthHistogram.size(), other.lengthHistogram.size()), 0);
+        for (size_t i = 0; i < other.lengthHistogram.size(); ++i) {
+            lengthHistogram[i] += other.lengthHistogram[i];
+        }
+    }
+    if ((computed & STAT_NUMERIC) && other.numericCount > 0) {
+        // Chan et al. pairwise combination of mean and sum of squared deviations
+        const auto n1 = static_cast<double>(numericCount);
+        const auto n2 = static_cast<double>(other.numericCount);
+        const double n = n1 + n2;
+        const double m2a = numericCount > 1 ? stddev * stddev * (n1 - 1.0) : 0.0;
+        const double m2b = other.numericCount > 1 ? other.stddev * other.stddev * (n2 - 1.0) : 0.0;
+        const double delta = other.mean - mean;
+
+        const double m2 = m2a + m2b + delta * delta * n1 * n2 / n;
+        mean += delta * n2 / n;
+        sum += other.sum;
+        numericCount += other.numericCount;
+        stddev = numericCount > 1 ? sqrt(m2 / (n - 1.0)) : 0.0;
+    }
+
+    rowCount += other.rowCount;
+}
+
+namespace {
+
+    /**
+     * Runtime adapter over a non-virtual aggregation kernel
+     */
+    template <typename Kernel>
+    class KernelAggregation : public ColumnAggregation {
+    public:
+        void update(const string& value) override {
+            kernel_.update(value);
+        }
+
+        void finish(ColumnStatistics& stats) const override {
+            kernel_.finish(stats);
+        }
+
+    private:
+        Kernel kernel_;
+    };
+
+} // namespace
+
+StatisticsAccumulator::StatisticsAccumulator(unsigned flags)
+    : flags_(flags) {
+    if (flags & STAT_NULLS) {
+        aggregations_.push_back(make_unique<KernelAggregation<Aggregations::NullCount>>());
+    }
+    if (flags & STAT_MINMAX) {
+        aggregations_.push_back(make_unique<KernelAggregation<Aggregations::MinMax>>());
+    }
+    if (flags & STAT_LENGTHS) {
+        aggregations_.push_back(make_unique<KernelAggregation<Aggregations::LengthHistogram>>());
+    }
+    if (flags & STAT_NUMERIC) {
+        aggregations_.push_back(make_unique<KernelAggregation<Aggregations::Numeric>>());
+    }
+}
+
+ColumnStatistics StatisticsAccumulator::finish() const {
+    ColumnStatistics stats;
+    stats.computed = flags_;
+    stats.rowCount = rowCount_;
+
+    for (const auto& aggregation : aggregations_) {
+        aggregation->finish(stats);
+    }
+
+    return stats;
+}
@@ -0,0 +1,292 @@
+#ifndef COLUMNANALYZER_COLUMNSTATISTICS_H
+#define COLUMNANALYZER_COLUMNSTATISTICS_H
+
+#include <array>
+#include <cmath>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include "NumericParser.h"
+
+/**
+ * Statistics that can be requested in addition to the distinct count
+ */
+enum StatisticFlags : unsigned {
+    STAT_NONE    = 0,
+    STAT_NULLS   = 1u << 0,  // Null/empty cell count
+    STAT_MINMAX  = 1u << 1,  // Lexicographic min/max value
+    STAT_LENGTHS = 1u << 2,  // Value length histogram
+    STAT_NUMERIC = 1u << 3,  // Numeric count, sum, mean, stddev
+    STAT_ALL     = STAT_NULLS | STAT_MINMAX | STAT_LENGTHS | STAT_NUMERIC
+};
+
+/**
+ * Parse a comma-separated statistics list ("nulls,minmax,lengths,numeric" or "all")
+ * @param list Statistics names
+ * @return Combination of StatisticFlags
+ */
+unsigned statisticsFromString(const std::string& list);
+
+/**
+ * Per-column statistics (fields are valid only for flags set in `computed`)
+ */
+struct ColumnStatistics {
+    unsigned computed = STAT_NONE;
+    size_t rowCount = 0;
+
+    // STAT_NULLS
+    size_t nullCount = 0;
+
+    // STAT_MINMAX
+    std::string minValue;
+    std::string maxValue;
+
+    // STAT_LENGTHS: bucket 0 = empty, bucket k = length in [2^(k-1), 2^k)
+    std::vector<size_t> lengthHistogram;
+
+    // STAT_NUMERIC (cells that parse fully as numbers)
+    size_t numericCount = 0;
+    double sum = 0.0;
+    double mean = 0.0;
+    double stddev = 0.0;
+
+    static constexpr size_t kLengthBuckets = 9;  // Last bucket is 128+
+
+    /**
+     * Label of a length histogram bucket ("0", "1", "2-3", ..., "128+")
+     */
+    static std::string lengthBucketLabel(size_t bucket);
+
+    /**
+     * Combine statistics of another part of the same column
+     * @param other Statistics of the other part (same flags)
+     */
+    void merge(const ColumnStatistics& other);
+};
+
+/**
+ * Whole-file estimates derived from a sample (--sample mode)
+ */
+struct DistinctEstimate {
+    bool sampled = false;
+    size_t sampleDistinct = 0;   // Distinct values seen in the sample
+    double estimate = 0.0;       // Estimated distinct values in the whole file
+    double lower = 0.0;          // 95% confidence interval
+    double upper = 0.0;
+
+    /**
+     * Frequent value with its estimated share of all rows
+     */
+    struct ValueShare {
+        std::string value;
+        double share = 0.0;
+        double lower = 0.0;      // 95% confidence interval
+        double upper = 0.0;
+    };
+
+    std::vector<ValueShare> topValues;  // Most frequent values in the sample
+};
+
+/**
+ * Non-virtual aggregation kernels shared by the compile-time
+ * StaticStatistics and the reference StatisticsAccumulator
+ */
+namespace Aggregations {
+
+    class NullCount {
+    public:
+        void update(std::string_view value) {
+            if (value.empty() || value == "NULL" || value == "null") {
+                ++nulls_;
+            }
+        }
+
+        void finish(ColumnStatistics& stats) const {
+            stats.nullCount = nulls_;
+        }
+
+    private:
+        size_t nulls_ = 0;
+    };
+
+    class MinMax {
+    public:
+        void update(std::string_view value) {
+            if (!seen_) {
+                min_ = max_ = value;
+                seen_ = true;
+            } else if (value < min_) {
+                min_ = value;
+            } else if (max_ < value) {
+                max_ = value;
+            }
+        }
+
+        void finish(ColumnStatistics& stats) const {
+            stats.minValue = min_;
+            stats.maxValue = max_;
+        }
+
+    private:
+        bool seen_ = false;
+        std::string min_;
+        std::string max_;
+    };
+
+    class LengthHistogram {
+    public:
+        void update(std::string_view value) {
+            size_t bucket = 0;
+            for (size_t len = value.size(); len != 0 && bucket + 1 < buckets_.size(); len >>= 1) {
+                ++bucket;
+            }
+            ++buckets_[bucket];
+        }
+
+        void finish(ColumnStatistics& stats) const {
+            stats.lengthHistogram.assign(buckets_.begin(), buckets_.end());
+        }
+
+    private:
+        std::array<size_t, ColumnStatistics::kLengthBuckets> buckets_{};
+    };
+
+    /**
+     * Welford's online mean/variance over cells that parse as numbers
+     */
+    class Numeric {
+    public:
+        void update(std::string_view value) {
+            double x;
+            if (!NumericParser::parseDouble(value, x)) {
+                return;
+            }
+
+            ++count_;
+            sum_ += x;
+            double delta = x - mean_;
+            mean_ += delta / static_cast<double>(count_);
+            m2_ += delta * (x - mean_);
+        }
+
+        void finish(ColumnStatistics& stats) const {
+            stats.numericCount = count_;
+            stats.sum = sum_;
+            stats.mean = mean_;
+            stats.stddev = count_ > 1 ? std::sqrt(m2_ / static_cast<double>(count_ - 1)) : 0.0;
+        }
+
+    private:
+        size_t count_ = 0;
+        double sum_ = 0.0;
+        double mean_ = 0.0;
+        double m2_ = 0.0;
+    };
+
+} // namespace Aggregations
+
+/**
+ * Statistics set fixed at compile time
+ * Each requested aggregation is called directly and inlined into the
+ * scan loop; with STAT_NONE, update() compiles to nothing
+ * @tparam Flags Combination of StatisticFlags
+ */
+template <unsigned Flags>
+class StaticStatistics {
+public:
+    static constexpr unsigned kFlags = Flags;
+
+    template <typename Value>
+    void update(const Value& value) {
+        if constexpr (Flags != STAT_NONE) {
+            const std::string_view cell(value);
+            ++rowCount_;
+            if constexpr ((Flags & STAT_NULLS) != 0) nulls_.update(cell);
+            if constexpr ((Flags & STAT_MINMAX) != 0) minMax_.update(cell);
+            if constexpr ((Flags & STAT_LENGTHS) != 0) lengths_.update(cell);
+            if constexpr ((Flags & STAT_NUMERIC) != 0) numeric_.update(cell);
+        }
+    }
+
+    [[nodiscard]] ColumnStatistics finish() const {
+        ColumnStatistics stats;
+        stats.computed = Flags;
+        stats.rowCount = rowCount_;
+        if constexpr ((Flags & STAT_NULLS) != 0) nulls_.finish(stats);
+        if constexpr ((Flags & STAT_MINMAX) != 0) minMax_.finish(stats);
+        if constexpr ((Flags & STAT_LENGTHS) != 0) lengths_.finish(stats);
+        if constexpr ((Flags & STAT_NUMERIC) != 0) numeric_.finish(stats);
+        return stats;
+    }
+
+private:
+    size_t rowCount_ = 0;
+    Aggregations::NullCount nulls_;
+    Aggregations::MinMax minMax_;
+    Aggregations::LengthHistogram lengths_;
+    Aggregations::Numeric numeric_;
+};
+
+/**
+ * Runtime-polymorphic aggregation over the cells of one column,
+ * used only by StatisticsAccumulator
+ */
+class ColumnAggregation {
+public:
+    virtual ~ColumnAggregation() = default;
+
+    /**
+     * Account for one cell
+     * @param value Cell value
+     */
+    virtual void update(const std::string& value) = 0;
+
+    /**
+     * Write the aggregated values
+     * @param stats Statistics to fill
+     */
+    virtual void finish(ColumnStatistics& stats) const = 0;
+};
+
+/**
+ * Reference implementation of the statistics with runtime dispatch
+ *
+ * The analyzer kernels use StaticStatistics; this accumulator runs the same
+ * Aggregations:: kernels behind virtual calls and exists only for parity
+ * tests and as the polymorphic baseline in bench_kernels. A new statistic
+ * is a new Aggregations:: class, a StatisticFlags bit and a line in
+ * StaticStatistics (plus its registration here to keep parity).
+ */
+class StatisticsAccumulator {
+public:
+    /**
+     * Constructor
+     * @param flags Combination of StatisticFlags
+     */
+    explicit StatisticsAccumulator(unsigned flags);
+
+    /**
+     * Feed one cell to every aggregation
+     * @param value Cell value
+     */
+    void update(const std::string& value) {
+        ++rowCount_;
+        for (const auto& aggregation : aggregations_) {
+            aggregation->update(value);
+        }
+    }
+
+    /**
+     * Collect results of all aggregations
+     * @return Column statistics
+     */
+    [[nodiscard]] ColumnStatistics finish() const;
+
+private:
+    unsigned flags_;
+    size_t rowCount_ = 0;
+    std::vector<std::unique_ptr<ColumnAggregation>> aggregations_;
+};
+
+#endif //COLUMNANALYZER_COLUMNSTATISTICS_H
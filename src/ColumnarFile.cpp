@@ -0,0 +1,242 @@
+#include "ColumnarFile.h"
+#include "AsyncFileReader.h"
+#include "SortDistinct.h"
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+
+using namespace std;
+
+namespace {
+
+    constexpr char kMagic[8] = {'P', 'C', 'A', 'C', 'O', 'L', '0', '1'};
+    constexpr size_t kMaxIov = 1024;
+
+    /**
+     * Batches iovecs and flushes them with writev
+     */
+    class VectorWriter {
+    public:
+        explicit VectorWriter(int fd) : fd_(fd) {}
+
+        ~VectorWriter() { close(fd_); }
+
+        void add(const void* data, size_t size) {
+            if (size == 0) return;
+            iov_[count_++] = iovec{const_cast<void*>(data), size};
+            if (count_ == kMaxIov) flush();
+        }
+
+        /**
+         * Copy a small scalar into owned scratch space, then queue it
+         */
+        template <typename T>
+        void addScalar(T value) {
+            if (scratchUsed_ + sizeof(T) > sizeof(scratch_)) flush();
+            memcpy(scratch_ + scratchUsed_, &value, sizeof(T));
+            add(scratch_ + scratchUsed_, sizeof(T));
+            scratchUsed_ += sizeof(T);
+        }
+
+        void flush() {
+            size_t first = 0;
+            while (first < count_) {
+                ssize_t n = writev(fd_, iov_ + first, static_cast<int>(count_ - first));
+                if (n < 0) {
+                    if (errno == EINTR) continue;
+                    throw runtime_error(string("Write failed: ") + strerror(errno));
+                }
+                // Skip fully written entries, trim a partially written one
+                auto written = static_cast<size_t>(n);
+                while (first < count_ && written >= iov_[first].iov_len) {
+                    written -= iov_[first++].iov_len;
+                }
+                if (written > 0) {
+                    iov_[first].iov_base = static_cast<char*>(iov_[first].iov_base) + written;
+                    iov_[first].iov_len -= written;
+                }
+            }
+            count_ = 0;
+            scratchUsed_ = 0;
+        }
+
+    private:
+        int fd_;
+        iovec iov_[kMaxIov];
+        size_t count_ = 0;
+        char scratch_[kMaxIov * sizeof(uint64_t)];
+        size_t scratchUsed_ = 0;
+    };
+
+    uint64_t readU64(const char* p) {
+        uint64_t v;
+        memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+    uint32_t readU32(const char* p) {
+        uint32_t v;
+        memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+} // namespace
+
+void ColumnarFileWriter::write(const vector<ColumnResult>& results, const string& filename,
+                               size_t sortThreads) {
+    int fd = open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        throw runtime_error("Failed to open output file: " + filename);
+    }
+
+    VectorWriter out(fd);
+    out.add(kMagic, sizeof(kMagic));
+    out.addScalar(static_cast<uint32_t>(results.size()));
+
+    for (const auto& result : results) {
+        out.addScalar(static_cast<uint64_t>(result.columnIndex));
+        out.addScalar(static_cast<uint32_t>(result.columnName.size()));
+        out.add(result.columnName.data(), result.columnName.size());
+        out.addScalar(static_cast<uint64_t>(result.uniqueCount));
+        out.addScalar(static_cast<uint64_t>(result.uniqueValues.size()));
+
+        // Offsets, then value bytes in the same order; views point into
+        // the result sets, so sorting copies no value bytes
+        vector<string_view> values;
+        if (sortThreads > 0) {
+            values = SortDistinct::sortedViews(result.uniqueValues, sortThreads);
+        } else {
+            values.assign(result.uniqueValues.begin(), result.uniqueValues.end());
+        }
+
+        vector<uint64_t> offsets;
+        offsets.reserve(values.size() + 1);
+        uint64_t offset = 0;
+        offsets.push_back(offset);
+        for (string_view value : values) {
+            offset += value.size();
+            offsets.push_back(offset);
+        }
+        out.add(offsets.data(), offsets.size() * sizeof(uint64_t));
+
+        for (string_view value : values) {
+            out.add(value.data(), value.size());
+        }
+
+        out.flush();  // offsets must outlive the queued iovecs
+    }
+
+    out.flush();
+}
+
+string_view ColumnarFileReader::Column::value(size_t i) const {
+    if (i >= valueCount) {
+        throw out_of_range("Value index out of range");
+    }
+    uint64_t begin = readU64(offsets + i * sizeof(uint64_t));
+    uint64_t end = readU64(offsets + (i + 1) * sizeof(uint64_t));
+    return {data + begin, static_cast<size_t>(end - begin)};
+}
+
+ColumnarFileReader::Mapping::~Mapping() {
+    if (data != nullptr) {
+        munmap(data, size);
+    }
+}
+
+ColumnarFileReader::ColumnarFileReader(const string& filename) {
+    {
+        FileHandle file(open(filename.c_str(), O_RDONLY));
+        if (file.fd < 0) {
+            throw runtime_error("Failed to open file: " + filename);
+        }
+
+        struct stat st{};
+        if (fstat(file.fd, &st) != 0) {
+            throw runtime_error("Failed to stat file: " + filename + ": " + strerror(errno));
+        }
+        const auto size = static_cast<size_t>(st.st_size);
+        if (size == 0) {
+            throw runtime_error("Not a columnar results file: " + filename);
+        }
+
+        void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file.fd, 0);
+        if (data == MAP_FAILED) {
+            throw runtime_error("Failed to map file: " + filename);
+        }
+        mapping_.data = data;
+        mapping_.size = size;
+    }
+
+    const char* base = static_cast<const char*>(mapping_.data);
+    const char* end = base + mapping_.size;
+    const char* p = base;
+
+    auto remaining = [&]() { return static_cast<size_t>(end - p); };
+    auto corrupt = [&](const string& what) {
+        return runtime_error("Corrupt columnar file " + filename + ": " + what);
+    };
+    auto need = [&](size_t bytes) {
+        if (remaining() < bytes) {
+            throw runtime_error("Truncated columnar file: " + filename);
+        }
+    };
+
+    need(sizeof(kMagic) + sizeof(uint32_t));
+    if (memcmp(p, kMagic, sizeof(kMagic)) != 0) {
+        throw runtime_error("Not a columnar results file: " + filename);
+    }
+    p += sizeof(kMagic);
+    uint32_t columnCount = readU32(p);
+    p += sizeof(uint32_t);
+
+    // Smallest column: index, name length, counts and one offset
+    constexpr size_t kMinColumnBytes = 4 * sizeof(uint64_t) + sizeof(uint32_t);
+    if (columnCount > remaining() / kMinColumnBytes) {
+        throw corrupt("column count " + to_string(columnCount) + " exceeds file size");
+    }
+
+    columns_.resize(columnCount);
+    for (auto& column : columns_) {
+        need(sizeof(uint64_t) + sizeof(uint32_t));
+        column.columnIndex = readU64(p);
+        p += sizeof(uint64_t);
+        uint32_t nameLength = readU32(p);
+        p += sizeof(uint32_t);
+
+        need(size_t{nameLength} + 2 * sizeof(uint64_t));
+        column.name.assign(p, nameLength);
+        p += nameLength;
+        column.uniqueCount = readU64(p);
+        p += sizeof(uint64_t);
+        const uint64_t valueCount = readU64(p);
+        p += sizeof(uint64_t);
+
+        // Offsets: valueCount + 1 words, checked before multiplying
+        if (valueCount >= remaining() / sizeof(uint64_t)) {
+            throw runtime_error("Truncated columnar file: " + filename);
+        }
+        column.valueCount = static_cast<size_t>(valueCount);
+        column.offsets = p;
+        p += (column.valueCount + 1) * sizeof(uint64_t);
+
+        // Offsets start at 0, never decrease and end at the data length
+        const uint64_t dataLength = readU64(column.offsets + column.valueCount * sizeof(uint64_t));
+        need(dataLength);
+        uint64_t previous = 0;
+        for (size_t i = 0; i <= column.valueCount; ++i) {
+            const uint64_t offset = readU64(column.offsets + i * sizeof(uint64_t));
+            if ((i == 0 && offset != 0) || offset < previous) {
+                throw corrupt("bad value offset in column " + to_string(column.columnIndex));
+            }
+            previous = offset;
+        }
+        column.data = p;
+        p += dataLength;
+    }
+}
@@ -0,0 +1,99 @@
+#ifndef COLUMNANALYZER_COLUMNARFILE_H
+#define COLUMNANALYZER_COLUMNARFILE_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "ColumnAnalyzer.h"
+
+/**
+ * Self-describing binary file with the unique values of each column
+ *
+ * Layout (little-endian):
+ *   char[8]  magic "PCACOL01"
+ *   uint32   column count
+ *   per column:
+ *     uint64   column index
+ *     uint32   name length, then name bytes
+ *     uint64   unique count
+ *     uint64   stored value count N (0 when values were not kept)
+ *     uint64   offsets[N + 1] into the data block (Arrow-style string array)
+ *     bytes    data block of offsets[N] bytes
+ *
+ * Values may contain any bytes, including ';', ',' and newlines.
+ */
+class ColumnarFileWriter {
+public:
+    /**
+     * Write unique values of all columns
+     * Value bytes go straight from the result sets to the file (writev),
+     * without an intermediate concatenated buffer
+     * @param results Analysis results
+     * @param filename Output file path
+     * @param sortThreads Write each column's values in ascending byte order,
+     *                    sorted with this many threads (0 = set iteration order)
+     */
+    static void write(const std::vector<ColumnResult>& results, const std::string& filename,
+                      size_t sortThreads = 0);
+};
+
+/**
+ * Loader for files written by ColumnarFileWriter
+ * The file is memory-mapped; values are views into the mapping
+ */
+class ColumnarFileReader {
+public:
+    struct Column {
+        uint64_t columnIndex = 0;
+        std::string name;
+        uint64_t uniqueCount = 0;
+
+        [[nodiscard]] size_t size() const { return valueCount; }
+
+        /**
+         * Value at position i (valid while the reader is alive)
+         */
+        [[nodiscard]] std::string_view value(size_t i) const;
+
+    private:
+        friend class ColumnarFileReader;
+        size_t valueCount = 0;
+        const char* offsets = nullptr;  // Unaligned uint64 array
+        const char* data = nullptr;
+    };
+
+    /**
+     * Map and validate a file
+     * Counts, lengths and every value offset are checked against the
+     * mapping, so corrupt or foreign files fail here instead of producing
+     * views outside it
+     * @param filename Path to file
+     * @throws std::runtime_error if the file cannot be mapped or is malformed
+     */
+    explicit ColumnarFileReader(const std::string& filename);
+
+    ColumnarFileReader(const ColumnarFileReader&) = delete;
+    ColumnarFileReader& operator=(const ColumnarFileReader&) = delete;
+
+    [[nodiscard]] const std::vector<Column>& columns() const { return columns_; }
+
+private:
+    /**
+     * Read-only mapping, unmapped on destruction (also when parsing throws)
+     */
+    struct Mapping {
+        void* data = nullptr;
+        size_t size = 0;
+
+        Mapping() = default;
+        ~Mapping();
+        Mapping(const Mapping&) = delete;
+        Mapping& operator=(const Mapping&) = delete;
+    };
+
+    Mapping mapping_;
+    std::vector<Column> columns_;
+};
+
+#endif //COLUMNANALYZER_COLUMNARFILE_H
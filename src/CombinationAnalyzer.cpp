@@ -0,0 +1,188 @@
+#include "CombinationAnalyzer.h"
+#include "CancellationToken.h"
+#include "CellHash.h"
+#include "DistinctIndex.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+using namespace std;
+
+CombinationMode combinationModeFromString(const string& name) {
+    if (name == "exact") return CombinationMode::EXACT;
+    if (name == "hll") return CombinationMode::HLL;
+    throw invalid_argument("Unknown combination mode: " + name + ". Valid values: exact, hll");
+}
+
+namespace {
+
+    size_t resolveColumn(const string& token, const vector<string>& headers) {
+        auto it = find(headers.begin(), headers.end(), token);
+        if (it != headers.end()) {
+            return static_cast<size_t>(it - headers.begin());
+        }
+        if (!token.empty() && all_of(token.begin(), token.end(), [](unsigned char c) { return isdigit(c); })) {
+            size_t index = stoul(token);
+            if (index < headers.size()) {
+                return index;
+            }
+        }
+        throw invalid_argument("Unknown column in combination: '" + token + "'");
+    }
+
+    vector<string> split(const string& text, char separator) {
+        vector<string> parts;
+        size_t start = 0;
+        while (true) {
+            size_t end = text.find(separator, start);
+            parts.push_back(text.substr(start, end - start));
+            if (end == string::npos) break;
+            start = end + 1;
+        }
+        return parts;
+    }
+
+    // Order-sensitive fold of cell hashes into a row key
+    inline uint64_t combine(uint64_t key, uint64_t cellHash) {
+        return CellHash::detail::mix(key ^ cellHash, CellHash::detail::kSecret1);
+    }
+
+} // namespace
+
+vector<ColumnGroup> parseColumnGroups(const string& spec, const vector<string>& headers) {
+    vector<ColumnGroup> groups;
+    for (const auto& groupSpec : split(spec, ',')) {
+        ColumnGroup group;
+        for (const auto& token : split(groupSpec, '+')) {
+            if (token.empty()) {
+                throw invalid_argument("Empty column in combination: '" + groupSpec + "'");
+            }
+            group.push_back(resolveColumn(token, headers));
+        }
+        groups.push_back(std::move(group));
+    }
+    return groups;
+}
+
+void CombinationAnalyzer::rowKeys(const vector<vector<string>>& columns,
+                                  const vector<vector<uint64_t>>* cellHashes,
+                                  const ColumnGroup& group,
+                                  size_t firstRow, size_t count,
+                                  uint64_t* keys) {
+    fill(keys, keys + count, CellHash::detail::kSecret0 ^ group.size());
+
+    // Column at a time: each pass streams one column of the block
+    for (size_t column : group) {
+        if (cellHashes != nullptr) {
+            const uint64_t* hashes = (*cellHashes)[column].data() + firstRow;
+            for (size_t i = 0; i < count; ++i) {
+                keys[i] = combine(keys[i], hashes[i]);
+            }
+        } else {
+            const string* cells = columns[column].data() + firstRow;
+            for (size_t i = 0; i < count; ++i) {
+                keys[i] = combine(keys[i], CellHash::hash(cells[i]));
+            }
+        }
+    }
+}
+
+void CombinationAnalyzer::scatterKeys(const uint64_t* keys, size_t firstRow, size_t count,
+                                      KeyPartition* partitions, size_t partitionCount) {
+    for (size_t i = 0; i < count; ++i) {
+        partitions[partitionOf(keys[i], partitionCount)].push_back(
+                {static_cast<uint32_t>(keys[i]), static_cast<uint32_t>(firstRow + i)});
+    }
+}
+
+size_t CombinationAnalyzer::countPartition(const vector<vector<string>>& columns,
+                                           const ColumnGroup& group,
+                                           const vector<const KeyPartition*>& parts) {
+    size_t keyCount = 0;
+    for (const KeyPartition* part : parts) {
+        keyCount += part->size();
+    }
+    DistinctIndex index(keyCount / 4);
+
+    auto sameTuple = [&columns, &group](size_t a, size_t b) {
+        for (size_t column : group) {
+            if (columns[column][a] != columns[column][b]) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    for (const KeyPartition* part : parts) {
+        for (size_t start = 0; start < part->size(); start += kBlockRows) {
+            CancellationToken::throwIfCancelled();
+            const size_t end = min(start + kBlockRows, part->size());
+            for (size_t i = start; i < end; ++i) {
+                const size_t row = (*part)[i].row;
+                index.insert((*part)[i].key, row, [&](size_t other) { return sameTuple(other, row); });
+            }
+        }
+    }
+    return index.size();
+}
+
+CombinationResult CombinationAnalyzer::analyze(const vector<vector<string>>& columns,
+                                               const vector<vector<uint64_t>>* cellHashes,
+                                               const ColumnGroup& group,
+                                               CombinationMode mode) {
+    CombinationResult result;
+    result.columns = group;
+    result.mode = mode;
+    result.rowCount = validate(columns, {group});
+
+    if (mode == CombinationMode::HLL) {
+        HyperLogLog sketch(kHllPrecision);
+        vector<uint64_t> keys(kBlockRows);
+        for (size_t start = 0; start < result.rowCount; start += kBlockRows) {
+            CancellationToken::throwIfCancelled();
+            const size_t count = min(kBlockRows, result.rowCount - start);
+            rowKeys(columns, cellHashes, group, start, count, keys.data());
+            for (size_t i = 0; i < count; ++i) {
+                sketch.add(keys[i]);
+            }
+        }
+        result.distinctCount = static_cast<size_t>(llround(sketch.estimate()));
+        result.relativeError = sketch.relativeError();
+        return result;
+    }
+
+    KeyPartition all;
+    all.reserve(result.rowCount);
+    vector<uint64_t> keys(kBlockRows);
+    for (size_t start = 0; start < result.rowCount; start += kBlockRows) {
+        const size_t count = min(kBlockRows, result.rowCount - start);
+        rowKeys(columns, cellHashes, group, start, count, keys.data());
+        scatterKeys(keys.data(), start, count, &all, 1);
+    }
+    result.distinctCount = countPartition(columns, group, {&all});
+    return result;
+}
+
+size_t CombinationAnalyzer::validate(const vector<vector<string>>& columns,
+                                     const vector<ColumnGroup>& groups) {
+    const size_t rows = columns.empty() ? 0 : columns[0].size();
+    if (rows > numeric_limits<uint32_t>::max()) {
+        throw invalid_argument("Too many rows for combination counting: " + to_string(rows));
+    }
+    for (const auto& group : groups) {
+        if (group.empty()) {
+            throw invalid_argument("Empty column group");
+        }
+        for (size_t column : group) {
+            if (column >= columns.size()) {
+                throw invalid_argument("Column " + to_string(column) + " out of range in combination");
+            }
+            if (columns[column].size() != rows) {
+                throw invalid_argument("Columns of a combination differ in length");
+            }
+        }
+    }
+    return rows;
+}
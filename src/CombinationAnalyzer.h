@@ -0,0 +1,152 @@
+#ifndef COLUMNANALYZER_COMBINATIONANALYZER_H
+#define COLUMNANALYZER_COMBINATIONANALYZER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "HyperLogLog.h"
+
+/**
+ * How distinct tuples of a column group are counted
+ */
+enum class CombinationMode {
+    EXACT,  // Hash index over row keys, tuples compared on key match
+    HLL     // HyperLogLog sketch of row keys (0.81% relative error)
+};
+
+/**
+ * Parse a combination mode name
+ * @param name "exact" or "hll"
+ * @throws std::invalid_argument on unknown names
+ */
+CombinationMode combinationModeFromString(const std::string& name);
+
+/**
+ * Column indices whose values together form one tuple
+ */
+using ColumnGroup = std::vector<size_t>;
+
+/**
+ * Parse column groups: groups separated by ',', columns within a group by '+'
+ * ("0+1,city+zip"). A column is a header name or a zero-based index.
+ * @param spec Group specification
+ * @param headers Column names of the table
+ * @throws std::invalid_argument on unknown columns or empty groups
+ */
+std::vector<ColumnGroup> parseColumnGroups(const std::string& spec,
+                                           const std::vector<std::string>& headers);
+
+/**
+ * Distinct tuple count of one column group
+ */
+struct CombinationResult {
+    ColumnGroup columns;
+    size_t rowCount = 0;
+    size_t distinctCount = 0;
+    CombinationMode mode = CombinationMode::EXACT;
+    double relativeError = 0.0;  // Standard error of an HLL estimate
+    bool complete = true;        // False if the run was cancelled first
+
+    /**
+     * Every row has its own tuple, so the group is a candidate key
+     */
+    [[nodiscard]] bool isUnique() const {
+        return mode == CombinationMode::EXACT && complete && distinctCount == rowCount;
+    }
+};
+
+/**
+ * Row key within its key partition: the high word picked the partition, the
+ * low word is indexed; tuples are compared whenever low words match
+ */
+struct PartitionedKey {
+    uint32_t key;
+    uint32_t row;
+};
+
+/**
+ * Keys of one key partition, in row order
+ */
+using KeyPartition = std::vector<PartitionedKey>;
+
+/**
+ * Distinct counts of column combinations
+ *
+ * A row's key for a group combines the cell hashes of its columns in
+ * group order. Keys are produced block by block for all groups at once,
+ * so one pass over the rows serves every group. EXACT counting scatters
+ * the keys into partitions of the key space in that pass and indexes each
+ * partition independently; HLL counting feeds the keys straight into a
+ * sketch.
+ */
+class CombinationAnalyzer {
+public:
+    static constexpr size_t kBlockRows = 4096;   // Rows per key block
+    static constexpr unsigned kHllPrecision = 14;
+
+    /**
+     * Row keys of a block of rows
+     * @param columns Table columns
+     * @param cellHashes Per-cell hashes from the reader (nullptr = hash here)
+     * @param group Columns of the tuple
+     * @param firstRow First row of the block
+     * @param count Rows in the block
+     * @param keys Output, count entries
+     */
+    static void rowKeys(const std::vector<std::vector<std::string>>& columns,
+                        const std::vector<std::vector<uint64_t>>* cellHashes,
+                        const ColumnGroup& group,
+                        size_t firstRow, size_t count,
+                        uint64_t* keys);
+
+    /**
+     * Append a block of row keys to the partitions they belong to
+     * @param keys Row keys, count entries
+     * @param firstRow Row of keys[0]
+     * @param count Keys in the block
+     * @param partitions Output, partitionCount buffers
+     * @param partitionCount Number of partitions the key space is split into
+     */
+    static void scatterKeys(const uint64_t* keys, size_t firstRow, size_t count,
+                            KeyPartition* partitions, size_t partitionCount);
+
+    /**
+     * Exact distinct tuples among the rows of one key partition
+     * @param columns Table columns
+     * @param group Columns of the tuple
+     * @param parts Buffers of the partition (e.g. one per stripe of rows)
+     */
+    static size_t countPartition(const std::vector<std::vector<std::string>>& columns,
+                                 const ColumnGroup& group,
+                                 const std::vector<const KeyPartition*>& parts);
+
+    /**
+     * Partition a row key belongs to (independent of the index slot bits)
+     */
+    static size_t partitionOf(uint64_t key, size_t partitions) {
+        return static_cast<size_t>(key >> 32) % partitions;
+    }
+
+    /**
+     * Count one group on the calling thread
+     * @param columns Table columns
+     * @param cellHashes Per-cell hashes from the reader (nullptr = hash here)
+     * @param group Columns of the tuple
+     * @param mode Exact or HLL
+     */
+    static CombinationResult analyze(const std::vector<std::vector<std::string>>& columns,
+                                     const std::vector<std::vector<uint64_t>>* cellHashes,
+                                     const ColumnGroup& group,
+                                     CombinationMode mode);
+
+    /**
+     * Check that every column of every group exists and columns have equal
+     * length, with few enough rows for 32-bit row numbers in KeyPartition
+     * @return Number of rows
+     * @throws std::invalid_argument otherwise
+     */
+    static size_t validate(const std::vector<std::vector<std::string>>& columns,
+                           const std::vector<ColumnGroup>& groups);
+};
+
+#endif //COLUMNANALYZER_COMBINATIONANALYZER_H
@@ -0,0 +1,63 @@
+#ifndef COLUMNANALYZER_CONSOLE_H
+#define COLUMNANALYZER_CONSOLE_H
+
+#include <iostream>
+
+/**
+ * Console output of the analysis pipeline (reader, processor, merger)
+ * Embedding callers silence it for their thread with a QuietScope
+ */
+namespace Console {
+
+    namespace detail {
+        inline thread_local bool quiet = false;
+
+        // No buffer: badbit is set, so formatted output is skipped
+        inline std::ostream& discard() {
+            static thread_local std::ostream stream(nullptr);
+            return stream;
+        }
+    }
+
+    /**
+     * Progress and summary messages (std::cout unless quiet)
+     */
+    inline std::ostream& out() {
+        return detail::quiet ? detail::discard() : std::cout;
+    }
+
+    /**
+     * Warnings (std::cerr unless quiet)
+     */
+    inline std::ostream& err() {
+        return detail::quiet ? detail::discard() : std::cerr;
+    }
+
+    /**
+     * Output of this thread is silenced (threads started by the pipeline
+     * take over their caller's setting)
+     */
+    inline bool quiet() {
+        return detail::quiet;
+    }
+
+    /**
+     * Silences out() and err() on this thread while alive
+     */
+    class QuietScope {
+    public:
+        explicit QuietScope(bool quiet = true) : previous_(detail::quiet) {
+            detail::quiet = quiet;
+        }
+        ~QuietScope() { detail::quiet = previous_; }
+
+        QuietScope(const QuietScope&) = delete;
+        QuietScope& operator=(const QuietScope&) = delete;
+
+    private:
+        bool previous_;
+    };
+
+} // namespace Console
+
+#endif //COLUMNANALYZER_CONSOLE_H
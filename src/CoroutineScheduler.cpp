@@ -0,0 +1,135 @@
+#include "CoroutineScheduler.h"
+#include <chrono>
+
+using namespace std;
+using namespace chrono;
+
+namespace {
+
+    thread_local size_t currentWorker_ = CoroutineScheduler::kNotWorker;
+
+} // namespace
+
+CoroutineScheduler::CoroutineScheduler(size_t numThreads) {
+    if (numThreads == 0) {
+        numThreads = thread::hardware_concurrency();
+        if (numThreads == 0) {
+            numThreads = 8;  // Fallback
+        }
+    }
+
+    idle_.assign(numThreads, 0.0);
+    workers_.reserve(numThreads);
+    for (size_t i = 0; i < numThreads; ++i) {
+        workers_.emplace_back([this, i]() { workerLoop(i); });
+    }
+}
+
+CoroutineScheduler::~CoroutineScheduler() {
+    {
+        unique_lock<mutex> lock(mutex_);
+        doneCv_.wait(lock, [this]() { return running_ == 0; });
+        stopping_ = true;
+    }
+    readyCv_.notify_all();
+
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+void CoroutineScheduler::spawn(Task task) {
+    auto handle = task.handle_;
+    task.handle_ = nullptr;
+    handle.promise().scheduler = this;
+    {
+        lock_guard<mutex> lock(mutex_);
+        ++running_;
+        ready_.push_back(handle);
+    }
+    readyCv_.notify_one();
+}
+
+void CoroutineScheduler::post(coroutine_handle<> handle) {
+    {
+        lock_guard<mutex> lock(mutex_);
+        ready_.push_back(handle);
+    }
+    readyCv_.notify_one();
+}
+
+void CoroutineScheduler::wait() {
+    unique_lock<mutex> lock(mutex_);
+    doneCv_.wait(lock, [this]() { return running_ == 0; });
+    if (failure_) {
+        exception_ptr failure = failure_;
+        failure_ = nullptr;
+        rethrow_exception(failure);
+    }
+}
+
+size_t CoroutineScheduler::currentWorker() {
+    return currentWorker_;
+}
+
+double CoroutineScheduler::idleSeconds() const {
+    lock_guard<mutex> lock(mutex_);
+    double total = 0.0;
+    for (double seconds : idle_) {
+        total += seconds;
+    }
+    return total;
+}
+
+void CoroutineScheduler::finished() {
+    lock_guard<mutex> lock(mutex_);
+    if (--running_ == 0) {
+        doneCv_.notify_all();
+    }
+}
+
+void CoroutineScheduler::fail(exception_ptr error) {
+    lock_guard<mutex> lock(mutex_);
+    if (!failure_) {
+        failure_ = error;
+    }
+}
+
+void CoroutineScheduler::workerLoop(size_t index) {
+    currentWorker_ = index;
+    while (true) {
+        coroutine_handle<> handle;
+        {
+            unique_lock<mutex> lock(mutex_);
+            if (ready_.empty() && !stopping_) {
+                auto start = steady_clock::now();
+                readyCv_.wait(lock, [this]() { return stopping_ || !ready_.empty(); });
+                idle_[index] += duration<double>(steady_clock::now() - start).count();
+            }
+
+            if (ready_.empty()) {
+                return;  // Stopping and drained
+            }
+
+            handle = ready_.front();
+            ready_.pop_front();
+        }
+        handle.resume();
+    }
+}
+
+void Sequencer::advance() {
+    coroutine_handle<> next;
+    {
+        lock_guard<mutex> lock(mutex_);
+        ++next_;
+        auto it = waiting_.find(next_);
+        if (it != waiting_.end()) {
+            next = it->second;
+            waiting_.erase(it);
+        }
+    }
+    if (next) {
+        scheduler_.post(next);
+    }
+}
@@ -0,0 +1,209 @@
+#ifndef COLUMNANALYZER_COROUTINESCHEDULER_H
+#define COLUMNANALYZER_COROUTINESCHEDULER_H
+
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class CoroutineScheduler;
+
+/**
+ * Detached coroutine run by a CoroutineScheduler
+ *
+ * Created suspended; CoroutineScheduler::spawn queues its first step and
+ * the frame is freed as soon as the body finishes. An exception leaving
+ * the body is rethrown by CoroutineScheduler::wait.
+ */
+class Task {
+public:
+    struct promise_type {
+        CoroutineScheduler* scheduler = nullptr;
+
+        Task get_return_object() {
+            return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        auto final_suspend() noexcept;
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept;
+    };
+
+    Task(Task&& other) noexcept : handle_(other.handle_) { other.handle_ = nullptr; }
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+    Task& operator=(Task&&) = delete;
+
+    /**
+     * Frees the frame of a task that was never spawned
+     */
+    ~Task() {
+        if (handle_) {
+            handle_.destroy();
+        }
+    }
+
+private:
+    friend class CoroutineScheduler;
+
+    explicit Task(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+
+    std::coroutine_handle<promise_type> handle_;
+};
+
+/**
+ * Fixed set of worker threads resuming coroutines from one FIFO
+ *
+ * A suspended coroutine holds no thread, so stages that wait on each
+ * other (see Sequencer) never tie up a worker, and no more than size()
+ * coroutine steps run at once.
+ */
+class CoroutineScheduler {
+public:
+    static constexpr size_t kNotWorker = static_cast<size_t>(-1);
+
+    /**
+     * Constructor
+     * @param numThreads Number of workers (0 = hardware concurrency)
+     */
+    explicit CoroutineScheduler(size_t numThreads = 0);
+
+    /**
+     * Waits for spawned tasks, then joins workers
+     */
+    ~CoroutineScheduler();
+
+    CoroutineScheduler(const CoroutineScheduler&) = delete;
+    CoroutineScheduler& operator=(const CoroutineScheduler&) = delete;
+
+    /**
+     * Queue the first step of a task; callable from any thread
+     */
+    void spawn(Task task);
+
+    /**
+     * Awaitable that continues the awaiting coroutine on a worker
+     */
+    auto schedule() {
+        struct Awaiter {
+            CoroutineScheduler& scheduler;
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> handle) { scheduler.post(handle); }
+            void await_resume() const noexcept {}
+        };
+        return Awaiter{*this};
+    }
+
+    /**
+     * Block until every spawned task has finished
+     * @throws The first exception that left a task body
+     */
+    void wait();
+
+    /**
+     * Queue a suspended coroutine to be resumed by a worker
+     */
+    void post(std::coroutine_handle<> handle);
+
+    /**
+     * Index of the calling worker (0 .. size()-1), kNotWorker elsewhere
+     */
+    static size_t currentWorker();
+
+    /**
+     * Number of worker threads
+     */
+    [[nodiscard]] size_t size() const { return workers_.size(); }
+
+    /**
+     * Seconds workers spent waiting for a coroutine to resume, summed
+     */
+    [[nodiscard]] double idleSeconds() const;
+
+private:
+    friend struct Task::promise_type;
+
+    std::vector<std::thread> workers_;
+    std::deque<std::coroutine_handle<>> ready_;
+    size_t running_ = 0;      // Spawned tasks not yet finished
+    std::exception_ptr failure_;
+    std::vector<double> idle_;
+    bool stopping_ = false;
+    mutable std::mutex mutex_;
+    std::condition_variable readyCv_;
+    std::condition_variable doneCv_;
+
+    void finished();
+    void fail(std::exception_ptr error);
+    void workerLoop(size_t index);
+};
+
+inline auto Task::promise_type::final_suspend() noexcept {
+    // Free the frame before reporting, so wait() never returns while a
+    // finished task's parameters are still alive
+    struct Awaiter {
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<promise_type> handle) noexcept {
+            CoroutineScheduler* scheduler = handle.promise().scheduler;
+            handle.destroy();
+            scheduler->finished();
+        }
+        void await_resume() const noexcept {}
+    };
+    return Awaiter{};
+}
+
+inline void Task::promise_type::unhandled_exception() noexcept {
+    scheduler->fail(std::current_exception());
+}
+
+/**
+ * Hands out turns in ticket order to coroutines of one scheduler
+ *
+ * A coroutine awaiting turn(n) stays suspended, holding no thread, until
+ * advance() has been called n times; it is then resumed on a worker. Every
+ * ticket must be advanced past exactly once, or later turns never come.
+ */
+class Sequencer {
+public:
+    explicit Sequencer(CoroutineScheduler& scheduler) : scheduler_(scheduler) {}
+
+    /**
+     * Awaitable that resumes once ticket is the current turn
+     */
+    auto turn(size_t ticket) {
+        struct Awaiter {
+            Sequencer& sequencer;
+            size_t ticket;
+            bool await_ready() const noexcept { return false; }
+            bool await_suspend(std::coroutine_handle<> handle) {
+                std::lock_guard<std::mutex> lock(sequencer.mutex_);
+                if (ticket == sequencer.next_) {
+                    return false;  // Already our turn: continue on this thread
+                }
+                sequencer.waiting_.emplace(ticket, handle);
+                return true;
+            }
+            void await_resume() const noexcept {}
+        };
+        return Awaiter{*this, ticket};
+    }
+
+    /**
+     * End the current turn and wake the holder of the next ticket
+     */
+    void advance();
+
+private:
+    CoroutineScheduler& scheduler_;
+    std::mutex mutex_;
+    size_t next_ = 0;
+    std::map<size_t, std::coroutine_handle<>> waiting_;
+};
+
+#endif //COLUMNANALYZER_COROUTINESCHEDULER_H
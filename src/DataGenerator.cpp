@@ -1,4 +1,5 @@
 #include "DataGenerator.h"
+#include "ProgressReporter.h"
 #include <fstream>
 #include <iostream>
 #include <sstream>
@@ -25,6 +26,7 @@ void DataGenerator::generateCSV(const string& filename,
     file << "\n";
 
     // Data
+    auto& progress = ProgressReporter::counters();
     for (size_t row = 0; row < rows; ++row) {
         for (size_t col = 0; col < cols; ++col) {
             file << generateValue(col);
@@ -32,10 +34,11 @@ void DataGenerator::generateCSV(const string& filename,
         }
         file << "\n";
 
-        if ((row + 1) % 1000 == 0) {
-            cout << "Generated " << (row + 1) << " / " << rows << " rows..." << endl;
+        if ((row + 1) % 1024 == 0) {
+            progress.addRows(1024);
         }
     }
+    progress.addRows(rows % 1024);
 
     file.close();
     cout << "CSV generation completed: " << filename << endl;
@@ -66,7 +69,7 @@ string DataGenerator::generateValue(size_t colIndex) {
         case 3: {
             // Char
             char c = 'A' + (value % 26);
-            return {1, c};
+            return string(1, c);
         }
         default:
             return to_string(value);
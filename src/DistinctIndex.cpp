@@ -0,0 +1,33 @@
+#include "DistinctIndex.h"
+
+using namespace std;
+
+DistinctIndex::DistinctIndex(size_t expectedDistinct, pmr::memory_resource* resource)
+    : slots_(resource), rows_(resource) {
+    size_t capacity = 16;
+    while (capacity * 3 < expectedDistinct * 4) {
+        capacity <<= 1;
+    }
+
+    slots_.assign(capacity, Slot{0, kEmpty});
+    mask_ = capacity - 1;
+    rows_.reserve(expectedDistinct);
+}
+
+void DistinctIndex::grow() {
+    pmr::vector<Slot> old(slots_.size() * 2, Slot{0, kEmpty}, slots_.get_allocator());
+    old.swap(slots_);
+    mask_ = slots_.size() - 1;
+
+    for (const auto& slot : old) {
+        if (slot.row == kEmpty) {
+            continue;
+        }
+
+        size_t pos = slot.hash & mask_;
+        while (slots_[pos].row != kEmpty) {
+            pos = (pos + 1) & mask_;
+        }
+        slots_[pos] = slot;
+    }
+}
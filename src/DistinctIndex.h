@@ -0,0 +1,118 @@
+#ifndef COLUMNANALYZER_DISTINCTINDEX_H
+#define COLUMNANALYZER_DISTINCTINDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+/**
+ * Open-addressing hash index over precomputed cell hashes
+ * Stores (hash, row) pairs; full values are compared only when hashes match
+ */
+class DistinctIndex {
+public:
+    /**
+     * Constructor
+     * @param expectedDistinct Capacity hint
+     * @param resource Memory for slots and rows (e.g. the worker's WorkerArena)
+     */
+    explicit DistinctIndex(size_t expectedDistinct = 0,
+                           std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    /**
+     * Insert a row by its precomputed hash
+     * @param hash Hash of the row's value
+     * @param row Row index
+     * @param equalsRow Callable(existingRow) -> true if values are equal
+     * @return true if the value was not seen before
+     */
+    template <typename EqualsRow>
+    bool insert(uint64_t hash, size_t row, EqualsRow&& equalsRow) {
+        if ((rows_.size() + 1) * 4 > slots_.size() * 3) {
+            grow();
+        }
+        return probe(hash, row, equalsRow);
+    }
+
+    /**
+     * Insert a block of consecutive rows
+     * Prefetches every bucket first so the cache misses overlap, then probes
+     * @param hashes Hashes of rows firstRow .. firstRow + count - 1
+     * @param firstRow Row index of hashes[0]
+     * @param count Number of rows in the block
+     * @param equalsRows Callable(existingRow, row) -> true if values are equal
+     * @return Number of newly inserted values
+     */
+    template <typename EqualsRows>
+    size_t insertBatch(const uint64_t* hashes, size_t firstRow, size_t count,
+                       EqualsRows&& equalsRows) {
+        // Grow up front: the prefetched buckets must stay valid during probing
+        while ((rows_.size() + count) * 4 > slots_.size() * 3) {
+            grow();
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            __builtin_prefetch(&slots_[hashes[i] & mask_], 1);
+        }
+
+        size_t inserted = 0;
+        for (size_t i = 0; i < count; ++i) {
+            const size_t row = firstRow + i;
+            inserted += probe(hashes[i], row, [&](size_t other) {
+                return equalsRows(other, row);
+            });
+        }
+        return inserted;
+    }
+
+    /**
+     * Number of distinct values
+     */
+    [[nodiscard]] size_t size() const { return rows_.size(); }
+
+    /**
+     * First-occurrence row of each distinct value, in insertion order
+     */
+    [[nodiscard]] const std::pmr::vector<size_t>& rows() const { return rows_; }
+
+private:
+    struct Slot {
+        uint64_t hash;
+        size_t row;
+    };
+
+    static constexpr size_t kEmpty = static_cast<size_t>(-1);
+
+    std::pmr::vector<Slot> slots_;
+    std::pmr::vector<size_t> rows_;
+    size_t mask_ = 0;
+
+    /**
+     * Linear probing; assumes there is room for one more value
+     */
+    template <typename EqualsRow>
+    bool probe(uint64_t hash, size_t row, EqualsRow&& equalsRow) {
+        size_t pos = hash & mask_;
+        while (true) {
+            Slot& slot = slots_[pos];
+            if (slot.row == kEmpty) {
+                slot.hash = hash;
+                slot.row = row;
+                rows_.push_back(row);
+                return true;
+            }
+            if (slot.hash == hash && equalsRow(slot.row)) {
+                return false;
+            }
+            pos = (pos + 1) & mask_;
+        }
+    }
+
+    /**
+     * Double the slot array, reinserting by stored hash (no value rehashing)
+     */
+    void grow();
+};
+
+#endif //COLUMNANALYZER_DISTINCTINDEX_H
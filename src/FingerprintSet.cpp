@@ -0,0 +1,72 @@
+#include "FingerprintSet.h"
+#include "CellHash.h"
+#include "HugePageResource.h"
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+using namespace std;
+
+namespace {
+    constexpr uint64_t kHighSeed = 0x2d358dccaa6c78a5ull;
+    constexpr size_t kInitialCapacity = 16;
+}
+
+FingerprintSet::FingerprintSet(unsigned bits)
+    : bits_(bits), words_(bits / 64), slots_(&HugePageResource::instance()) {
+    if (bits != 0 && bits != 64 && bits != 128) {
+        throw invalid_argument("Unsupported fingerprint width: " + to_string(bits) +
+                               ". Valid values: 64, 128");
+    }
+}
+
+uint64_t FingerprintSet::highHash(string_view value) {
+    return CellHash::hashBytes(value.data(), value.size(), kHighSeed);
+}
+
+void FingerprintSet::merge(const FingerprintSet& other) {
+    if (other.empty()) {
+        return;
+    }
+    if (other.bits_ != bits_) {
+        throw invalid_argument("Cannot merge " + to_string(other.bits_) + "-bit fingerprints into " +
+                               to_string(bits_) + "-bit fingerprints");
+    }
+    while ((size_ + other.size_) * 4 > capacity() * 3) {
+        grow();
+    }
+    for (size_t pos = 0; pos < other.capacity(); ++pos) {
+        const uint64_t* slot = &other.slots_[pos * words_];
+        if (slot[0] != 0) {
+            probe(slot[0], words_ == 2 ? slot[1] : 0);
+        }
+    }
+}
+
+double FingerprintSet::collisionProbability(size_t distinct, unsigned bits) {
+    if (distinct < 2 || bits == 0) {
+        return 0.0;
+    }
+    // 1 - exp(-n(n-1) / 2^(bits+1)), without losing small values to rounding
+    const double n = static_cast<double>(distinct);
+    const double pairs = n * (n - 1.0) / 2.0;
+    return -expm1(-ldexp(pairs, -static_cast<int>(bits)));
+}
+
+void FingerprintSet::grow() {
+    if (words_ == 0) {
+        throw logic_error("Fingerprint set without a width");
+    }
+    const size_t newCapacity = capacity() == 0 ? kInitialCapacity : capacity() * 2;
+
+    pmr::vector<uint64_t> old(newCapacity * words_, 0, slots_.get_allocator());
+    old.swap(slots_);
+    mask_ = newCapacity - 1;
+    size_ = 0;
+
+    for (size_t i = 0; i < old.size(); i += words_) {
+        if (old[i] != 0) {
+            probe(old[i], words_ == 2 ? old[i + 1] : 0);
+        }
+    }
+}
@@ -0,0 +1,117 @@
+#ifndef COLUMNANALYZER_FINGERPRINTSET_H
+#define COLUMNANALYZER_FINGERPRINTSET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string_view>
+#include <vector>
+
+/**
+ * Flat open-addressing set of 64- or 128-bit value fingerprints
+ *
+ * Counts distinct values without keeping them: a slot is one or two
+ * uint64 words (8 or 16 bytes per slot at most 75% full), whatever the
+ * length of the values. Two different values with the same fingerprint
+ * are counted once; collisionProbability() bounds how likely that is, and
+ * the fingerprint backend can verify against the original bytes.
+ * The low word is CellHash::hash of the value, so reader hashes
+ * (--hash-once) are reused; the high word is a second, seeded hash.
+ * Slots come from HugePageResource::instance(), which is thread-safe, so
+ * a set can be moved between threads and results.
+ */
+class FingerprintSet {
+public:
+    /**
+     * Constructor
+     * @param bits 64 or 128 (0 = unused, the result holds values instead)
+     * @throws std::invalid_argument for other widths
+     */
+    explicit FingerprintSet(unsigned bits = 0);
+
+    /**
+     * Second 64 bits of a 128-bit fingerprint
+     */
+    static uint64_t highHash(std::string_view value);
+
+    /**
+     * Insert a fingerprint
+     * @param low CellHash::hash of the value
+     * @param high highHash of the value (ignored for 64-bit sets)
+     * @return true if the fingerprint was not in the set
+     */
+    bool insert(uint64_t low, uint64_t high = 0) {
+        if ((size_ + 1) * 4 > capacity() * 3) {
+            grow();
+        }
+        return probe(low, high);
+    }
+
+    /**
+     * Union in place
+     * @throws std::invalid_argument if the widths differ
+     */
+    void merge(const FingerprintSet& other);
+
+    [[nodiscard]] size_t size() const { return size_; }
+    [[nodiscard]] bool empty() const { return size_ == 0; }
+    [[nodiscard]] unsigned bits() const { return bits_; }
+
+    /**
+     * Bytes of slot storage
+     */
+    [[nodiscard]] size_t memoryBytes() const { return slots_.size() * sizeof(uint64_t); }
+
+    /**
+     * Probability that at least two of `distinct` values share a
+     * fingerprint of `bits` bits (birthday bound, uniform hashes)
+     */
+    static double collisionProbability(size_t distinct, unsigned bits);
+
+private:
+    // Low word 0 marks an empty slot; a value hashing to 0 is stored as this
+    static constexpr uint64_t kZeroLow = 0x9e3779b97f4a7c15ull;
+
+    unsigned bits_;
+    size_t words_;   // uint64 words per slot (1 or 2)
+    std::pmr::vector<uint64_t> slots_;
+    size_t mask_ = 0;
+    size_t size_ = 0;
+
+    [[nodiscard]] size_t capacity() const { return words_ == 0 ? 0 : slots_.size() / words_; }
+
+    /**
+     * Linear probing; assumes there is room for one more fingerprint
+     */
+    bool probe(uint64_t low, uint64_t high) {
+        if (low == 0) {
+            low = kZeroLow;
+        }
+        if (words_ == 1) {
+            high = 0;
+        }
+        size_t pos = low & mask_;
+        while (true) {
+            uint64_t* slot = &slots_[pos * words_];
+            if (slot[0] == 0) {
+                slot[0] = low;
+                if (words_ == 2) {
+                    slot[1] = high;
+                }
+                ++size_;
+                return true;
+            }
+            if (slot[0] == low && (words_ == 1 || slot[1] == high)) {
+                return false;
+            }
+            pos = (pos + 1) & mask_;
+        }
+    }
+
+    /**
+     * Double the slot array and reinsert
+     */
+    void grow();
+};
+
+#endif //COLUMNANALYZER_FINGERPRINTSET_H
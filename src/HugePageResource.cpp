@@ -0,0 +1,129 @@
+#include "HugePageResource.h"
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+using namespace std;
+
+HugePageMode hugePageModeFromString(const string& name) {
+    if (name == "off") return HugePageMode::OFF;
+    if (name == "thp") return HugePageMode::TRANSPARENT;
+    if (name == "explicit") return HugePageMode::EXPLICIT;
+    throw invalid_argument("Unknown huge page mode: " + name + ". Valid values: off, thp, explicit");
+}
+
+HugePageResource::HugePageResource(HugePageMode mode, pmr::memory_resource* upstream)
+    : mode_(mode), upstream_(upstream) {}
+
+HugePageResource::~HugePageResource() {
+    for (const auto& [p, mapping] : mappings_) {
+        unmap(p, mapping.length);
+    }
+}
+
+HugePageResource& HugePageResource::instance() {
+    // Never destroyed: thread-local arenas may return blocks during exit
+    static auto* resource = new HugePageResource();
+    return *resource;
+}
+
+HugePageResource::Stats HugePageResource::stats() const {
+    lock_guard<mutex> lock(mutex_);
+    return stats_;
+}
+
+void* HugePageResource::do_allocate(size_t bytes, size_t alignment) {
+    const HugePageMode currentMode = mode();
+    if (currentMode == HugePageMode::OFF || bytes < kMinBytes || alignment > kHugePageSize) {
+        return upstream_->allocate(bytes, alignment);
+    }
+
+    const size_t length = (bytes + kHugePageSize - 1) & ~(kHugePageSize - 1);
+    bool hugeTlb = false;
+    void* p = map(length, currentMode, hugeTlb);
+
+    lock_guard<mutex> lock(mutex_);
+    if (p == nullptr) {
+        ++stats_.fallbacks;
+        return upstream_->allocate(bytes, alignment);
+    }
+    mappings_.emplace(p, Mapping{length, hugeTlb});
+    (hugeTlb ? stats_.explicitBytes : stats_.transparentBytes) += length;
+    return p;
+}
+
+void HugePageResource::do_deallocate(void* p, size_t bytes, size_t alignment) {
+    {
+        lock_guard<mutex> lock(mutex_);
+        auto it = mappings_.find(p);
+        if (it != mappings_.end()) {
+            const Mapping mapping = it->second;
+            mappings_.erase(it);
+            (mapping.hugeTlb ? stats_.explicitBytes : stats_.transparentBytes) -= mapping.length;
+            unmap(p, mapping.length);
+            return;
+        }
+    }
+    upstream_->deallocate(p, bytes, alignment);
+}
+
+bool HugePageResource::do_is_equal(const memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+#ifdef __linux__
+
+void* HugePageResource::map(size_t length, HugePageMode mode, bool& hugeTlb) {
+#ifdef MAP_HUGETLB
+    if (mode == HugePageMode::EXPLICIT) {
+        void* p = mmap(nullptr, length, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (p != MAP_FAILED) {
+            hugeTlb = true;
+            return p;
+        }
+        // Pool empty or not configured (vm.nr_hugepages): transparent pages instead
+    }
+#endif
+
+    // Over-map by one huge page and trim, so the block starts on a 2 MB boundary
+    const size_t padded = length + kHugePageSize;
+    void* raw = mmap(nullptr, padded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) {
+        return nullptr;
+    }
+    const auto start = reinterpret_cast<uintptr_t>(raw);
+    const uintptr_t aligned = (start + kHugePageSize - 1) & ~(uintptr_t{kHugePageSize} - 1);
+    if (aligned > start) {
+        munmap(raw, aligned - start);
+    }
+    const uintptr_t end = aligned + length;
+    if (start + padded > end) {
+        munmap(reinterpret_cast<void*>(end), start + padded - end);
+    }
+
+    auto* p = reinterpret_cast<void*>(aligned);
+#ifdef MADV_HUGEPAGE
+    // Advice only: a kernel with THP disabled still hands out 4 KB pages
+    madvise(p, length, MADV_HUGEPAGE);
+#endif
+    return p;
+}
+
+void HugePageResource::unmap(void* p, size_t length) {
+    munmap(p, length);
+}
+
+#else
+
+void* HugePageResource::map(size_t, HugePageMode, bool&) {
+    return nullptr;
+}
+
+void HugePageResource::unmap(void*, size_t) {}
+
+#endif
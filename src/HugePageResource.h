@@ -0,0 +1,103 @@
+#ifndef COLUMNANALYZER_HUGEPAGERESOURCE_H
+#define COLUMNANALYZER_HUGEPAGERESOURCE_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory_resource>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+/**
+ * Where large blocks get their pages
+ */
+enum class HugePageMode {
+    OFF,          // Ordinary heap memory
+    TRANSPARENT,  // 2 MB-aligned anonymous mapping with madvise(MADV_HUGEPAGE)
+    EXPLICIT      // MAP_HUGETLB from the reserved pool, else TRANSPARENT
+};
+
+/**
+ * Parse a --huge-pages value (off, thp, explicit)
+ * @throws std::invalid_argument for unknown names
+ */
+HugePageMode hugePageModeFromString(const std::string& name);
+
+/**
+ * Memory resource that backs large blocks with 2 MB pages
+ *
+ * Hash index slots of a high-cardinality column span gigabytes and every
+ * probe lands on a random 4 KB page; with 2 MB pages the same table needs
+ * 512 times fewer TLB entries. Blocks of at least kMinBytes are mapped
+ * directly (rounded up to whole huge pages); smaller blocks, and any block
+ * whose mapping fails, come from the upstream resource. Whether the kernel
+ * really backs a TRANSPARENT mapping with huge pages depends on
+ * /sys/kernel/mm/transparent_hugepage/enabled ("madvise" or "always").
+ * Thread-safe.
+ */
+class HugePageResource : public std::pmr::memory_resource {
+public:
+    static constexpr size_t kHugePageSize = size_t{2} << 20;
+    static constexpr size_t kMinBytes = kHugePageSize;
+
+    /**
+     * Bytes currently mapped, by kind, and blocks that fell back to upstream
+     */
+    struct Stats {
+        size_t transparentBytes = 0;
+        size_t explicitBytes = 0;
+        size_t fallbacks = 0;
+    };
+
+    /**
+     * Constructor
+     * @param mode Initial mode
+     * @param upstream Memory for small blocks and failed mappings
+     */
+    explicit HugePageResource(HugePageMode mode = HugePageMode::TRANSPARENT,
+                              std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+    ~HugePageResource() override;
+
+    HugePageResource(const HugePageResource&) = delete;
+    HugePageResource& operator=(const HugePageResource&) = delete;
+
+    /**
+     * Process-wide instance; upstream of every WorkerArena
+     */
+    static HugePageResource& instance();
+
+    /**
+     * Mode for later allocations; blocks already handed out keep their pages
+     */
+    void setMode(HugePageMode mode) { mode_.store(mode, std::memory_order_relaxed); }
+    [[nodiscard]] HugePageMode mode() const { return mode_.load(std::memory_order_relaxed); }
+
+    [[nodiscard]] Stats stats() const;
+
+private:
+    std::atomic<HugePageMode> mode_;
+    std::pmr::memory_resource* upstream_;
+
+    struct Mapping {
+        size_t length;
+        bool hugeTlb;
+    };
+
+    mutable std::mutex mutex_;
+    std::unordered_map<void*, Mapping> mappings_;
+    Stats stats_;
+
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    /**
+     * Map `length` bytes (a multiple of kHugePageSize)
+     * @param hugeTlb Set when the block came from the MAP_HUGETLB pool
+     * @return nullptr if the mapping failed
+     */
+    static void* map(size_t length, HugePageMode mode, bool& hugeTlb);
+    static void unmap(void* p, size_t length);
+};
+
+#endif //COLUMNANALYZER_HUGEPAGERESOURCE_H
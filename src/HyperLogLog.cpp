@@ -0,0 +1,54 @@
+#include "HyperLogLog.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+using namespace std;
+
+HyperLogLog::HyperLogLog(unsigned precision)
+    : precision_(precision) {
+    if (precision_ < 4 || precision_ > 18) {
+        throw invalid_argument("HyperLogLog precision must be 4 to 18, got " + to_string(precision));
+    }
+    registers_.assign(size_t{1} << precision_, 0);
+}
+
+void HyperLogLog::merge(const HyperLogLog& other) {
+    if (other.precision_ != precision_) {
+        throw invalid_argument("Cannot merge HyperLogLog sketches of different precision");
+    }
+    for (size_t i = 0; i < registers_.size(); ++i) {
+        registers_[i] = max(registers_[i], other.registers_[i]);
+    }
+}
+
+double HyperLogLog::estimate() const {
+    const auto m = static_cast<double>(registers_.size());
+
+    double sum = 0.0;
+    size_t zeros = 0;
+    for (uint8_t rank : registers_) {
+        sum += ldexp(1.0, -rank);
+        zeros += rank == 0;
+    }
+
+    // Bias constant alpha_m for m >= 128 (Flajolet et al.)
+    double alpha;
+    switch (registers_.size()) {
+        case 16: alpha = 0.673; break;
+        case 32: alpha = 0.697; break;
+        case 64: alpha = 0.709; break;
+        default: alpha = 0.7213 / (1.0 + 1.079 / m); break;
+    }
+
+    const double raw = alpha * m * m / sum;
+    if (raw <= 2.5 * m && zeros > 0) {
+        return m * log(m / static_cast<double>(zeros));
+    }
+    return raw;
+}
+
+double HyperLogLog::relativeError() const {
+    return 1.04 / sqrt(static_cast<double>(registers_.size()));
+}
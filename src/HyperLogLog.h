@@ -0,0 +1,59 @@
+#ifndef COLUMNANALYZER_HYPERLOGLOG_H
+#define COLUMNANALYZER_HYPERLOGLOG_H
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * HyperLogLog cardinality sketch over 64-bit hashes
+ *
+ * 2^precision one-byte registers keep the largest leading-zero rank seen
+ * in their share of the hash space. The estimate has a relative standard
+ * error of 1.04 / sqrt(2^precision) (0.81% at the default 14); small
+ * cardinalities use linear counting over the empty registers. Sketches
+ * of the same precision merge by register-wise maximum.
+ */
+class HyperLogLog {
+public:
+    /**
+     * Constructor
+     * @param precision Index bits, 4 to 18
+     */
+    explicit HyperLogLog(unsigned precision = 14);
+
+    /**
+     * Record a value by its hash (hashes must be well mixed)
+     */
+    void add(uint64_t hash) {
+        const uint64_t index = hash >> (64 - precision_);
+        const uint64_t rest = (hash << precision_) | (uint64_t{1} << (precision_ - 1));
+        const auto rank = static_cast<uint8_t>(__builtin_clzll(rest) + 1);
+        if (rank > registers_[index]) {
+            registers_[index] = rank;
+        }
+    }
+
+    /**
+     * Union with another sketch of the same precision
+     * @throws std::invalid_argument if the precisions differ
+     */
+    void merge(const HyperLogLog& other);
+
+    /**
+     * Estimated number of distinct hashes added
+     */
+    [[nodiscard]] double estimate() const;
+
+    /**
+     * Relative standard error of estimate()
+     */
+    [[nodiscard]] double relativeError() const;
+
+    [[nodiscard]] unsigned precision() const { return precision_; }
+
+private:
+    unsigned precision_;
+    std::vector<uint8_t> registers_;
+};
+
+#endif //COLUMNANALYZER_HYPERLOGLOG_H
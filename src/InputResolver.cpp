@@ -0,0 +1,74 @@
+#include "InputResolver.h"
+#include <algorithm>
+#include <filesystem>
+#include <sstream>
+#include <stdexcept>
+#include <glob.h>
+
+using namespace std;
+namespace fs = std::filesystem;
+
+namespace {
+
+    bool hasGlobChars(const string& entry) {
+        return entry.find_first_of("*?[") != string::npos;
+    }
+
+    void addDirectory(const string& dir, vector<string>& files) {
+        for (const auto& entry : fs::directory_iterator(dir)) {
+            if (entry.is_regular_file() && entry.path().extension() == ".csv") {
+                files.push_back(entry.path().string());
+            }
+        }
+    }
+
+    void addGlob(const string& pattern, vector<string>& files) {
+        glob_t matches{};
+        int rc = glob(pattern.c_str(), 0, nullptr, &matches);
+        if (rc == 0) {
+            for (size_t i = 0; i < matches.gl_pathc; ++i) {
+                if (fs::is_regular_file(matches.gl_pathv[i])) {
+                    files.emplace_back(matches.gl_pathv[i]);
+                }
+            }
+        }
+        globfree(&matches);
+
+        if (rc != 0 && rc != GLOB_NOMATCH) {
+            throw runtime_error("Failed to expand pattern: " + pattern);
+        }
+    }
+
+} // namespace
+
+vector<string> InputResolver::resolve(const string& spec) {
+    vector<string> files;
+    stringstream ss(spec);
+    string entry;
+
+    while (getline(ss, entry, ',')) {
+        if (entry.empty()) {
+            continue;
+        }
+        if (hasGlobChars(entry)) {
+            addGlob(entry, files);
+        } else if (fs::is_directory(entry)) {
+            addDirectory(entry, files);
+        } else {
+            files.push_back(entry);  // Missing files are reported by the reader
+        }
+    }
+
+    sort(files.begin(), files.end());
+    files.erase(unique(files.begin(), files.end()), files.end());
+
+    if (files.empty()) {
+        throw runtime_error("No input files match: " + spec);
+    }
+
+    return files;
+}
+
+bool InputResolver::isMultiInput(const string& spec) {
+    return spec.find(',') != string::npos || hasGlobChars(spec) || fs::is_directory(spec);
+}
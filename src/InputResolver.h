@@ -0,0 +1,29 @@
+#ifndef COLUMNANALYZER_INPUTRESOLVER_H
+#define COLUMNANALYZER_INPUTRESOLVER_H
+
+#include <string>
+#include <vector>
+
+/**
+ * Expands --input specifications into a list of CSV files
+ */
+class InputResolver {
+public:
+    /**
+     * Resolve an input specification
+     * Accepts comma-separated entries, each a file, a directory (all *.csv
+     * files inside) or a glob pattern ("shards/part-*.csv")
+     * @param spec Input specification
+     * @return Sorted, de-duplicated list of files
+     */
+    static std::vector<std::string> resolve(const std::string& spec);
+
+    /**
+     * Check whether a specification may expand to more than one file
+     * @param spec Input specification
+     * @return true for lists, directories and glob patterns
+     */
+    static bool isMultiInput(const std::string& spec);
+};
+
+#endif //COLUMNANALYZER_INPUTRESOLVER_H
@@ -0,0 +1,148 @@
+#include "MultiFileAnalyzer.h"
+#include "CSVReader.h"
+#include "CancellationToken.h"
+#include "Console.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <numeric>
+
+using namespace std;
+namespace fs = std::filesystem;
+
+MultiFileAnalyzer::MultiFileAnalyzer(size_t numThreads, AnalyzerOptions options)
+    : numThreads_(numThreads), options_(options) {}
+
+vector<ColumnResult> MultiFileAnalyzer::analyze(const vector<string>& files) const {
+    Console::out() << "Analyzing " << files.size() << " files with " << numThreads_ << " threads" << endl;
+
+    // Largest shards first (LPT): long tasks start early, small ones fill the gaps
+    vector<size_t> order(files.size());
+    iota(order.begin(), order.end(), 0);
+    vector<uintmax_t> sizes(files.size(), 0);
+    for (size_t i = 0; i < files.size(); ++i) {
+        error_code ec;
+        sizes[i] = fs::file_size(files[i], ec);
+    }
+    stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return sizes[a] > sizes[b];
+    });
+
+    struct Part {
+        size_t file;
+        size_t position;
+        string name;
+        future<ColumnResult> result;
+    };
+
+    // Pool threads do not inherit the caller's token: every task enters it
+    const CancellationToken* token = CancellationToken::current();
+    auto cancelled = [token]() { return token != nullptr && token->isCancelled(); };
+    atomic<bool> shardMissing{false};  // A cancelled read leaves every column short
+
+    mutex partsMutex;
+    vector<Part> parts;
+    ThreadPool pool(numThreads_);  // Declared last: joins before parts go away
+
+    vector<future<void>> reads;
+    reads.reserve(files.size());
+    for (size_t fileIndex : order) {
+        reads.push_back(pool.submit([&, fileIndex]() {
+            CancellationToken::Scope scope(token);
+            shared_ptr<const CSVTable> table;
+            try {
+                CancellationToken::throwIfCancelled();
+                table = make_shared<const CSVTable>(CSVReader::readTable(files[fileIndex]));
+            } catch (const OperationCancelled&) {
+                shardMissing = true;
+                return;
+            }
+
+            lock_guard<mutex> lock(partsMutex);
+            for (size_t c = 0; c < table->columns.size(); ++c) {
+                auto result = pool.submit([this, table, c, token]() {
+                    CancellationToken::Scope scope(token);
+                    try {
+                        CancellationToken::throwIfCancelled();
+                        return ColumnAnalyzer::analyze(c, table->columns[c], options_);
+                    } catch (const OperationCancelled&) {
+                        ColumnResult result(c);
+                        result.complete = false;
+                        return result;
+                    }
+                });
+                parts.push_back(Part{fileIndex, c, table->headers[c], std::move(result)});
+            }
+        }));
+    }
+
+    for (auto& read : reads) {
+        read.get();  // Propagates read errors
+    }
+
+    // Group partial results by header name; first-seen = lowest (file, position)
+    map<string, vector<Part*>> byName;
+    for (auto& part : parts) {
+        byName[part.name].push_back(&part);
+    }
+
+    struct Merged {
+        size_t file;
+        size_t position;
+        future<ColumnResult> result;
+    };
+    vector<Merged> merged;
+    for (auto& [name, group] : byName) {
+        sort(group.begin(), group.end(), [](const Part* a, const Part* b) {
+            return make_pair(a->file, a->position) < make_pair(b->file, b->position);
+        });
+
+        // Each column name is merged independently on the pool; all column
+        // tasks were queued before any merge task, so waiting on them cannot deadlock
+        merged.push_back(Merged{group.front()->file, group.front()->position,
+                                pool.submit([group, name = name, token, cancelled]() {
+            CancellationToken::Scope scope(token);
+            ColumnResult total = group.front()->result.get();
+            for (size_t i = 1; i < group.size(); ++i) {
+                ColumnResult part = group[i]->result.get();  // Always waited for: parts outlive tasks
+                if (!total.complete || cancelled()) {
+                    total.complete = false;
+                    continue;
+                }
+                total.merge(std::move(part));
+            }
+            total.columnName = name;
+            return total;
+        })});
+    }
+
+    sort(merged.begin(), merged.end(), [](const Merged& a, const Merged& b) {
+        return make_pair(a.file, a.position) < make_pair(b.file, b.position);
+    });
+
+    vector<ColumnResult> results;
+    results.reserve(merged.size());
+    size_t incomplete = 0;
+    for (auto& m : merged) {
+        results.push_back(m.result.get());
+        results.back().columnIndex = results.size() - 1;
+        if (shardMissing) {
+            results.back().complete = false;
+        }
+        incomplete += results.back().complete ? 0 : 1;
+    }
+
+    Console::out() << "Merged " << parts.size() << " column parts into "
+         << results.size() << " columns" << endl;
+    if (incomplete > 0) {
+        Console::out() << "Cancelled: " << incomplete << " of " << results.size()
+             << " columns incomplete" << endl;
+    }
+
+    return results;
+}
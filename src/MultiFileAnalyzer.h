@@ -0,0 +1,37 @@
+#ifndef COLUMNANALYZER_MULTIFILEANALYZER_H
+#define COLUMNANALYZER_MULTIFILEANALYZER_H
+
+#include <string>
+#include <vector>
+#include "ColumnAnalyzer.h"
+
+/**
+ * Analyzes many CSV shards and merges their columns by header name
+ */
+class MultiFileAnalyzer {
+public:
+    /**
+     * Constructor
+     * @param numThreads Worker threads shared by parsing, analysis and merging
+     * @param options Options passed to ColumnAnalyzer for every column
+     */
+    explicit MultiFileAnalyzer(size_t numThreads = 8, AnalyzerOptions options = {});
+
+    /**
+     * Parse all files in parallel and merge per-column results across files
+     * Files are scheduled largest first, and every parsed file queues its
+     * columns as separate tasks, so uneven shard sizes do not leave workers idle
+     * Every task runs under the caller's CancellationToken: once it is
+     * cancelled, unfinished columns come back with complete = false, and
+     * all columns do if a shard was not read to the end
+     * @param files Input files
+     * @return One result per distinct header name, in first-seen order
+     */
+    std::vector<ColumnResult> analyze(const std::vector<std::string>& files) const;
+
+private:
+    size_t numThreads_;
+    AnalyzerOptions options_;
+};
+
+#endif //COLUMNANALYZER_MULTIFILEANALYZER_H
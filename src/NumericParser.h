@@ -0,0 +1,195 @@
+#ifndef COLUMNANALYZER_NUMERICPARSER_H
+#define COLUMNANALYZER_NUMERICPARSER_H
+
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Bulk integer and fixed-point decimal parsing for numeric columns
+ *
+ * Plain integers ("-123") and decimals ("4417.50") are converted eight
+ * digits at a time with SWAR arithmetic on one 64-bit word. A decimal
+ * with at most 2^53 as mantissa and 22 fraction digits is mantissa / 10^k,
+ * one correctly rounded division, so results are bit-identical to
+ * std::from_chars. Everything else (exponents, inf/nan, long mantissas,
+ * stray characters) goes to std::from_chars.
+ */
+namespace NumericParser {
+
+    namespace detail {
+        constexpr uint64_t kZeros = 0x3030303030303030ull;
+
+        constexpr double kPow10[] = {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
+
+        constexpr uint64_t kMaxExactMantissa = uint64_t{1} << 53;
+
+        inline bool isDigit(char c) {
+            return static_cast<unsigned char>(c - '0') < 10;
+        }
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        /**
+         * All eight bytes are ASCII digits
+         */
+        inline bool eightDigits(const char* p) {
+            uint64_t word;
+            std::memcpy(&word, p, sizeof(word));
+            return (((word & 0xF0F0F0F0F0F0F0F0ull) |
+                     (((word + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) ==
+                    0x3333333333333333ull);
+        }
+
+        /**
+         * Value of eight ASCII digits, first digit most significant
+         */
+        inline uint64_t parseEight(const char* p) {
+            uint64_t word;
+            std::memcpy(&word, p, sizeof(word));
+            word -= kZeros;
+            word = (word * 10) + (word >> 8);  // Pairs of digits
+            word = (((word & 0x000000FF000000FFull) * (100 + (1000000ull << 32))) +
+                    (((word >> 16) & 0x000000FF000000FFull) * (1 + (10000ull << 32)))) >> 32;
+            return word;
+        }
+#else
+        inline bool eightDigits(const char*) { return false; }
+        inline uint64_t parseEight(const char*) { return 0; }
+#endif
+
+        /**
+         * Accumulate a run of digits into `value`
+         * @return Pointer past the last digit
+         */
+        inline const char* digits(const char* p, const char* end, uint64_t& value) {
+            while (end - p >= 8 && eightDigits(p)) {
+                value = value * 100000000ull + parseEight(p);
+                p += 8;
+            }
+            while (p != end && isDigit(*p)) {
+                value = value * 10 + static_cast<uint64_t>(*p - '0');
+                ++p;
+            }
+            return p;
+        }
+
+        template <typename T>
+        bool fromChars(std::string_view text, T& value) {
+            const char* end = text.data() + text.size();
+            auto [ptr, ec] = std::from_chars(text.data(), end, value);
+            return ec == std::errc() && ptr == end;
+        }
+    } // namespace detail
+
+    /**
+     * Parse a whole cell as int64 (same accepted syntax as std::from_chars)
+     * @param text Cell
+     * @param value Parsed value
+     * @return False if the cell is not an integer in range
+     */
+    inline bool parseInt64(std::string_view text, int64_t& value) {
+        const char* p = text.data();
+        const char* end = p + text.size();
+        const bool negative = p != end && *p == '-';
+        p += negative;
+
+        // Up to 18 digits cannot overflow; longer runs take the slow path
+        if (p == end || end - p > 18) {
+            return detail::fromChars(text, value);
+        }
+
+        uint64_t magnitude = 0;
+        if (detail::digits(p, end, magnitude) != end) {
+            return false;
+        }
+        value = negative ? -static_cast<int64_t>(magnitude) : static_cast<int64_t>(magnitude);
+        return true;
+    }
+
+    /**
+     * Parse a whole cell as double (same result as std::from_chars)
+     * @param text Cell
+     * @param value Parsed value
+     * @return False if the cell is not a number
+     */
+    inline bool parseDouble(std::string_view text, double& value) {
+        const char* p = text.data();
+        const char* end = p + text.size();
+        const bool negative = p != end && *p == '-';
+        p += negative;
+
+        uint64_t mantissa = 0;
+        const char* intEnd = detail::digits(p, end, mantissa);
+        const char* fracEnd = intEnd;
+        if (intEnd != end && *intEnd == '.') {
+            fracEnd = detail::digits(intEnd + 1, end, mantissa);
+        }
+
+        const size_t intDigits = static_cast<size_t>(intEnd - p);
+        const size_t fracDigits = fracEnd == intEnd ? 0 : static_cast<size_t>(fracEnd - intEnd - 1);
+        const size_t totalDigits = intDigits + fracDigits;
+
+        // 19 digits fit in uint64_t without wrapping; 2^53 keeps the mantissa exact
+        if (fracEnd != end || totalDigits == 0 || totalDigits > 19 ||
+            fracDigits > 22 || mantissa > detail::kMaxExactMantissa) {
+            return detail::fromChars(text, value);
+        }
+
+        const double magnitude = static_cast<double>(mantissa) / detail::kPow10[fracDigits];
+        value = negative ? -magnitude : magnitude;
+        return true;
+    }
+
+    /**
+     * Convert a block of cells
+     * @param cells First cell
+     * @param count Number of cells
+     * @param values Output values (count entries; 0 where not parsed)
+     * @param parsed Output flags, 1 where the cell is a number (count entries)
+     * @return Number of cells parsed
+     */
+    template <typename T, typename Cell>
+    size_t parseBlock(const Cell* cells, size_t count, T* values, uint8_t* parsed) {
+        static_assert(std::is_same_v<T, int64_t> || std::is_same_v<T, double>,
+                      "int64_t or double");
+        size_t ok = 0;
+        for (size_t i = 0; i < count; ++i) {
+            T value{};
+            bool good;
+            if constexpr (std::is_same_v<T, int64_t>) {
+                good = parseInt64(cells[i], value);
+            } else {
+                good = parseDouble(cells[i], value);
+            }
+            values[i] = good ? value : T{};
+            parsed[i] = good;
+            ok += good;
+        }
+        return ok;
+    }
+
+    /**
+     * Convert a whole column
+     * @param column Column cells
+     * @param values Output values, resized to the column
+     * @param parsed Output flags, resized to the column
+     * @return Number of cells parsed
+     */
+    template <typename T>
+    size_t parseColumn(const std::vector<std::string>& column,
+                       std::vector<T>& values, std::vector<uint8_t>& parsed) {
+        values.resize(column.size());
+        parsed.resize(column.size());
+        return parseBlock(column.data(), column.size(), values.data(), parsed.data());
+    }
+
+} // namespace NumericParser
+
+#endif //COLUMNANALYZER_NUMERICPARSER_H
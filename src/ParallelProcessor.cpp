@@ -1,9 +1,13 @@
 #include "ParallelProcessor.h"
+#include "ProgressReporter.h"
+#include "Console.h"
 #include <algorithm>
+#include <atomic>
+#include <cmath>
 #include <numeric>
 #include <thread>
 #include <future>
-#include <iostream>
+#include <iterator>
 
 #if !defined(__APPLE__) && defined(__cpp_lib_execution)
 #  include <execution>
@@ -20,9 +24,11 @@ ParallelStrategy strategyFromInt(int value) {
             return ParallelStrategy::THREADS;
         case 3:
             return ParallelStrategy::ASYNC;
+        case 4:
+            return ParallelStrategy::PIPELINE;
         default:
             throw invalid_argument("Unknown strategy: " + to_string(value) +
-                                   ". Valid values: 1 (policy), 2 (threads), 3 (async)");
+                                   ". Valid values: 1 (policy), 2 (threads), 3 (async), 4 (pipeline)");
     }
 }
 
@@ -34,13 +40,15 @@ string strategyToString(ParallelStrategy strategy) {
             return "threads";
         case ParallelStrategy::ASYNC:
             return "async";
+        case ParallelStrategy::PIPELINE:
+            return "pipeline";
         default:
             return "unknown";
     }
 }
 
-ParallelProcessor::ParallelProcessor(size_t numThreads)
-    : numThreads_(numThreads) {
+ParallelProcessor::ParallelProcessor(size_t numThreads, AnalyzerOptions options)
+    : numThreads_(numThreads), options_(options) {
     // If not specified, use the number of hardware threads
     if (numThreads_ == 0) {
         numThreads_ = thread::hardware_concurrency();
@@ -54,79 +62,376 @@ vector<ColumnResult> ParallelProcessor::process(
         const vector<vector<string>>& columns,
         ParallelStrategy strategy) {
 
-    cout << "Processing " << columns.size() << " columns using strategy: "
+    AnalyzerOptions options = optionsFor(columns.size());
+    return run(columns.size(), [&options, &columns](size_t i) {
+        return ColumnAnalyzer::analyze(i, columns[i], options);
+    }, strategy);
+}
+
+vector<ColumnResult> ParallelProcessor::process(
+        const vector<vector<string>>& columns,
+        const vector<vector<uint64_t>>& cellHashes,
+        ParallelStrategy strategy) {
+
+    if (cellHashes.size() != columns.size()) {
+        throw invalid_argument("Cell hashes missing for some columns");
+    }
+
+    AnalyzerOptions options = optionsFor(columns.size());
+    return run(columns.size(), [&options, &columns, &cellHashes](size_t i) {
+        return ColumnAnalyzer::analyze(i, columns[i], options, &cellHashes[i]);
+    }, strategy);
+}
+
+ColumnResult ParallelProcessor::mergeTree(vector<ColumnResult> parts,
+                                         ParallelStrategy strategy) const {
+    if (parts.empty()) {
+        return ColumnResult();
+    }
+
+    // Round r merges parts[i + 2^r] into parts[i] for i a multiple of 2^(r+1)
+    for (size_t stride = 1; stride < parts.size(); stride *= 2) {
+        const size_t pairs = (parts.size() - stride + 2 * stride - 1) / (2 * stride);
+        bool finished = runTasks(pairs, [&parts, stride](size_t p) {
+            const size_t i = p * 2 * stride;
+            parts[i].merge(std::move(parts[i + stride]));
+        }, strategy);
+
+        if (!finished) {
+            parts[0].complete = false;
+            break;
+        }
+    }
+    return std::move(parts[0]);
+}
+
+vector<CombinationResult> ParallelProcessor::processCombinations(
+        const vector<vector<string>>& columns,
+        const vector<vector<uint64_t>>& cellHashes,
+        const vector<ColumnGroup>& groups,
+        CombinationMode mode,
+        ParallelStrategy strategy) {
+
+    const size_t rows = CombinationAnalyzer::validate(columns, groups);
+    if (!cellHashes.empty() && cellHashes.size() != columns.size()) {
+        throw invalid_argument("Cell hashes missing for some columns");
+    }
+    const auto* hashes = cellHashes.empty() ? nullptr : &cellHashes;
+    constexpr size_t kBlockRows = CombinationAnalyzer::kBlockRows;
+
+    Console::out() << "Counting " << groups.size() << " column combinations ("
+         << (mode == CombinationMode::EXACT ? "exact" : "hll") << ") using strategy: "
          << strategyToString(strategy) << endl;
 
-    if (columns.empty()) {
-        cout << "Warning: No columns to process" << endl;
+    vector<CombinationResult> results(groups.size());
+    for (size_t g = 0; g < groups.size(); ++g) {
+        results[g].columns = groups[g];
+        results[g].rowCount = rows;
+        results[g].mode = mode;
+    }
+    if (groups.empty()) {
+        return results;
+    }
+
+    // One pass over the rows: a stripe per worker, keys of every group per block
+    const size_t stripes = max<size_t>(1, min(numThreads_, (rows + kBlockRows - 1) / kBlockRows));
+    const size_t stripeRows = (rows + stripes - 1) / stripes;
+
+    // EXACT: enough key partitions per group to keep every worker busy. Each
+    // stripe scatters its keys into its own buffer per (group, partition),
+    // so a partition task reads only the keys it indexes.
+    const size_t partitions = rows < kBlockRows
+                              ? 1
+                              : (numThreads_ + groups.size() - 1) / groups.size();
+    auto bufferOf = [&](size_t s, size_t g) { return (s * groups.size() + g) * partitions; };
+
+    vector<KeyPartition> scattered;
+    vector<vector<HyperLogLog>> sketches(stripes);
+    if (mode == CombinationMode::EXACT) {
+        scattered.resize(stripes * groups.size() * partitions);
+    }
+
+    bool finished = runTasks(stripes, [&](size_t s) {
+        const size_t begin = s * stripeRows;
+        const size_t end = min(rows, begin + stripeRows);
+
+        vector<uint64_t> block(kBlockRows);
+        vector<HyperLogLog> local;
+        if (mode == CombinationMode::HLL) {
+            local.assign(groups.size(), HyperLogLog(CombinationAnalyzer::kHllPrecision));
+        } else {
+            for (size_t b = bufferOf(s, 0); b < bufferOf(s + 1, 0); ++b) {
+                scattered[b].reserve((end - begin) / partitions);
+            }
+        }
+
+        for (size_t start = begin; start < end; start += kBlockRows) {
+            CancellationToken::throwIfCancelled();
+            const size_t count = min(kBlockRows, end - start);
+            for (size_t g = 0; g < groups.size(); ++g) {
+                CombinationAnalyzer::rowKeys(columns, hashes, groups[g], start, count, block.data());
+                if (mode == CombinationMode::EXACT) {
+                    CombinationAnalyzer::scatterKeys(block.data(), start, count,
+                                                     &scattered[bufferOf(s, g)], partitions);
+                    continue;
+                }
+                for (size_t i = 0; i < count; ++i) {
+                    local[g].add(block[i]);
+                }
+            }
+        }
+        sketches[s] = std::move(local);
+    }, strategy);
+
+    if (finished && mode == CombinationMode::HLL) {
+        for (size_t g = 0; g < groups.size(); ++g) {
+            HyperLogLog total(CombinationAnalyzer::kHllPrecision);
+            for (const auto& stripe : sketches) {
+                total.merge(stripe[g]);
+            }
+            results[g].distinctCount = static_cast<size_t>(llround(total.estimate()));
+            results[g].relativeError = total.relativeError();
+        }
+    }
+
+    if (finished && mode == CombinationMode::EXACT) {
+        vector<size_t> counts(groups.size() * partitions);
+
+        finished = runTasks(counts.size(), [&](size_t t) {
+            const size_t g = t / partitions;
+            vector<const KeyPartition*> parts(stripes);
+            for (size_t s = 0; s < stripes; ++s) {
+                parts[s] = &scattered[bufferOf(s, g) + t % partitions];
+            }
+            counts[t] = CombinationAnalyzer::countPartition(columns, groups[g], parts);
+            for (size_t s = 0; s < stripes; ++s) {
+                scattered[bufferOf(s, g) + t % partitions] = KeyPartition();  // Indexed: release
+            }
+        }, strategy);
+
+        for (size_t t = 0; t < counts.size(); ++t) {
+            results[t / partitions].distinctCount += counts[t];
+        }
+    }
+
+    if (!finished) {
+        for (auto& result : results) {
+            result.complete = false;
+        }
+        Console::out() << "Cancelled: " << groups.size() << " column combinations incomplete" << endl;
+    }
+    return results;
+}
+
+AnalyzerOptions ParallelProcessor::optionsFor(size_t columnCount) const {
+    AnalyzerOptions options = options_;
+    if (options.sortThreads == 0) {
+        // Threads left over after one thread per column go to sorting
+        options.sortThreads = max<size_t>(1, numThreads_ / max<size_t>(columnCount, 1));
+    }
+    return options;
+}
+
+vector<ColumnResult> ParallelProcessor::run(size_t count,
+                                            const ColumnTask& task,
+                                            ParallelStrategy strategy) {
+
+    Console::out() << "Processing " << count << " columns using strategy: "
+         << strategyToString(strategy) << endl;
+
+    incomplete_.clear();
+
+    if (count == 0) {
+        Console::out() << "Warning: No columns to process" << endl;
         return {};
     }
 
+    // Kernels check the token between chunks; a cancelled column is
+    // returned empty and marked incomplete instead of failing the run
+    const CancellationToken* token = cancellation_ != nullptr
+                                     ? cancellation_
+                                     : CancellationToken::current();
+    auto incompleteResult = [](size_t i) {
+        ColumnResult result(i);
+        result.complete = false;
+        return result;
+    };
+
+    // Rows are published by the kernels, finished columns here
+    ColumnTask counted = [&task, token, &incompleteResult](size_t i) {
+        if (token != nullptr && token->isCancelled()) {
+            return incompleteResult(i);
+        }
+        CancellationToken::Scope scope(token);
+        try {
+            ColumnResult result = task(i);
+            ProgressReporter::counters().addColumns(1);
+            return result;
+        } catch (const OperationCancelled&) {
+            return incompleteResult(i);
+        }
+    };
+
+    vector<ColumnResult> results;
     switch (strategy) {
         case ParallelStrategy::EXECUTION_POLICY:
-            return processWithExecutionPolicy(columns);
+            results = processWithExecutionPolicy(count, counted);
+            break;
         case ParallelStrategy::THREADS:
-            return processWithThreads(columns);
+        case ParallelStrategy::PIPELINE:  // Read and parse are already done
+            results = processWithThreads(count, counted);
+            break;
         case ParallelStrategy::ASYNC:
-            return processWithAsync(columns);
+            results = processWithAsync(count, counted);
+            break;
+        default:
+            throw invalid_argument("Unknown strategy");
+    }
+
+    for (const auto& result : results) {
+        if (!result.complete) {
+            incomplete_.push_back(result.columnIndex);
+        }
+    }
+    if (!incomplete_.empty()) {
+        Console::out() << "Cancelled: " << incomplete_.size() << " of " << count
+             << " columns incomplete" << endl;
+    }
+
+    return results;
+}
+
+bool ParallelProcessor::runTasks(size_t count,
+                                 const function<void(size_t)>& task,
+                                 ParallelStrategy strategy) const {
+
+    const CancellationToken* token = cancellation_ != nullptr
+                                     ? cancellation_
+                                     : CancellationToken::current();
+    atomic<bool> cancelled{false};
+
+    auto guarded = [&task, token, &cancelled](size_t i) {
+        if (cancelled.load(memory_order_relaxed) || (token != nullptr && token->isCancelled())) {
+            cancelled.store(true, memory_order_relaxed);
+            return;
+        }
+        CancellationToken::Scope scope(token);
+        try {
+            task(i);
+        } catch (const OperationCancelled&) {
+            cancelled.store(true, memory_order_relaxed);
+        }
+    };
+
+    switch (strategy) {
+        case ParallelStrategy::EXECUTION_POLICY:
+#ifdef HAS_EXECUTION_POLICY
+        {
+            vector<size_t> indices(count);
+            iota(indices.begin(), indices.end(), 0);
+            for_each(execution::par, indices.begin(), indices.end(), guarded);
+            break;
+        }
+#endif
+            // Without execution policy support, threads do the work
+            [[fallthrough]];
+        case ParallelStrategy::THREADS:
+        case ParallelStrategy::PIPELINE: {
+            // Tasks differ in size, so workers pull the next index
+            atomic<size_t> next{0};
+            vector<thread> threads;
+            for (size_t t = 0; t < min(numThreads_, count); ++t) {
+                threads.emplace_back([&]() {
+                    for (size_t i; (i = next.fetch_add(1)) < count;) {
+                        guarded(i);
+                    }
+                });
+            }
+            for (auto& t : threads) {
+                t.join();
+            }
+            break;
+        }
+        case ParallelStrategy::ASYNC: {
+            vector<future<void>> tasks;
+            for (size_t i = 0; i < count; ++i) {
+                tasks.push_back(async(launch::async, guarded, i));
+            }
+            for (auto& f : tasks) {
+                f.get();
+            }
+            break;
+        }
         default:
             throw invalid_argument("Unknown strategy");
     }
+
+    return !cancelled.load();
 }
 
 vector<ColumnResult> ParallelProcessor::processWithExecutionPolicy(
-        const vector<vector<string>>& columns) {
+        size_t count, const ColumnTask& task) {
 
 #ifdef HAS_EXECUTION_POLICY
     try {
-        cout << "Using C++17 execution policy (parallel)" << endl;
+        Console::out() << "Using C++17 execution policy (parallel)" << endl;
 
-        vector<size_t> indices(columns.size());
+        vector<size_t> indices(count);
         iota(indices.begin(), indices.end(), 0);
 
-        vector<ColumnResult> results(columns.size());
+        vector<ColumnResult> results(count);
 
         transform(execution::par,
                   indices.begin(), indices.end(),
                   results.begin(),
                   [&](size_t i) {
-                      return ColumnAnalyzer::analyze(i, columns[i]);
+                      return task(i);
                   });
 
         return results;
     } catch (const exception& e) {
-        cerr << "Execution policy failed: " << e.what() << endl;
-        cerr << "Falling back to threads..." << endl;
-        return processWithThreads(columns);
+        Console::err() << "Execution policy failed: " << e.what() << endl;
+        Console::err() << "Falling back to threads..." << endl;
+        return processWithThreads(count, task);
     }
 #else
-    cerr << "Warning: Execution policy not available, falling back to threads" << endl;
-    return processWithThreads(columns);
+    Console::err() << "Warning: Execution policy not available, falling back to threads" << endl;
+    return processWithThreads(count, task);
 #endif
 }
 
 vector<ColumnResult> ParallelProcessor::processWithThreads(
-        const vector<vector<string>>& columns) const {
+        size_t count, const ColumnTask& task) const {
 
-    cout << "Using std::thread (" << numThreads_ << " threads)" << endl;
+    Console::out() << "Using std::thread (" << numThreads_ << " threads)" << endl;
 
-    vector<ColumnResult> results(columns.size());
-    vector<thread> threads;
+    // Each worker fills its own cache-line-aligned slot, so finishing a
+    // column never writes a line that a neighbouring worker is writing too.
+    // After the join the first slot's storage (reserved for every column)
+    // becomes the result and the other slots are moved in behind it.
+    struct alignas(64) WorkerSlot {
+        vector<ColumnResult> results;
+    };
+
+    if (count == 0) {
+        return {};
+    }
 
     // Split between threads
-    size_t colsPerThread = (columns.size() + numThreads_ - 1) / numThreads_;
+    size_t colsPerThread = (count + numThreads_ - 1) / numThreads_;
+    size_t workers = (count + colsPerThread - 1) / colsPerThread;
 
-    for (size_t t = 0; t < numThreads_; ++t) {
-        size_t start = t * colsPerThread;
-        size_t end = min(start + colsPerThread, columns.size());
+    vector<WorkerSlot> slots(workers);
+    vector<thread> threads;
 
-        if (start >= columns.size()) {
-            break;
-        }
+    for (size_t t = 0; t < workers; ++t) {
+        size_t start = t * colsPerThread;
+        size_t end = min(start + colsPerThread, count);
 
-        threads.emplace_back([&, start, end]() {
+        threads.emplace_back([&task, &slot = slots[t], start, end, count, t]() {
+            slot.results.reserve(t == 0 ? count : end - start);
             for (size_t i = start; i < end; ++i) {
-                results[i] = ColumnAnalyzer::analyze(i, columns[i]);
+                slot.results.push_back(task(i));
             }
         });
     }
@@ -136,29 +441,34 @@ vector<ColumnResult> ParallelProcessor::processWithThreads(
         t.join();
     }
 
+    // Slots hold consecutive column ranges in order
+    vector<ColumnResult> results = std::move(slots[0].results);
+    for (size_t t = 1; t < workers; ++t) {
+        move(slots[t].results.begin(), slots[t].results.end(), back_inserter(results));
+    }
     return results;
 }
 
 vector<ColumnResult> ParallelProcessor::processWithAsync(
-        const vector<vector<string>>& columns) {
+        size_t count, const ColumnTask& task) {
 
-    cout << "Using std::async (asynchronous tasks)" << endl;
+    Console::out() << "Using std::async (asynchronous tasks)" << endl;
 
     // Limit concurrent tasks to hardware threads
     size_t maxConcurrent = thread::hardware_concurrency();
     if (maxConcurrent == 0) maxConcurrent = 8;
 
-    vector<ColumnResult> results(columns.size());
+    vector<ColumnResult> results(count);
 
-    for (size_t start = 0; start < columns.size(); start += maxConcurrent) {
-        size_t end = min(start + maxConcurrent, columns.size());
+    for (size_t start = 0; start < count; start += maxConcurrent) {
+        size_t end = min(start + maxConcurrent, count);
         vector<future<ColumnResult>> batch;
 
         // Launch batch
         for (size_t i = start; i < end; ++i) {
             batch.push_back(
-                    async(launch::async, [i, &columns]() {
-                        return ColumnAnalyzer::analyze(i, columns[i]);
+                    async(launch::async, [i, &task]() {
+                        return task(i);
                     })
             );
         }
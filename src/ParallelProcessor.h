@@ -3,6 +3,9 @@
 
 #include <vector>
 #include <string>
+#include <functional>
+#include "CancellationToken.h"
+#include "CombinationAnalyzer.h"
 #include "ColumnAnalyzer.h"
 
 /**
@@ -11,12 +14,14 @@
 enum class ParallelStrategy {
     EXECUTION_POLICY = 1,  // C++17 execution policy
     THREADS = 2,           // std::thread
-    ASYNC = 3              // std::async
+    ASYNC = 3,             // std::async
+    PIPELINE = 4           // Streaming read -> parse -> analyze -> write (PipelineExecutor);
+                           // on columns already in memory, the same as THREADS
 };
 
 /**
  * Convert integer to strategy
- * @param value Strategy number (1, 2, 3)
+ * @param value Strategy number (1, 2, 3, 4)
  * @return Strategy
  */
 ParallelStrategy strategyFromInt(int value);
@@ -34,8 +39,10 @@ public:
     /**
      * Constructor
      * @param numThreads Number of threads (for THREADS strategy)
+     * @param options Options passed to ColumnAnalyzer for every column
      */
-    explicit ParallelProcessor(size_t numThreads = 8);
+    explicit ParallelProcessor(size_t numThreads = 8,
+                               AnalyzerOptions options = {});
 
     /**
      * Process columns in parallel
@@ -48,37 +55,130 @@ public:
             ParallelStrategy strategy
     );
 
+    /**
+     * Process columns in parallel using cell hashes computed by the reader
+     * @param columns Column data
+     * @param cellHashes Per-cell hashes for each column
+     * @param strategy Parallelism strategy
+     * @return Analysis results for each column
+     */
+    std::vector<ColumnResult> process(
+            const std::vector<std::vector<std::string>>& columns,
+            const std::vector<std::vector<uint64_t>>& cellHashes,
+            ParallelStrategy strategy
+    );
+
+    /**
+     * Combine partial results of one column (chunks, files, runs) by
+     * merging pairs in parallel: N parts take ceil(log2 N) rounds instead
+     * of N - 1 serial merges
+     * @param parts Partial results; consumed
+     * @param strategy Parallelism strategy for each round
+     * @return Merged result (index and name of parts[0]); complete = false
+     *         if cancelled between rounds
+     */
+    ColumnResult mergeTree(std::vector<ColumnResult> parts,
+                           ParallelStrategy strategy = ParallelStrategy::THREADS) const;
+
+    /**
+     * Distinct tuple counts of column groups
+     * Row keys of all groups are built in one pass over row stripes, one
+     * stripe per worker; EXACT then indexes groups x key partitions in
+     * parallel, HLL merges the per-stripe sketches
+     * @param columns Column data
+     * @param cellHashes Per-cell hashes from the reader (empty = hash here)
+     * @param groups Column groups
+     * @param mode Exact or HLL counting
+     * @param strategy Parallelism strategy
+     * @return One result per group, in order
+     */
+    std::vector<CombinationResult> processCombinations(
+            const std::vector<std::vector<std::string>>& columns,
+            const std::vector<std::vector<uint64_t>>& cellHashes,
+            const std::vector<ColumnGroup>& groups,
+            CombinationMode mode,
+            ParallelStrategy strategy
+    );
+
+    /**
+     * Stop cooperatively when the token is cancelled or its deadline passes
+     * Columns not finished by then are returned with complete = false
+     * @param token Cancellation token (nullptr = run to the end)
+     */
+    void setCancellation(const CancellationToken* token) { cancellation_ = token; }
+
+    /**
+     * Indices of columns the last process() call did not finish
+     */
+    [[nodiscard]] const std::vector<size_t>& incompleteColumns() const { return incomplete_; }
+
 private:
     size_t numThreads_;
+    AnalyzerOptions options_;
+    const CancellationToken* cancellation_ = nullptr;
+    std::vector<size_t> incomplete_;
+
+    /**
+     * Analysis of a single column by index
+     */
+    using ColumnTask = std::function<ColumnResult(size_t)>;
+
+    /**
+     * Analyzer options with automatic settings resolved for this run
+     * @param columnCount Number of columns being processed
+     */
+    [[nodiscard]] AnalyzerOptions optionsFor(size_t columnCount) const;
+
+    /**
+     * Run a column task for every column with the chosen strategy
+     * @param count Number of columns
+     * @param task Per-column analysis
+     * @param strategy Parallelism strategy
+     * @return Analysis results
+     */
+    std::vector<ColumnResult> run(size_t count,
+                                  const ColumnTask& task,
+                                  ParallelStrategy strategy);
+
+    /**
+     * Run task(i) for i in [0, count) with the chosen strategy
+     * @return False if the cancellation token stopped the tasks
+     */
+    bool runTasks(size_t count,
+                  const std::function<void(size_t)>& task,
+                  ParallelStrategy strategy) const;
 
     /**
      * Processing with execution policy (C++17)
      * Uses std::transform with std::execution::par
-     * @param columns Column data
+     * @param count Number of columns
+     * @param task Per-column analysis
      * @return Analysis results
      */
     std::vector<ColumnResult> processWithExecutionPolicy(
-            const std::vector<std::vector<std::string>>& columns
+            size_t count, const ColumnTask& task
     );
 
     /**
      * Processing with std::thread (manual thread management)
      * Creates a thread pool and distributes work among them
-     * @param columns Column data
+     * @param count Number of columns
+     * @param task Per-column analysis
      * @return Analysis results
      */
     [[nodiscard]] std::vector<ColumnResult> processWithThreads(
-            const std::vector<std::vector<std::string>>& columns
+            size_t count, const ColumnTask& task
     ) const;
 
     /**
      * Processing with std::async (asynchronous tasks)
      * Launches async tasks for each column
-     * @param columns Column data
+     * @param count Number of columns
+     * @param task Per-column analysis
      * @return Analysis results
      */
     static std::vector<ColumnResult> processWithAsync(
-            const std::vector<std::vector<std::string>>& columns
+            size_t count, const ColumnTask& task
     );
 };
 
@@ -0,0 +1,152 @@
+#include "PerfCounters.h"
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+
+#ifdef __linux__
+#  include <linux/perf_event.h>
+#  include <sys/ioctl.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#endif
+
+using namespace std;
+
+double PerfSample::ipc() const {
+    if (!has(PERF_CYCLES) || !has(PERF_INSTRUCTIONS) || values[PERF_CYCLES] == 0) {
+        return 0.0;
+    }
+    return static_cast<double>(values[PERF_INSTRUCTIONS]) / static_cast<double>(values[PERF_CYCLES]);
+}
+
+double PerfSample::perRow(PerfEvent event, size_t rows) const {
+    if (!has(event) || rows == 0) {
+        return 0.0;
+    }
+    return static_cast<double>(values[event]) / static_cast<double>(rows);
+}
+
+const char* PerfCounters::eventName(PerfEvent event) {
+    switch (event) {
+        case PERF_CYCLES: return "cycles";
+        case PERF_INSTRUCTIONS: return "instructions";
+        case PERF_CACHE_MISSES: return "cache-misses";
+        case PERF_BRANCH_MISSES: return "branch-misses";
+        case PERF_TASK_CLOCK: return "task-clock";
+        default: return "unknown";
+    }
+}
+
+#ifdef __linux__
+
+namespace {
+
+    struct EventConfig {
+        uint32_t type;
+        uint64_t config;
+    };
+
+    constexpr EventConfig kEvents[PERF_EVENT_COUNT] = {
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+        {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK},
+    };
+
+    int openEvent(const EventConfig& event, int groupFd) {
+        perf_event_attr attr{};
+        attr.size = sizeof(attr);
+        attr.type = event.type;
+        attr.config = event.config;
+        attr.disabled = groupFd == -1;  // Members follow the leader
+        attr.inherit = 1;               // Count threads started during the phase
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, groupFd, 0));
+    }
+
+    string paranoidLevel() {
+        ifstream file("/proc/sys/kernel/perf_event_paranoid");
+        string level;
+        return file >> level ? level : "unknown";
+    }
+
+} // namespace
+
+PerfCounters::PerfCounters() {
+    fds_.fill(-1);
+
+    for (size_t e = 0; e < PERF_EVENT_COUNT; ++e) {
+        // The first event that opens leads the group
+        fds_[e] = openEvent(kEvents[e], leader_);
+        if (fds_[e] >= 0) {
+            if (leader_ < 0) leader_ = fds_[e];
+        } else if (error_.empty() && e < PERF_TASK_CLOCK) {
+            error_ = string(eventName(static_cast<PerfEvent>(e))) + ": " + strerror(errno) +
+                     " (perf_event_paranoid=" + paranoidLevel() + ")";
+        }
+    }
+}
+
+PerfCounters::~PerfCounters() {
+    for (int fd : fds_) {
+        if (fd >= 0) close(fd);
+    }
+}
+
+void PerfCounters::start() {
+    if (leader_ >= 0) {
+        ioctl(leader_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(leader_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+    started_ = chrono::steady_clock::now();
+}
+
+PerfSample PerfCounters::stop() {
+    PerfSample sample;
+    sample.seconds = chrono::duration<double>(chrono::steady_clock::now() - started_).count();
+    if (leader_ < 0) {
+        return sample;
+    }
+    ioctl(leader_, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+    for (size_t e = 0; e < PERF_EVENT_COUNT; ++e) {
+        struct { uint64_t value, enabled, running; } data{};
+        if (fds_[e] < 0 || read(fds_[e], &data, sizeof(data)) != static_cast<ssize_t>(sizeof(data))) {
+            continue;
+        }
+        double value = static_cast<double>(data.value);
+        if (data.running > 0 && data.running < data.enabled) {
+            value *= static_cast<double>(data.enabled) / static_cast<double>(data.running);
+        }
+        sample.values[e] = static_cast<uint64_t>(value);
+        sample.valid[e] = data.running > 0;  // Never counted (multiplexed out or zero-length window): unknown
+    }
+    return sample;
+}
+
+#else
+
+PerfCounters::PerfCounters() : error_("perf_event_open is Linux only") {
+    fds_.fill(-1);
+}
+
+PerfCounters::~PerfCounters() = default;
+
+void PerfCounters::start() {
+    started_ = chrono::steady_clock::now();
+}
+
+PerfSample PerfCounters::stop() {
+    PerfSample sample;
+    sample.seconds = chrono::duration<double>(chrono::steady_clock::now() - started_).count();
+    return sample;
+}
+
+#endif
+
+bool PerfCounters::available() const {
+    return leader_ >= 0;
+}
@@ -0,0 +1,107 @@
+#ifndef COLUMNANALYZER_PERFCOUNTERS_H
+#define COLUMNANALYZER_PERFCOUNTERS_H
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Counters measured by PerfCounters
+ */
+enum PerfEvent : size_t {
+    PERF_CYCLES = 0,
+    PERF_INSTRUCTIONS,
+    PERF_CACHE_MISSES,
+    PERF_BRANCH_MISSES,
+    PERF_TASK_CLOCK,     // Software event: CPU time in ns, summed over threads
+    PERF_EVENT_COUNT
+};
+
+/**
+ * Counter values of one measured phase
+ */
+struct PerfSample {
+    std::array<uint64_t, PERF_EVENT_COUNT> values{};
+    std::array<bool, PERF_EVENT_COUNT> valid{};  // Event opened and read
+    double seconds = 0.0;                         // Wall time of the phase
+
+    [[nodiscard]] bool has(PerfEvent event) const { return valid[event]; }
+    [[nodiscard]] uint64_t operator[](PerfEvent event) const { return values[event]; }
+
+    /**
+     * Instructions per cycle (0 if either counter is missing)
+     */
+    [[nodiscard]] double ipc() const;
+
+    /**
+     * Event count per row (0 if the counter is missing or rows is 0)
+     */
+    [[nodiscard]] double perRow(PerfEvent event, size_t rows) const;
+};
+
+/**
+ * Named phase of a run with its counters and row count
+ */
+struct PerfPhase {
+    std::string name;
+    size_t rows = 0;
+    PerfSample sample;
+};
+
+/**
+ * Hardware performance counters around one phase (Linux perf_event_open)
+ *
+ * Opens a counter group (cycles, instructions, cache misses, branch
+ * misses, task clock) for the calling thread; threads it starts while the
+ * group is enabled inherit the counters, and their counts are added when
+ * they exit. User-space only, so perf_event_paranoid <= 2 suffices. Events
+ * the CPU or hypervisor does not expose are left out; with none available
+ * the phase still reports its wall time.
+ */
+class PerfCounters {
+public:
+    /**
+     * Open the counters (disabled)
+     */
+    PerfCounters();
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    /**
+     * Reset and enable the group
+     */
+    void start();
+
+    /**
+     * Disable the group and read it; multiplexed counters are scaled by
+     * time enabled / time running
+     */
+    PerfSample stop();
+
+    /**
+     * At least one event opened
+     */
+    [[nodiscard]] bool available() const;
+
+    /**
+     * Why the hardware events could not be opened (empty if they were)
+     */
+    [[nodiscard]] const std::string& error() const { return error_; }
+
+    /**
+     * Short event name ("cycles", "instructions", ...)
+     */
+    static const char* eventName(PerfEvent event);
+
+private:
+    std::array<int, PERF_EVENT_COUNT> fds_;
+    int leader_ = -1;
+    std::string error_;
+    std::chrono::steady_clock::time_point started_;
+};
+
+#endif //COLUMNANALYZER_PERFCOUNTERS_H
@@ -0,0 +1,347 @@
+#include "PipelineExecutor.h"
+#include "CSVReader.h"
+#include "ColumnAccumulator.h"
+#include "Console.h"
+#include "CoroutineScheduler.h"
+#include "ResultAggregator.h"
+#include "SortDistinct.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <semaphore>
+#include <stdexcept>
+#include <thread>
+
+using namespace std;
+using namespace chrono;
+
+namespace {
+
+    struct Chunk {
+        size_t index = 0;
+        string text;
+    };
+
+    /**
+     * State shared by the stages of one run
+     */
+    struct RunState {
+        const PipelineOptions& pipeline;
+        const CancellationToken* token;
+        bool quiet;
+        CoroutineScheduler& scheduler;
+        Sequencer& sequencer;
+
+        // Chunks alive between the read stage and the end of their analysis
+        counting_semaphore<> slots;
+
+        size_t columnCount = 0;
+        vector<ColumnAccumulator> columns;
+        unique_ptr<mutex[]> columnLocks;
+        vector<ColumnResult> totals;
+        unique_ptr<ofstream> out;  // Write stage, if any
+
+        atomic<size_t> rows{0};
+        atomic<bool> cancelled{false};
+        atomic<bool> failed{false};
+        exception_ptr failure;
+        mutex failureMutex;
+
+        RunState(const PipelineOptions& pipelineOptions, const CancellationToken* cancellation,
+                 bool quietOutput, CoroutineScheduler& workers, Sequencer& writeOrder)
+            : pipeline(pipelineOptions), token(cancellation),
+              quiet(quietOutput), scheduler(workers), sequencer(writeOrder),
+              slots(static_cast<ptrdiff_t>(pipelineOptions.chunksInFlight)) {}
+
+        void fail(exception_ptr error) {
+            lock_guard<mutex> lock(failureMutex);
+            if (!failure) {
+                failure = error;
+            }
+            failed.store(true);
+        }
+
+        [[nodiscard]] bool stopped() const {
+            return cancelled.load() || failed.load();
+        }
+    };
+
+    /**
+     * Parse and analyze stages of one chunk, fused: the parsed columns are
+     * added to the column accumulators while still in cache and freed
+     * before the next chunk
+     */
+    Task analyzeChunk(RunState& state, Chunk chunk) {
+        if (!state.stopped()) {
+            Console::QuietScope quietScope(state.quiet);
+            CancellationToken::Scope scope(state.token);
+            try {
+                CancellationToken::throwIfCancelled();
+                CSVTable part = CSVReader::parseRows(chunk.text, state.columnCount,
+                                                     state.pipeline.computeHashes);
+                string().swap(chunk.text);
+                state.rows.fetch_add(state.columnCount > 0 ? part.columns[0].size() : 0,
+                                     memory_order_relaxed);
+
+                // Columns are taken as their locks come free, starting at a
+                // different column per chunk; a worker blocks only when every
+                // column it still holds is busy
+                vector<bool> added(state.columnCount, false);
+                size_t remaining = state.columnCount;
+                bool block = false;
+                while (remaining > 0) {
+                    bool progressed = false;
+                    for (size_t k = 0; k < state.columnCount; ++k) {
+                        const size_t c = (chunk.index + k) % state.columnCount;
+                        if (added[c]) {
+                            continue;
+                        }
+                        unique_lock<mutex> lock(state.columnLocks[c], defer_lock);
+                        if (block) {
+                            lock.lock();
+                            block = false;
+                        } else if (!lock.try_lock()) {
+                            continue;
+                        }
+                        state.columns[c].add(part.columns[c],
+                                             state.pipeline.computeHashes ? &part.cellHashes[c] : nullptr);
+                        lock.unlock();
+                        vector<string>().swap(part.columns[c]);
+                        added[c] = true;
+                        --remaining;
+                        progressed = true;
+                    }
+                    block = !progressed;
+                }
+            } catch (const OperationCancelled&) {
+                state.cancelled.store(true);
+            } catch (...) {
+                state.fail(current_exception());
+            }
+        }
+        state.slots.release();
+        co_return;
+    }
+
+    /**
+     * Write stage of one column: its values are collected (and sorted) in
+     * parallel with other columns, then the column waits, suspended, for
+     * its turn in the output file
+     */
+    Task finishColumn(RunState& state, size_t column) {
+        ColumnResult& total = state.totals[column];
+        vector<string_view> sorted;
+        if (!state.failed.load()) {
+            CancellationToken::Scope scope(state.token);
+            try {
+                total = state.columns[column].finish();
+                if (state.out && state.pipeline.sortedValues) {
+                    const size_t sortThreads = max<size_t>(1, state.scheduler.size() / state.columnCount);
+                    sorted = SortDistinct::sortedViews(total.uniqueValues, sortThreads);
+                }
+            } catch (const OperationCancelled&) {
+                state.cancelled.store(true);
+            } catch (...) {
+                state.fail(current_exception());
+            }
+        }
+
+        if (state.out) {
+            co_await state.sequencer.turn(column);
+            if (!state.stopped()) {
+                try {
+                    if (state.pipeline.sortedValues) {
+                        ResultAggregator::writeFullResultsLine(*state.out, total, sorted);
+                    } else {
+                        ResultAggregator::writeFullResultsLine(*state.out, total, total.uniqueValues);
+                    }
+                    if (!*state.out) {
+                        throw runtime_error("Failed to write output file: " + state.pipeline.fullResultsFile);
+                    }
+                } catch (...) {
+                    state.fail(current_exception());
+                }
+            }
+            state.sequencer.advance();  // Always, or later columns never get their turn
+        }
+    }
+
+} // namespace
+
+PipelineExecutor::PipelineExecutor(size_t numThreads, AnalyzerOptions options, PipelineOptions pipeline)
+    : numThreads_(numThreads), options_(options), pipeline_(pipeline) {
+    if (numThreads_ == 0) {
+        numThreads_ = thread::hardware_concurrency();
+        if (numThreads_ == 0) {
+            numThreads_ = 8;  // Fallback
+        }
+    }
+    pipeline_.chunkBytes = max<size_t>(pipeline_.chunkBytes, 4096);
+    if (pipeline_.chunksInFlight == 0) {
+        pipeline_.chunksInFlight = 2 * numThreads_;
+    }
+    // Workers already keep every thread busy; no extra threads per sort
+    if (options_.sortThreads == 0) {
+        options_.sortThreads = 1;
+    }
+}
+
+vector<ColumnResult> PipelineExecutor::run(const string& filename) {
+    Console::out() << "Pipelined analysis: " << filename << " (" << numThreads_ << " workers, "
+         << pipeline_.chunkBytes / 1024 << " KB chunks, " << pipeline_.chunksInFlight
+         << " in flight)" << endl;
+
+    headers_.clear();
+    stats_ = PipelineStats();
+    auto start = steady_clock::now();
+
+    const CancellationToken* token = cancellation_ != nullptr
+                                     ? cancellation_
+                                     : CancellationToken::current();
+
+    // Every stage below ends in scheduler.wait(), so no coroutine outlives
+    // the state it refers to
+    CoroutineScheduler scheduler(numThreads_);
+    Sequencer sequencer(scheduler);
+    RunState state(pipeline_, token, Console::quiet(), scheduler, sequencer);
+
+    // Read stage: line-aligned chunks in file order. The header is split off
+    // and the column accumulators are set up before the first chunk is
+    // spawned, so chunks never run without them.
+    thread reader([&]() {
+        Console::QuietScope quietScope(state.quiet);
+        try {
+            CancellationToken::Scope scope(token);
+            string pending;
+            bool haveHeader = false;
+
+            auto emit = [&](string text) {
+                CancellationToken::throwIfCancelled();
+                if (!state.slots.try_acquire()) {
+                    auto waitStart = steady_clock::now();
+                    state.slots.acquire();
+                    stats_.readerBlockedSeconds += duration<double>(steady_clock::now() - waitStart).count();
+                }
+                if (state.stopped()) {
+                    state.slots.release();
+                    throw OperationCancelled();  // Workers stopped
+                }
+                stats_.bytes += text.size();
+                scheduler.spawn(analyzeChunk(state, Chunk{stats_.chunks++, std::move(text)}));
+            };
+            auto takeHeader = [&](size_t end) {
+                headers_ = CSVReader::parseLine(string_view(pending).substr(0, end));
+                Console::out() << "Detected " << headers_.size() << " columns" << endl;
+                state.columnCount = headers_.size();
+                state.columns.reserve(state.columnCount);
+                for (size_t c = 0; c < state.columnCount; ++c) {
+                    state.columns.emplace_back(c, options_);
+                }
+                state.columnLocks = make_unique<mutex[]>(state.columnCount);
+                haveHeader = true;
+            };
+
+            AsyncFileReader fileReader(pipeline_.io);
+            stats_.read = fileReader.read(filename, [&](const char* data, size_t size) {
+                pending.append(data, size);
+                if (!haveHeader) {
+                    const size_t newline = pending.find('\n');
+                    if (newline == string::npos) {
+                        return;
+                    }
+                    takeHeader(newline);
+                    pending.erase(0, newline + 1);
+                }
+
+                size_t begin = 0;
+                while (pending.size() - begin >= pipeline_.chunkBytes) {
+                    size_t cut = pending.rfind('\n', begin + pipeline_.chunkBytes - 1);
+                    if (cut == string::npos || cut < begin) {
+                        // A line longer than a chunk: cut after it
+                        cut = pending.find('\n', begin + pipeline_.chunkBytes);
+                        if (cut == string::npos) {
+                            break;
+                        }
+                    }
+                    emit(pending.substr(begin, cut + 1 - begin));
+                    begin = cut + 1;
+                }
+                pending.erase(0, begin);
+            });
+
+            if (!haveHeader && !pending.empty()) {
+                takeHeader(pending.size());
+                pending.clear();
+            }
+            if (!pending.empty()) {
+                emit(std::move(pending));
+            }
+        } catch (const OperationCancelled&) {
+            state.cancelled.store(true);
+        } catch (...) {
+            state.fail(current_exception());
+        }
+    });
+
+    reader.join();
+    scheduler.wait();
+
+    // Write stage, one coroutine per column
+    if (!state.failed.load()) {
+        state.totals.reserve(state.columnCount);
+        for (size_t c = 0; c < state.columnCount; ++c) {
+            state.totals.emplace_back(c);
+        }
+        if (!pipeline_.fullResultsFile.empty() && !state.cancelled.load()) {
+            state.out = make_unique<ofstream>(pipeline_.fullResultsFile);
+            if (!state.out->is_open()) {
+                throw runtime_error("Failed to open output file: " + pipeline_.fullResultsFile);
+            }
+            *state.out << ResultAggregator::kFullResultsHeader << "\n";
+        }
+        for (size_t c = 0; c < state.columnCount; ++c) {
+            scheduler.spawn(finishColumn(state, c));
+        }
+        scheduler.wait();
+    }
+
+    if (state.out) {
+        state.out->close();
+        if (state.stopped() || state.out->fail()) {
+            // A partial file would look like a complete one
+            error_code ec;
+            filesystem::remove(pipeline_.fullResultsFile, ec);
+        } else {
+            stats_.fullResultsWritten = true;
+        }
+    }
+
+    if (state.failure) {
+        rethrow_exception(state.failure);
+    }
+
+    stats_.rows = state.rows.load();
+    stats_.seconds = duration<double>(steady_clock::now() - start).count();
+    stats_.workerIdleSeconds = scheduler.idleSeconds();
+
+    vector<ColumnResult> totals = std::move(state.totals);
+    if (state.cancelled.load()) {
+        for (auto& total : totals) {
+            total.complete = false;
+        }
+        Console::out() << "Cancelled: " << totals.size() << " columns incomplete" << endl;
+    }
+    if (stats_.fullResultsWritten) {
+        Console::out() << "Full results saved to: " << pipeline_.fullResultsFile << endl;
+    }
+
+    Console::out() << "Pipeline: " << stats_.rows << " rows in " << stats_.chunks << " chunks, "
+         << "reader blocked " << stats_.readerBlockedSeconds * 1000.0 << " ms, "
+         << "workers idle " << stats_.workerIdleSeconds * 1000.0 << " ms" << endl;
+    return totals;
+}
@@ -0,0 +1,98 @@
+#ifndef COLUMNANALYZER_PIPELINEEXECUTOR_H
+#define COLUMNANALYZER_PIPELINEEXECUTOR_H
+
+#include <string>
+#include <vector>
+#include "AsyncFileReader.h"
+#include "CancellationToken.h"
+#include "ColumnAnalyzer.h"
+
+/**
+ * Pipeline settings
+ */
+struct PipelineOptions {
+    size_t chunkBytes = 1 << 20;   // Whole lines handed to a worker at a time
+    size_t chunksInFlight = 0;     // Chunks read but not yet analyzed (0 = 2 per worker)
+    bool computeHashes = false;    // Hash cells while parsing (--hash-once)
+    AsyncReadOptions io;           // Block reader of the read stage
+    std::string fullResultsFile;   // Write stage: full results CSV (empty = no write stage)
+    bool sortedValues = false;     // Write stage: values in ascending byte order
+};
+
+/**
+ * What one pipelined run did and where it waited
+ */
+struct PipelineStats {
+    size_t rows = 0;
+    size_t bytes = 0;                  // Data bytes after the header
+    size_t chunks = 0;
+    double seconds = 0.0;
+    double readerBlockedSeconds = 0.0; // Read stage waiting for a free slot (CPU-bound)
+    double workerIdleSeconds = 0.0;    // Workers with no coroutine to resume, summed (I/O-bound)
+    bool fullResultsWritten = false;   // Write stage wrote every column
+    ReadStats read;
+};
+
+/**
+ * Streaming read -> parse -> analyze -> write of one CSV file (strategy
+ * PIPELINE), with C++20 coroutines on a CoroutineScheduler
+ *
+ * A read thread cuts the file into line-aligned chunks and spawns one
+ * coroutine per chunk; at most chunksInFlight chunks are alive, so the
+ * reader stalls when analysis falls behind instead of materializing the
+ * whole table. A chunk coroutine parses its chunk and adds each column to
+ * that column's ColumnAccumulator, one index per column for the whole run
+ * instead of a value set per chunk. Once the file is read, one coroutine
+ * per column collects its values and, if fullResultsFile is set, waits for
+ * its turn to append the column to it: columns are written in order while
+ * later ones are still collected or sorted, and a coroutine waiting for
+ * its turn holds no thread. Reads overlap the CPU stages without running
+ * more than numThreads CPU-bound threads; the read thread spends its time
+ * blocked in I/O.
+ */
+class PipelineExecutor {
+public:
+    /**
+     * Constructor
+     * @param numThreads Workers (0 = hardware concurrency)
+     * @param options Options passed to ColumnAnalyzer for every chunk
+     * @param pipeline Chunking, queue depth and reader settings
+     */
+    explicit PipelineExecutor(size_t numThreads = 8,
+                              AnalyzerOptions options = {},
+                              PipelineOptions pipeline = {});
+
+    /**
+     * Analyze a file
+     * @param filename Path to CSV file (header line first)
+     * @return One result per column; complete = false if cancelled
+     * @throws std::runtime_error if the file cannot be read
+     */
+    std::vector<ColumnResult> run(const std::string& filename);
+
+    /**
+     * Stop cooperatively when the token is cancelled or its deadline passes
+     * @param token Cancellation token (nullptr = the caller's current token)
+     */
+    void setCancellation(const CancellationToken* token) { cancellation_ = token; }
+
+    /**
+     * Header names of the last run
+     */
+    [[nodiscard]] const std::vector<std::string>& headers() const { return headers_; }
+
+    /**
+     * Measurements of the last run
+     */
+    [[nodiscard]] const PipelineStats& stats() const { return stats_; }
+
+private:
+    size_t numThreads_;
+    AnalyzerOptions options_;
+    PipelineOptions pipeline_;
+    const CancellationToken* cancellation_ = nullptr;
+    std::vector<std::string> headers_;
+    PipelineStats stats_;
+};
+
+#endif //COLUMNANALYZER_PIPELINEEXECUTOR_H
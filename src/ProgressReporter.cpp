@@ -0,0 +1,122 @@
+#include "ProgressReporter.h"
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+using namespace std;
+using namespace chrono;
+
+ProgressCounters ProgressReporter::counters_;
+
+ProgressReporter::ProgressReporter(milliseconds interval, bool console, string statusFile)
+    : interval_(interval), console_(console), statusFile_(std::move(statusFile)) {
+    thread_ = thread([this]() { loop(); });
+}
+
+ProgressReporter::~ProgressReporter() {
+    {
+        lock_guard<mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    thread_.join();
+
+    if (phase_.active) {
+        endPhase();
+    }
+}
+
+void ProgressReporter::beginPhase(const string& name, size_t totalRows,
+                                  size_t totalBytes, size_t totalColumns) {
+    lock_guard<mutex> lock(mutex_);
+    counters_.reset();
+    phase_.name = name;
+    phase_.totalRows = totalRows;
+    phase_.totalBytes = totalBytes;
+    phase_.totalColumns = totalColumns;
+    phase_.start = steady_clock::now();
+    phase_.active = true;
+}
+
+void ProgressReporter::endPhase() {
+    lock_guard<mutex> lock(mutex_);
+    if (!phase_.active) {
+        return;
+    }
+    report(true);
+    phase_.active = false;
+}
+
+void ProgressReporter::loop() {
+    unique_lock<mutex> lock(mutex_);
+    while (!stopping_) {
+        cv_.wait_for(lock, interval_, [this]() { return stopping_; });
+        if (!stopping_ && phase_.active) {
+            report(false);
+        }
+    }
+}
+
+void ProgressReporter::report(bool done) {
+    const size_t rows = counters_.rows.load(memory_order_relaxed);
+    const size_t bytes = counters_.bytes.load(memory_order_relaxed);
+    const size_t columns = counters_.columns.load(memory_order_relaxed);
+    const double elapsed = duration<double>(steady_clock::now() - phase_.start).count();
+
+    const double rowsPerSecond = elapsed > 0.0 ? static_cast<double>(rows) / elapsed : 0.0;
+    const double bytesPerSecond = elapsed > 0.0 ? static_cast<double>(bytes) / elapsed : 0.0;
+
+    // Fraction done from the most informative total
+    double fraction = -1.0;
+    if (phase_.totalBytes > 0 && bytes > 0) {
+        fraction = static_cast<double>(bytes) / static_cast<double>(phase_.totalBytes);
+    } else if (phase_.totalRows > 0) {
+        fraction = static_cast<double>(rows) / static_cast<double>(phase_.totalRows);
+    }
+    if (done) {
+        fraction = 1.0;
+    }
+    const double eta = fraction > 0.0 ? elapsed * (1.0 - fraction) / fraction : -1.0;
+
+    if (console_) {
+        ostringstream line;
+        line << fixed << setprecision(1);
+        line << "[" << phase_.name << "] " << rows;
+        if (phase_.totalRows > 0) line << "/" << phase_.totalRows;
+        line << " rows";
+        if (fraction >= 0.0) line << " (" << fraction * 100.0 << "%)";
+        line << ", " << rowsPerSecond / 1e6 << " Mrows/s";
+        if (bytes > 0) line << ", " << bytesPerSecond / (1024.0 * 1024.0) << " MB/s";
+        if (phase_.totalColumns > 0) line << ", columns " << columns << "/" << phase_.totalColumns;
+        if (done) {
+            line << ", done in " << elapsed << " s";
+        } else if (eta >= 0.0) {
+            line << ", ETA " << eta << " s";
+        }
+        cout << line.str() << "\n" << flush;
+    }
+
+    if (!statusFile_.empty()) {
+        // Write a temporary file and rename it, so readers never see a partial status
+        const string tmp = statusFile_ + ".tmp";
+        {
+            ofstream file(tmp, ios::trunc);
+            file << fixed << setprecision(3);
+            file << "{\"phase\":\"" << phase_.name << "\""
+                 << ",\"done\":" << (done ? "true" : "false")
+                 << ",\"rows\":" << rows
+                 << ",\"total_rows\":" << phase_.totalRows
+                 << ",\"bytes\":" << bytes
+                 << ",\"total_bytes\":" << phase_.totalBytes
+                 << ",\"columns\":" << columns
+                 << ",\"total_columns\":" << phase_.totalColumns
+                 << ",\"elapsed_seconds\":" << elapsed
+                 << ",\"rows_per_second\":" << rowsPerSecond
+                 << ",\"bytes_per_second\":" << bytesPerSecond
+                 << ",\"eta_seconds\":" << eta << "}\n";
+        }
+        rename(tmp.c_str(), statusFile_.c_str());
+    }
+}
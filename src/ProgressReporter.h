@@ -0,0 +1,113 @@
+#ifndef COLUMNANALYZER_PROGRESSREPORTER_H
+#define COLUMNANALYZER_PROGRESSREPORTER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/**
+ * Process-wide progress counters
+ * Workers publish in chunks with relaxed atomic adds; each counter sits on
+ * its own cache line so readers and other counters do not contend
+ */
+struct ProgressCounters {
+    alignas(64) std::atomic<size_t> rows{0};
+    alignas(64) std::atomic<size_t> bytes{0};
+    alignas(64) std::atomic<size_t> columns{0};
+
+    void addRows(size_t n) { rows.fetch_add(n, std::memory_order_relaxed); }
+    void addBytes(size_t n) { bytes.fetch_add(n, std::memory_order_relaxed); }
+    void addColumns(size_t n) { columns.fetch_add(n, std::memory_order_relaxed); }
+
+    void reset() {
+        rows.store(0, std::memory_order_relaxed);
+        bytes.store(0, std::memory_order_relaxed);
+        columns.store(0, std::memory_order_relaxed);
+    }
+};
+
+/**
+ * Background thread that samples ProgressCounters at a fixed interval and
+ * prints rows, rate, bytes/s and ETA, or writes them to a status file
+ */
+class ProgressReporter {
+public:
+    /**
+     * Rows published per chunk by scanning loops
+     */
+    static constexpr size_t kChunkRows = 1 << 16;
+
+    /**
+     * Counters shared by all readers, generators and analyzers
+     */
+    static ProgressCounters& counters() { return counters_; }
+
+    /**
+     * Constructor, starts the reporting thread
+     * @param interval Sampling interval
+     * @param console Print a progress line to stdout at every sample
+     * @param statusFile JSON status file rewritten at every sample (empty = none)
+     */
+    explicit ProgressReporter(std::chrono::milliseconds interval = std::chrono::milliseconds(1000),
+                              bool console = true,
+                              std::string statusFile = "");
+
+    /**
+     * Stops the reporting thread and writes the final status
+     */
+    ~ProgressReporter();
+
+    ProgressReporter(const ProgressReporter&) = delete;
+    ProgressReporter& operator=(const ProgressReporter&) = delete;
+
+    /**
+     * Start a phase: resets counters and sets the expected totals
+     * @param name Phase name ("read", "analyze", "generate")
+     * @param totalRows Expected rows (0 = unknown)
+     * @param totalBytes Expected bytes (0 = unknown)
+     * @param totalColumns Expected columns (0 = unknown)
+     */
+    void beginPhase(const std::string& name, size_t totalRows,
+                    size_t totalBytes = 0, size_t totalColumns = 0);
+
+    /**
+     * Finish the current phase and report its final numbers
+     */
+    void endPhase();
+
+private:
+    struct Phase {
+        std::string name;
+        size_t totalRows = 0;
+        size_t totalBytes = 0;
+        size_t totalColumns = 0;
+        std::chrono::steady_clock::time_point start;
+        bool active = false;
+    };
+
+    static ProgressCounters counters_;
+
+    std::chrono::milliseconds interval_;
+    bool console_;
+    std::string statusFile_;
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stopping_ = false;
+    Phase phase_;
+    std::thread thread_;
+
+    void loop();
+
+    /**
+     * Sample counters and emit one report (caller holds mutex_)
+     * @param done The phase has just finished
+     */
+    void report(bool done);
+};
+
+#endif //COLUMNANALYZER_PROGRESSREPORTER_H
@@ -1,11 +1,23 @@
 #include "ResultAggregator.h"
+#include "ColumnarFile.h"
+#include "SortDistinct.h"
 #include <iostream>
 #include <fstream>
 #include <algorithm>
 #include <iomanip>
+#include <sstream>
+#include <cmath>
+#include <thread>
 
 using namespace std;
 
+ResultAggregator::ResultAggregator(bool sortedValues, size_t sortThreads)
+    : sortedValues_(sortedValues), sortThreads_(sortThreads) {
+    if (sortThreads_ == 0) {
+        sortThreads_ = max<size_t>(thread::hardware_concurrency(), 1);
+    }
+}
+
 void ResultAggregator::printResults(const vector<ColumnResult>& results) const {
     cout << "\n=== Results ===" << endl;
     cout << "Total columns: " << results.size() << endl << endl;
@@ -14,8 +26,16 @@ void ResultAggregator::printResults(const vector<ColumnResult>& results) const {
 
     for (const auto& result : results) {
         totalUniqueValues += result.uniqueCount;
-        cout << "Column " << setw(3) << result.columnIndex
-             << ": " << setw(6) << result.uniqueCount << " unique values" << endl;
+        cout << "Column " << setw(3) << result.columnIndex;
+        if (!result.columnName.empty()) {
+            cout << " (" << result.columnName << ")";
+        }
+        cout << ": " << setw(6) << result.uniqueCount << " unique values";
+        if (result.estimate.sampled) {
+            cout << " (estimated, 95% CI " << llround(result.estimate.lower)
+                 << "-" << llround(result.estimate.upper) << ")";
+        }
+        cout << endl;
     }
 
     cout << "\n" << string(50, '-') << endl;
@@ -34,9 +54,19 @@ void ResultAggregator::printDetailedResults(const vector<ColumnResult>& results,
             cout << "  Sample values (first " << min(samplesPerColumn, result.uniqueCount) << "):" << endl;
 
             size_t count = 0;
-            for (const auto& value : result.uniqueValues) {
-                cout << "    - " << value << endl;
-                if (++count >= samplesPerColumn) break;
+            if (sortedValues_) {
+                // Only the first few are shown: no need to sort the rest
+                vector<string_view> views(result.uniqueValues.begin(), result.uniqueValues.end());
+                const size_t shown = min(samplesPerColumn, views.size());
+                partial_sort(views.begin(), views.begin() + static_cast<ptrdiff_t>(shown), views.end());
+                for (; count < shown; ++count) {
+                    cout << "    - " << views[count] << endl;
+                }
+            } else {
+                for (const auto& value : result.uniqueValues) {
+                    cout << "    - " << value << endl;
+                    if (++count >= samplesPerColumn) break;
+                }
             }
         }
     }
@@ -51,8 +81,14 @@ void ResultAggregator::saveCountsToFile(const vector<ColumnResult>& results,
 
     file << "Column,UniqueCount" << endl;
 
+    // Columns merged across files are identified by header name
     for (const auto& result : results) {
-        file << result.columnIndex << "," << result.uniqueCount << endl;
+        if (result.columnName.empty()) {
+            file << result.columnIndex;
+        } else {
+            file << result.columnName;
+        }
+        file << "," << result.uniqueCount << endl;
     }
 
     // RAII: destructor closes file automatically on scope exit
@@ -67,28 +103,26 @@ void ResultAggregator::saveFullResultsToFile(const vector<ColumnResult>& results
     }
 
     // Format: Column,UniqueCount,UniqueValues (separated by semicolon)
-    file << "Column,UniqueCount,UniqueValues" << endl;
+    file << kFullResultsHeader << "\n";
 
     for (const auto& result : results) {
-        file << result.columnIndex << "," << result.uniqueCount << ",";
-
-        // Write all unique values separated by semicolon
-        bool first = true;
-        for (const auto& value : result.uniqueValues) {
-            if (!first) {
-                file << ";";
-            }
-            file << value;
-            first = false;
+        if (sortedValues_) {
+            writeFullResultsLine(file, result, SortDistinct::sortedViews(result.uniqueValues, sortThreads_));
+        } else {
+            writeFullResultsLine(file, result, result.uniqueValues);
         }
-
-        file << endl;
     }
 
     // RAII: destructor closes file automatically on scope exit
     cout << "Full results saved to: " << filename << endl;
 }
 
+void ResultAggregator::saveBinaryResultsToFile(const vector<ColumnResult>& results,
+                                               const string& filename) const {
+    ColumnarFileWriter::write(results, filename, sortedValues_ ? sortThreads_ : 0);
+    cout << "Binary results saved to: " << filename << endl;
+}
+
 void ResultAggregator::printSummary(const vector<ColumnResult>& results) const {
     if (results.empty()) {
         cout << "No results to summarize" << endl;
@@ -114,4 +148,257 @@ void ResultAggregator::printSummary(const vector<ColumnResult>& results) const {
     cout << "Average per column:      " << fixed << setprecision(1) << avgUnique << endl;
     cout << "Min unique in column:    " << minUnique << endl;
     cout << "Max unique in column:    " << maxUnique << endl;
-}
\ No newline at end of file
+
+    // Fingerprint backend: chance that some count is short by a collision
+    // (union bound over columns), and what a verification pass found
+    unsigned bits = 0;
+    double collisionProbability = 0.0;
+    size_t fingerprintBytes = 0;
+    size_t verified = 0;
+    size_t collisions = 0;
+    for (const auto& result : results) {
+        if (result.fingerprints.bits() == 0) continue;
+        bits = result.fingerprints.bits();
+        collisionProbability += FingerprintSet::collisionProbability(result.uniqueCount, bits);
+        fingerprintBytes += result.fingerprints.memoryBytes();
+        if (result.fingerprintsVerified) {
+            ++verified;
+            collisions += result.fingerprintCollisions;
+        }
+    }
+    if (bits != 0) {
+        cout << "Fingerprint width:       " << bits << " bits ("
+             << setprecision(1) << static_cast<double>(fingerprintBytes) / (1024.0 * 1024.0) << " MB)" << endl;
+        cout << "Collision probability:   " << scientific << setprecision(2)
+             << min(collisionProbability, 1.0) << fixed << endl;
+        if (verified > 0) {
+            cout << "Collisions found:        " << collisions << " (" << verified << " of "
+                 << results.size() << " columns verified)" << endl;
+        }
+    }
+}
+
+namespace {
+
+    string formatHistogram(const ColumnStatistics& stats) {
+        string out;
+        for (size_t bucket = 0; bucket < stats.lengthHistogram.size(); ++bucket) {
+            if (stats.lengthHistogram[bucket] == 0) continue;
+            if (!out.empty()) out += " ";
+            out += ColumnStatistics::lengthBucketLabel(bucket) + ":" +
+                   to_string(stats.lengthHistogram[bucket]);
+        }
+        return out;
+    }
+
+} // namespace
+
+void ResultAggregator::printStatistics(const vector<ColumnResult>& results) const {
+    cout << "\n=== Column Statistics ===" << endl;
+
+    for (const auto& result : results) {
+        const auto& stats = result.statistics;
+        if (stats.computed == STAT_NONE) continue;
+
+        cout << "\nColumn " << result.columnIndex << ":" << endl;
+        cout << "  Rows:         " << stats.rowCount << endl;
+        cout << "  Distinct:     " << result.uniqueCount << endl;
+        if (stats.computed & STAT_NULLS) {
+            cout << "  Null/empty:   " << stats.nullCount << endl;
+        }
+        if (stats.computed & STAT_MINMAX) {
+            cout << "  Min:          " << stats.minValue << endl;
+            cout << "  Max:          " << stats.maxValue << endl;
+        }
+        if (stats.computed & STAT_LENGTHS) {
+            cout << "  Lengths:      " << formatHistogram(stats) << endl;
+        }
+        if (stats.computed & STAT_NUMERIC) {
+            cout << "  Numeric:      " << stats.numericCount << " values" << endl;
+            if (stats.numericCount > 0) {
+                cout << "  Sum:          " << stats.sum << endl;
+                cout << "  Mean:         " << stats.mean << endl;
+                cout << "  Std dev:      " << stats.stddev << endl;
+            }
+        }
+    }
+}
+
+void ResultAggregator::saveStatisticsToFile(const vector<ColumnResult>& results,
+                                            const string& filename) const {
+    ofstream file(filename);
+    if (!file.is_open()) {
+        throw runtime_error("Failed to open output file: " + filename);
+    }
+
+    file << "Column,Rows,UniqueCount,NullCount,Min,Max,NumericCount,Sum,Mean,StdDev,LengthHistogram" << endl;
+    file << setprecision(15);
+
+    for (const auto& result : results) {
+        const auto& stats = result.statistics;
+        file << result.columnIndex << "," << stats.rowCount << "," << result.uniqueCount << ",";
+
+        if (stats.computed & STAT_NULLS) file << stats.nullCount;
+        file << ",";
+        if (stats.computed & STAT_MINMAX) file << stats.minValue << "," << stats.maxValue;
+        else file << ",";
+        file << ",";
+        if (stats.computed & STAT_NUMERIC) {
+            file << stats.numericCount << "," << stats.sum << "," << stats.mean << "," << stats.stddev;
+        } else {
+            file << ",,,";
+        }
+        file << ",";
+        if (stats.computed & STAT_LENGTHS) file << formatHistogram(stats);
+
+        file << endl;
+    }
+
+    // RAII: destructor closes file automatically on scope exit
+    cout << "Statistics saved to: " << filename << endl;
+}
+
+void ResultAggregator::printEstimates(const vector<ColumnResult>& results) const {
+    cout << "\n=== Sample Estimates ===" << endl;
+
+    for (const auto& result : results) {
+        const auto& estimate = result.estimate;
+        if (!estimate.sampled) continue;
+
+        cout << "\nColumn " << result.columnIndex;
+        if (!result.columnName.empty()) {
+            cout << " (" << result.columnName << ")";
+        }
+        cout << ":" << endl;
+        cout << "  Distinct in sample: " << estimate.sampleDistinct << endl;
+        cout << "  Estimated distinct: " << llround(estimate.estimate)
+             << " [" << llround(estimate.lower) << ", " << llround(estimate.upper) << "]" << endl;
+
+        for (const auto& top : estimate.topValues) {
+            cout << "    " << top.value << ": " << fixed << setprecision(2)
+                 << top.share * 100.0 << "% [" << top.lower * 100.0 << "%, "
+                 << top.upper * 100.0 << "%]" << endl;
+        }
+    }
+}
+
+void ResultAggregator::saveEstimatesToFile(const vector<ColumnResult>& results,
+                                           const string& filename) const {
+    ofstream file(filename);
+    if (!file.is_open()) {
+        throw runtime_error("Failed to open output file: " + filename);
+    }
+
+    // TopValues: value=share[lower;upper] separated by semicolon
+    file << "Column,SampleDistinct,Estimate,Lower95,Upper95,TopValues" << endl;
+    file << setprecision(6);
+
+    for (const auto& result : results) {
+        const auto& estimate = result.estimate;
+        file << result.columnIndex << "," << estimate.sampleDistinct << ","
+             << llround(estimate.estimate) << "," << llround(estimate.lower) << ","
+             << llround(estimate.upper) << ",";
+
+        bool first = true;
+        for (const auto& top : estimate.topValues) {
+            if (!first) file << ";";
+            file << top.value << "=" << top.share << "[" << top.lower << ";" << top.upper << "]";
+            first = false;
+        }
+        file << endl;
+    }
+
+    // RAII: destructor closes file automatically on scope exit
+    cout << "Estimates saved to: " << filename << endl;
+}
+
+namespace {
+
+    string groupLabel(const ColumnGroup& columns) {
+        string label;
+        for (size_t column : columns) {
+            if (!label.empty()) label += "+";
+            label += to_string(column);
+        }
+        return label;
+    }
+
+} // namespace
+
+void ResultAggregator::printCombinations(const vector<CombinationResult>& results) const {
+    cout << "\n=== Column Combinations ===" << endl;
+
+    for (const auto& result : results) {
+        cout << "Columns " << setw(12) << left << groupLabel(result.columns) << right << ": ";
+        if (!result.complete) {
+            cout << "incomplete" << endl;
+            continue;
+        }
+        if (result.mode == CombinationMode::HLL) {
+            cout << "~" << result.distinctCount << " distinct tuples (HLL, +/-"
+                 << fixed << setprecision(2) << result.relativeError * 100.0 << "%)";
+        } else {
+            cout << result.distinctCount << " distinct tuples";
+        }
+        cout << " of " << result.rowCount << " rows";
+        if (result.isUnique()) {
+            cout << " - candidate key";
+        }
+        cout << endl;
+    }
+}
+
+void ResultAggregator::saveCombinationsToFile(const vector<CombinationResult>& results,
+                                              const string& filename) const {
+    ofstream file(filename);
+    if (!file.is_open()) {
+        throw runtime_error("Failed to open output file: " + filename);
+    }
+
+    file << "Columns,Rows,Distinct,Mode,RelativeError,CandidateKey" << endl;
+    for (const auto& result : results) {
+        if (!result.complete) continue;
+        file << groupLabel(result.columns) << "," << result.rowCount << ","
+             << result.distinctCount << ","
+             << (result.mode == CombinationMode::HLL ? "hll" : "exact") << ","
+             << result.relativeError << ","
+             << (result.isUnique() ? "yes" : "no") << endl;
+    }
+
+    cout << "Combinations saved to: " << filename << endl;
+}
+
+void ResultAggregator::printPerfCounters(const vector<PerfPhase>& phases,
+                                         const string& error) const {
+    cout << "\n=== Performance Counters ===" << endl;
+    if (!error.empty()) {
+        cout << "Hardware counters unavailable: " << error << endl;
+    }
+
+    auto cell = [](bool valid, double value, int precision) {
+        ostringstream out;
+        if (valid) {
+            out << fixed << setprecision(precision) << value;
+        } else {
+            out << "n/a";
+        }
+        return out.str();
+    };
+
+    cout << left << setw(14) << "Phase" << right << setw(10) << "Wall ms" << setw(10) << "CPU ms"
+         << setw(8) << "IPC" << setw(12) << "Cycles/row" << setw(12) << "Instr/row"
+         << setw(14) << "CacheMiss/row" << setw(15) << "BranchMiss/row" << endl;
+
+    for (const auto& phase : phases) {
+        const auto& s = phase.sample;
+        cout << left << setw(14) << phase.name << right
+             << setw(10) << cell(true, s.seconds * 1000.0, 1)
+             << setw(10) << cell(s.has(PERF_TASK_CLOCK), static_cast<double>(s[PERF_TASK_CLOCK]) / 1e6, 1)
+             << setw(8) << cell(s.has(PERF_CYCLES) && s.has(PERF_INSTRUCTIONS), s.ipc(), 2)
+             << setw(12) << cell(s.has(PERF_CYCLES), s.perRow(PERF_CYCLES, phase.rows), 1)
+             << setw(12) << cell(s.has(PERF_INSTRUCTIONS), s.perRow(PERF_INSTRUCTIONS, phase.rows), 1)
+             << setw(14) << cell(s.has(PERF_CACHE_MISSES), s.perRow(PERF_CACHE_MISSES, phase.rows), 3)
+             << setw(15) << cell(s.has(PERF_BRANCH_MISSES), s.perRow(PERF_BRANCH_MISSES, phase.rows), 3)
+             << endl;
+    }
+}
@@ -1,9 +1,12 @@
 #ifndef COLUMNANALYZER_RESULTAGGREGATOR_H
 #define COLUMNANALYZER_RESULTAGGREGATOR_H
 
+#include <ostream>
 #include <vector>
 #include <string>
 #include "ColumnAnalyzer.h"
+#include "CombinationAnalyzer.h"
+#include "PerfCounters.h"
 
 /**
  * Analysis results aggregator
@@ -11,6 +14,15 @@
  */
 class ResultAggregator {
 public:
+    /**
+     * Constructor
+     * @param sortedValues Write and print unique values in ascending byte
+     *                     order, so output is identical across runs and
+     *                     strategies (default: set iteration order)
+     * @param sortThreads Threads sorting one column's values (0 = hardware concurrency)
+     */
+    explicit ResultAggregator(bool sortedValues = false, size_t sortThreads = 0);
+
     /**
      * Print results to console
      * @param results Analysis results for all columns
@@ -18,7 +30,7 @@ public:
     void printResults(const std::vector<ColumnResult>& results) const;
 
     /**
-     * Print results with sample unique values
+     * Print results with sample unique values (the smallest ones if sorted)
      * @param results Analysis results
      * @param samplesPerColumn Number of samples per column
      */
@@ -42,10 +54,104 @@ public:
                                const std::string& filename) const;
 
     /**
-     * Print summary statistics
+     * Header line of the full results CSV
+     */
+    static constexpr const char* kFullResultsHeader = "Column,UniqueCount,UniqueValues";
+
+    /**
+     * Write one column's line of the full results CSV: index, count and the
+     * values separated by semicolons (lets a streaming writer emit columns
+     * as they finish)
+     * @param out Output stream, after the header line
+     * @param result Column result
+     * @param values Its unique values in output order (strings or string_views)
+     */
+    template <typename Values>
+    static void writeFullResultsLine(std::ostream& out, const ColumnResult& result,
+                                     const Values& values) {
+        out << result.columnIndex << "," << result.uniqueCount << ",";
+        bool first = true;
+        for (const auto& value : values) {
+            if (!first) {
+                out << ";";
+            }
+            out << value;
+            first = false;
+        }
+        out << "\n";
+    }
+
+    /**
+     * Save complete lists of unique values in the binary columnar format
+     * (see ColumnarFileWriter); values may contain any bytes
+     * @param results Analysis results
+     * @param filename Output file path
+     */
+    void saveBinaryResultsToFile(const std::vector<ColumnResult>& results,
+                                 const std::string& filename) const;
+
+    /**
+     * Print summary statistics; for the fingerprint backend also the
+     * fingerprint width, the probability of a collision and verified
+     * collisions
      * @param results Analysis results
      */
     void printSummary(const std::vector<ColumnResult>& results) const;
+
+    /**
+     * Print per-column statistics (null count, min/max, lengths, numeric)
+     * @param results Analysis results
+     */
+    void printStatistics(const std::vector<ColumnResult>& results) const;
+
+    /**
+     * Save per-column statistics
+     * @param results Analysis results
+     * @param filename Output file path
+     */
+    void saveStatisticsToFile(const std::vector<ColumnResult>& results,
+                              const std::string& filename) const;
+
+    /**
+     * Print sample-based estimates (distinct count and frequent values with
+     * 95% confidence intervals)
+     * @param results Analysis results with estimates
+     */
+    void printEstimates(const std::vector<ColumnResult>& results) const;
+
+    /**
+     * Save sample-based estimates
+     * @param results Analysis results with estimates
+     * @param filename Output file path
+     */
+    void saveEstimatesToFile(const std::vector<ColumnResult>& results,
+                             const std::string& filename) const;
+
+    /**
+     * Print distinct tuple counts of column combinations
+     * @param results Combination results
+     */
+    void printCombinations(const std::vector<CombinationResult>& results) const;
+
+    /**
+     * Save distinct tuple counts of column combinations
+     * @param results Combination results
+     * @param filename Output file path
+     */
+    void saveCombinationsToFile(const std::vector<CombinationResult>& results,
+                                const std::string& filename) const;
+
+    /**
+     * Print hardware counters per phase as IPC and events per row
+     * @param phases Measured phases in run order
+     * @param error Why hardware counters were unavailable (empty if they were)
+     */
+    void printPerfCounters(const std::vector<PerfPhase>& phases,
+                           const std::string& error) const;
+
+private:
+    bool sortedValues_;
+    size_t sortThreads_;
 };
 
 #endif //COLUMNANALYZER_RESULTAGGREGATOR_H
@@ -0,0 +1,261 @@
+#include "RoaringBitmap.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+using namespace std;
+
+namespace {
+    template <typename T>
+    void append(string& out, T value) {
+        out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    template <typename T>
+    T take(string_view& in) {
+        if (in.size() < sizeof(T)) {
+            throw runtime_error("Truncated roaring bitmap");
+        }
+        T value;
+        memcpy(&value, in.data(), sizeof(T));
+        in.remove_prefix(sizeof(T));
+        return value;
+    }
+} // namespace
+
+uint32_t RoaringBitmap::popcount(const uint64_t* words, size_t count) {
+    uint32_t total = 0;
+    for (size_t i = 0; i < count; ++i) {
+        total += static_cast<uint32_t>(__builtin_popcountll(words[i]));
+    }
+    return total;
+}
+
+void RoaringBitmap::Container::toBitmap() {
+    bits.assign(kBitmapWords, 0);
+    for (uint16_t low : array) {
+        bits[low >> 6] |= uint64_t{1} << (low & 63);
+    }
+    array.clear();
+    array.shrink_to_fit();
+}
+
+void RoaringBitmap::Container::toArrayIfSmall() {
+    if (!isBitmap() || cardinality > kArrayMax) {
+        return;
+    }
+    array.clear();
+    array.reserve(cardinality);
+    for (size_t w = 0; w < kBitmapWords; ++w) {
+        for (uint64_t word = bits[w]; word != 0; word &= word - 1) {
+            array.push_back(static_cast<uint16_t>(w * 64 + __builtin_ctzll(word)));
+        }
+    }
+    bits.clear();
+    bits.shrink_to_fit();
+}
+
+RoaringBitmap::Container& RoaringBitmap::containerFor(uint16_t key) {
+    // Low-cardinality columns hit the same container every time
+    if (!containers_.empty() && containers_.back().key == key) {
+        return containers_.back();
+    }
+    auto it = lower_bound(containers_.begin(), containers_.end(), key,
+                          [](const Container& c, uint16_t k) { return c.key < k; });
+    if (it == containers_.end() || it->key != key) {
+        Container container;
+        container.key = key;
+        it = containers_.insert(it, std::move(container));
+    }
+    return *it;
+}
+
+const RoaringBitmap::Container* RoaringBitmap::findContainer(uint16_t key) const {
+    auto it = lower_bound(containers_.begin(), containers_.end(), key,
+                          [](const Container& c, uint16_t k) { return c.key < k; });
+    return it != containers_.end() && it->key == key ? &*it : nullptr;
+}
+
+RoaringBitmap RoaringBitmap::fromBits(const uint64_t* words, size_t wordCount) {
+    RoaringBitmap bitmap;
+    for (size_t start = 0; start < wordCount; start += kBitmapWords) {
+        const size_t count = min(kBitmapWords, wordCount - start);
+        const uint32_t cardinality = popcount(words + start, count);
+        if (cardinality == 0) {
+            continue;
+        }
+
+        Container container;
+        container.key = static_cast<uint16_t>(start / kBitmapWords);
+        container.cardinality = cardinality;
+        container.bits.assign(kBitmapWords, 0);
+        copy(words + start, words + start + count, container.bits.begin());
+        container.toArrayIfSmall();
+        bitmap.containers_.push_back(std::move(container));
+    }
+    return bitmap;
+}
+
+void RoaringBitmap::add(uint32_t value) {
+    Container& container = containerFor(static_cast<uint16_t>(value >> 16));
+    const auto low = static_cast<uint16_t>(value & 0xFFFF);
+
+    if (container.isBitmap()) {
+        uint64_t& word = container.bits[low >> 6];
+        const uint64_t bit = uint64_t{1} << (low & 63);
+        container.cardinality += (word & bit) == 0;
+        word |= bit;
+        return;
+    }
+
+    auto it = lower_bound(container.array.begin(), container.array.end(), low);
+    if (it != container.array.end() && *it == low) {
+        return;
+    }
+    container.array.insert(it, low);
+    if (++container.cardinality > kArrayMax) {
+        container.toBitmap();
+    }
+}
+
+bool RoaringBitmap::contains(uint32_t value) const {
+    const Container* container = findContainer(static_cast<uint16_t>(value >> 16));
+    if (container == nullptr) {
+        return false;
+    }
+    const auto low = static_cast<uint16_t>(value & 0xFFFF);
+    if (container->isBitmap()) {
+        return (container->bits[low >> 6] >> (low & 63)) & 1;
+    }
+    return binary_search(container->array.begin(), container->array.end(), low);
+}
+
+uint64_t RoaringBitmap::cardinality() const {
+    uint64_t total = 0;
+    for (const auto& container : containers_) {
+        total += container.cardinality;
+    }
+    return total;
+}
+
+void RoaringBitmap::merge(const RoaringBitmap& other) {
+    for (const auto& source : other.containers_) {
+        Container& target = containerFor(source.key);
+
+        if (target.isBitmap() || source.isBitmap() ||
+            target.cardinality + source.cardinality > kArrayMax) {
+            if (!target.isBitmap()) {
+                target.toBitmap();
+            }
+            if (source.isBitmap()) {
+                for (size_t w = 0; w < kBitmapWords; ++w) {
+                    target.bits[w] |= source.bits[w];
+                }
+            } else {
+                for (uint16_t low : source.array) {
+                    target.bits[low >> 6] |= uint64_t{1} << (low & 63);
+                }
+            }
+            target.cardinality = popcount(target.bits.data(), kBitmapWords);
+            target.toArrayIfSmall();
+        } else {
+            vector<uint16_t> merged;
+            merged.reserve(target.array.size() + source.array.size());
+            set_union(target.array.begin(), target.array.end(),
+                      source.array.begin(), source.array.end(),
+                      back_inserter(merged));
+            target.array = std::move(merged);
+            target.cardinality = static_cast<uint32_t>(target.array.size());
+        }
+    }
+}
+
+string RoaringBitmap::serialize() const {
+    string out;
+    append(out, static_cast<uint32_t>(containers_.size()));
+    for (const auto& container : containers_) {
+        append(out, container.key);
+        append(out, static_cast<uint8_t>(container.isBitmap()));
+        append(out, container.cardinality);
+        if (container.isBitmap()) {
+            out.append(reinterpret_cast<const char*>(container.bits.data()),
+                       kBitmapWords * sizeof(uint64_t));
+        } else {
+            out.append(reinterpret_cast<const char*>(container.array.data()),
+                       container.array.size() * sizeof(uint16_t));
+        }
+    }
+    return out;
+}
+
+RoaringBitmap RoaringBitmap::deserialize(string_view bytes) {
+    RoaringBitmap bitmap;
+    const auto count = take<uint32_t>(bytes);
+
+    for (uint32_t i = 0; i < count; ++i) {
+        Container container;
+        container.key = take<uint16_t>(bytes);
+        const auto kind = take<uint8_t>(bytes);
+        container.cardinality = take<uint32_t>(bytes);
+
+        if (!bitmap.containers_.empty() && bitmap.containers_.back().key >= container.key) {
+            throw runtime_error("Roaring bitmap containers out of order");
+        }
+
+        if (kind == 1) {
+            container.bits.resize(kBitmapWords);
+            for (auto& word : container.bits) {
+                word = take<uint64_t>(bytes);
+            }
+            if (popcount(container.bits.data(), kBitmapWords) != container.cardinality) {
+                throw runtime_error("Roaring bitmap cardinality mismatch");
+            }
+            container.toArrayIfSmall();
+        } else if (kind == 0 && container.cardinality <= kArrayMax) {
+            container.array.resize(container.cardinality);
+            for (auto& low : container.array) {
+                low = take<uint16_t>(bytes);
+            }
+            if (!is_sorted(container.array.begin(), container.array.end()) ||
+                adjacent_find(container.array.begin(), container.array.end()) != container.array.end()) {
+                throw runtime_error("Roaring bitmap array container not sorted");
+            }
+        } else {
+            throw runtime_error("Malformed roaring bitmap container");
+        }
+        bitmap.containers_.push_back(std::move(container));
+    }
+
+    if (!bytes.empty()) {
+        throw runtime_error("Trailing bytes after roaring bitmap");
+    }
+    return bitmap;
+}
+
+bool RoaringBitmap::operator==(const RoaringBitmap& other) const {
+    if (containers_.size() != other.containers_.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < containers_.size(); ++i) {
+        const auto& a = containers_[i];
+        const auto& b = other.containers_[i];
+        if (a.key != b.key || a.cardinality != b.cardinality) {
+            return false;
+        }
+        if (a.isBitmap() == b.isBitmap()) {
+            if (a.array != b.array || a.bits != b.bits) {
+                return false;
+            }
+        } else {
+            // Same cardinality, different representation: compare values
+            const auto& array = a.isBitmap() ? b.array : a.array;
+            const auto& bits = a.isBitmap() ? a.bits : b.bits;
+            for (uint16_t low : array) {
+                if (((bits[low >> 6] >> (low & 63)) & 1) == 0) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
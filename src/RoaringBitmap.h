@@ -0,0 +1,112 @@
+#ifndef COLUMNANALYZER_ROARINGBITMAP_H
+#define COLUMNANALYZER_ROARINGBITMAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * Compressed set of 32-bit integers (roaring layout)
+ *
+ * Values are split by their high 16 bits into containers. A container is a
+ * sorted uint16 array while it holds at most 4096 values and a 65536-bit
+ * bitmap beyond that, so sparse and dense ranges both stay compact.
+ * Unions of bitmap containers are word-wise ORs; cardinality is a popcount
+ * loop the compiler vectorizes where the CPU has a vector popcount.
+ */
+class RoaringBitmap {
+public:
+    static constexpr size_t kArrayMax = 4096;               // Array container limit
+    static constexpr size_t kBitmapWords = 65536 / 64;      // Words per bitmap container
+
+    /**
+     * Build from a plain bit vector: bit i of words[i / 64] is value i
+     * @param words Bit vector
+     * @param wordCount Number of 64-bit words
+     */
+    static RoaringBitmap fromBits(const uint64_t* words, size_t wordCount);
+
+    /**
+     * Insert a value
+     */
+    void add(uint32_t value);
+
+    /**
+     * Membership test
+     */
+    [[nodiscard]] bool contains(uint32_t value) const;
+
+    /**
+     * Number of values
+     */
+    [[nodiscard]] uint64_t cardinality() const;
+
+    [[nodiscard]] bool empty() const { return containers_.empty(); }
+
+    /**
+     * Union in place
+     * @param other Bitmap to add
+     */
+    void merge(const RoaringBitmap& other);
+
+    /**
+     * Call f(value) for every value in increasing order
+     */
+    template <typename F>
+    void forEach(F&& f) const {
+        for (const auto& container : containers_) {
+            const uint32_t base = static_cast<uint32_t>(container.key) << 16;
+            if (container.isBitmap()) {
+                for (size_t w = 0; w < kBitmapWords; ++w) {
+                    for (uint64_t word = container.bits[w]; word != 0; word &= word - 1) {
+                        f(base | static_cast<uint32_t>(w * 64 + __builtin_ctzll(word)));
+                    }
+                }
+            } else {
+                for (uint16_t low : container.array) {
+                    f(base | low);
+                }
+            }
+        }
+    }
+
+    /**
+     * Serialize to bytes (little-endian)
+     *   uint32 container count
+     *   per container: uint16 key, uint8 kind (0 array, 1 bitmap), uint32 cardinality,
+     *   then cardinality uint16 values or 1024 uint64 words
+     */
+    [[nodiscard]] std::string serialize() const;
+
+    /**
+     * Load bytes written by serialize()
+     * @throws std::runtime_error on malformed input
+     */
+    static RoaringBitmap deserialize(std::string_view bytes);
+
+    bool operator==(const RoaringBitmap& other) const;
+    bool operator!=(const RoaringBitmap& other) const { return !(*this == other); }
+
+private:
+    struct Container {
+        uint16_t key = 0;
+        uint32_t cardinality = 0;
+        std::vector<uint16_t> array;  // Sorted values while cardinality <= kArrayMax
+        std::vector<uint64_t> bits;   // kBitmapWords words once converted
+
+        [[nodiscard]] bool isBitmap() const { return !bits.empty(); }
+        void toBitmap();
+        void toArrayIfSmall();
+    };
+
+    std::vector<Container> containers_;  // Sorted by key
+
+    Container& containerFor(uint16_t key);
+    [[nodiscard]] const Container* findContainer(uint16_t key) const;
+
+    static uint32_t popcount(const uint64_t* words, size_t count);
+};
+
+#endif //COLUMNANALYZER_ROARINGBITMAP_H
@@ -0,0 +1,167 @@
+#include "SampleEstimator.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numeric>
+#include <string_view>
+#include <unordered_map>
+
+using namespace std;
+
+namespace {
+
+    constexpr double kZ95 = 1.959963984540054;
+
+    using GroupCounts = array<uint32_t, SampleEstimator::kGroups>;
+
+    /**
+     * Wilson score interval of a proportion
+     */
+    void wilson(size_t hits, size_t n, double& lower, double& upper) {
+        const double p = static_cast<double>(hits) / static_cast<double>(n);
+        const double z2n = kZ95 * kZ95 / static_cast<double>(n);
+        const double center = (p + z2n / 2.0) / (1.0 + z2n);
+        const double half = kZ95 * sqrt(p * (1.0 - p) / static_cast<double>(n) +
+                                        z2n / (4.0 * static_cast<double>(n))) / (1.0 + z2n);
+        lower = max(0.0, center - half);
+        upper = min(1.0, center + half);
+    }
+
+} // namespace
+
+double SampleEstimator::haasStokes(size_t sampleRows, size_t totalRows,
+                                   size_t distinct, size_t singletons) {
+    if (sampleRows == 0) {
+        return 0.0;
+    }
+    const double n = static_cast<double>(sampleRows);
+    const double total = static_cast<double>(max(totalRows, sampleRows));
+    const double q = n / total;
+    const double denominator = 1.0 - (1.0 - q) * static_cast<double>(singletons) / n;
+
+    if (denominator <= 0.0) {
+        return total;
+    }
+    return clamp(static_cast<double>(distinct) / denominator, static_cast<double>(distinct), total);
+}
+
+DistinctEstimate SampleEstimator::estimate(const vector<string>& column,
+                                           const SampleInfo& info,
+                                           size_t topValues) {
+    DistinctEstimate result;
+    result.sampled = true;
+
+    const size_t n = column.size();
+    const size_t totalRows = max(info.estimatedRows, n);
+    if (n == 0) {
+        return result;
+    }
+
+    // Group of each row: sampled blocks are dealt round-robin to the groups
+    vector<uint8_t> rowGroup(n);
+    const size_t blockRowSum = accumulate(info.blockRows.begin(), info.blockRows.end(), size_t{0});
+    if (blockRowSum == n && info.blockRows.size() >= kGroups) {
+        size_t row = 0;
+        for (size_t b = 0; b < info.blockRows.size(); ++b) {
+            fill_n(rowGroup.begin() + static_cast<ptrdiff_t>(row), info.blockRows[b],
+                   static_cast<uint8_t>(b % kGroups));
+            row += info.blockRows[b];
+        }
+    } else {
+        for (size_t row = 0; row < n; ++row) {
+            rowGroup[row] = static_cast<uint8_t>(row * kGroups / n);
+        }
+    }
+
+    // Per-value counts in each group
+    unordered_map<string_view, size_t> slot;
+    slot.reserve(n);
+    vector<GroupCounts> counts;
+    vector<string_view> values;
+    GroupCounts groupRows{};
+
+    for (size_t row = 0; row < n; ++row) {
+        auto [it, inserted] = slot.try_emplace(column[row], counts.size());
+        if (inserted) {
+            counts.emplace_back();
+            counts.back().fill(0);
+            values.push_back(column[row]);
+        }
+        ++counts[it->second][rowGroup[row]];
+        ++groupRows[rowGroup[row]];
+    }
+
+    vector<size_t> totals(counts.size());
+    size_t singletons = 0;
+    for (size_t v = 0; v < counts.size(); ++v) {
+        totals[v] = accumulate(counts[v].begin(), counts[v].end(), size_t{0});
+        singletons += totals[v] == 1;
+    }
+
+    const size_t distinct = counts.size();
+    result.sampleDistinct = distinct;
+
+    if (info.exact) {
+        result.estimate = result.lower = result.upper = static_cast<double>(distinct);
+    } else {
+        result.estimate = haasStokes(n, totalRows, distinct, singletons);
+
+        // Delete-a-group jackknife
+        vector<double> replicates;
+        for (size_t g = 0; g < kGroups; ++g) {
+            if (groupRows[g] == 0 || groupRows[g] == n) continue;
+
+            size_t d = 0;
+            size_t f1 = 0;
+            for (size_t v = 0; v < counts.size(); ++v) {
+                const size_t remaining = totals[v] - counts[v][g];
+                d += remaining > 0;
+                f1 += remaining == 1;
+            }
+            replicates.push_back(haasStokes(n - groupRows[g], totalRows, d, f1));
+        }
+
+        if (replicates.size() >= 2) {
+            const double k = static_cast<double>(replicates.size());
+            const double mean = accumulate(replicates.begin(), replicates.end(), 0.0) / k;
+            double sumSquares = 0.0;
+            for (double r : replicates) {
+                sumSquares += (r - mean) * (r - mean);
+            }
+            const double se = sqrt((k - 1.0) / k * sumSquares);
+            result.lower = result.estimate - kZ95 * se;
+            result.upper = result.estimate + kZ95 * se;
+        } else {
+            // Guaranteed-error bounds: unseen values are at most the scaled singletons
+            result.lower = static_cast<double>(distinct);
+            result.upper = static_cast<double>(distinct - singletons) +
+                           static_cast<double>(singletons) * static_cast<double>(totalRows) / static_cast<double>(n);
+        }
+        result.lower = clamp(result.lower, static_cast<double>(distinct), result.estimate);
+        result.upper = clamp(result.upper, result.estimate, static_cast<double>(totalRows));
+    }
+
+    // Most frequent values
+    vector<size_t> order(counts.size());
+    iota(order.begin(), order.end(), 0);
+    const size_t top = min(topValues, order.size());
+    partial_sort(order.begin(), order.begin() + static_cast<ptrdiff_t>(top), order.end(),
+                 [&](size_t a, size_t b) {
+                     return totals[a] != totals[b] ? totals[a] > totals[b] : values[a] < values[b];
+                 });
+
+    for (size_t i = 0; i < top; ++i) {
+        const size_t v = order[i];
+        DistinctEstimate::ValueShare share;
+        share.value = string(values[v]);
+        share.share = static_cast<double>(totals[v]) / static_cast<double>(n);
+        if (info.exact) {
+            share.lower = share.upper = share.share;
+        } else {
+            wilson(totals[v], n, share.lower, share.upper);
+        }
+        result.topValues.push_back(std::move(share));
+    }
+
+    return result;
+}
@@ -0,0 +1,49 @@
+#ifndef COLUMNANALYZER_SAMPLEESTIMATOR_H
+#define COLUMNANALYZER_SAMPLEESTIMATOR_H
+
+#include <string>
+#include <vector>
+#include "CSVReader.h"
+#include "ColumnStatistics.h"
+
+/**
+ * Whole-file estimates from a sampled column
+ *
+ * Distinct count: Haas-Stokes "Duj1" estimator d / (1 - (1 - q) f1 / n),
+ * where d is the number of distinct values in the sample, f1 the number seen
+ * exactly once, n the sampled rows and q the sampling fraction. The 95%
+ * interval comes from a delete-a-group jackknife over the sampled blocks,
+ * which accounts for values clustering within blocks.
+ *
+ * Value shares: Wilson score interval per frequent value.
+ */
+class SampleEstimator {
+public:
+    /**
+     * Block groups used by the jackknife
+     */
+    static constexpr size_t kGroups = 8;
+
+    /**
+     * Estimate distinct count and frequent value shares of one column
+     * @param column Sampled values in table order
+     * @param info Sample description from CSVReader::readSample
+     * @param topValues Number of frequent values to report
+     * @return Estimates
+     */
+    static DistinctEstimate estimate(const std::vector<std::string>& column,
+                                     const SampleInfo& info,
+                                     size_t topValues = 5);
+
+    /**
+     * Haas-Stokes Duj1 estimate, clamped to [distinct, totalRows]
+     * @param sampleRows Rows in the sample
+     * @param totalRows Rows in the whole file
+     * @param distinct Distinct values in the sample
+     * @param singletons Values seen exactly once in the sample
+     */
+    static double haasStokes(size_t sampleRows, size_t totalRows,
+                             size_t distinct, size_t singletons);
+};
+
+#endif //COLUMNANALYZER_SAMPLEESTIMATOR_H
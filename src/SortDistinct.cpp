@@ -0,0 +1,93 @@
+#include "SortDistinct.h"
+#include "CancellationToken.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <unordered_set>
+
+using namespace std;
+
+namespace {
+
+    /**
+     * Run task(0..count-1) on up to `workers` threads; workers stop taking
+     * tasks once the token is cancelled, and the caller then throws
+     */
+    template <typename Task>
+    void runRound(size_t count, size_t workers, const CancellationToken* token, const Task& task) {
+        auto cancelled = [token]() { return token != nullptr && token->isCancelled(); };
+        workers = min(workers, count);
+        if (workers <= 1) {
+            for (size_t i = 0; i < count && !cancelled(); ++i) {
+                task(i);
+            }
+        } else {
+            atomic<size_t> next{0};
+            vector<thread> threads;
+            for (size_t w = 0; w < workers; ++w) {
+                threads.emplace_back([&]() {
+                    for (size_t i = next++; i < count && !cancelled(); i = next++) {
+                        task(i);
+                    }
+                });
+            }
+            for (auto& t : threads) {
+                t.join();
+            }
+        }
+        CancellationToken::throwIfCancelled();
+    }
+
+} // namespace
+
+void SortDistinct::sortRange(string_view* keys, size_t count, size_t numThreads) {
+    constexpr size_t kMinChunk = 1 << 14;  // Below this, threads cost more than they save
+    constexpr size_t kMaxChunk = 1 << 20;  // Keys sorted between cancellation checks
+
+    const size_t threads = min(numThreads, max<size_t>(1, count / kMinChunk));
+    const size_t chunks = max(threads, (count + kMaxChunk - 1) / kMaxChunk);
+    if (chunks <= 1) {
+        sort(keys, keys + count);
+        return;
+    }
+
+    // Chunk boundaries
+    vector<size_t> bounds(chunks + 1);
+    for (size_t i = 0; i <= chunks; ++i) {
+        bounds[i] = count * i / chunks;
+    }
+
+    // Sort chunks concurrently, then merge neighbouring runs pairwise; each
+    // round halves the number of runs. The caller's token is checked
+    // between chunks and merges (worker threads do not inherit it).
+    const CancellationToken* token = CancellationToken::current();
+    runRound(chunks, threads, token, [&](size_t i) {
+        sort(keys + bounds[i], keys + bounds[i + 1]);
+    });
+
+    for (size_t width = 1; width < chunks; width *= 2) {
+        const size_t pairs = (chunks - width + 2 * width - 1) / (2 * width);
+        runRound(pairs, threads, token, [&](size_t p) {
+            const size_t i = p * 2 * width;
+            inplace_merge(keys + bounds[i], keys + bounds[i + width],
+                          keys + bounds[min(i + 2 * width, chunks)]);
+        });
+    }
+}
+
+double SortDistinct::estimateDistinctRatio(const vector<string>& columnData, size_t sampleSize) {
+    if (columnData.empty() || sampleSize == 0) {
+        return 0.0;
+    }
+
+    const size_t n = min(sampleSize, columnData.size());
+    const size_t step = columnData.size() / n;
+
+    unordered_set<string_view> seen;
+    seen.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        seen.insert(columnData[i * step]);
+    }
+
+    return static_cast<double>(seen.size()) / static_cast<double>(n);
+}
@@ -0,0 +1,67 @@
+#ifndef COLUMNANALYZER_SORTDISTINCT_H
+#define COLUMNANALYZER_SORTDISTINCT_H
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * Sort-based exact distinct counting
+ * For mostly-unique columns, sorting a compact array of string_views and
+ * counting adjacent-unique runs beats node-based hash sets in time and memory
+ */
+class SortDistinct {
+public:
+    /**
+     * Sort keys, splitting the work across threads
+     * Chunks are sorted concurrently, then merged pairwise in log2(chunks) rounds
+     * Large inputs are cut into chunks of at most 1M keys even on one
+     * thread, so the calling thread's CancellationToken is checked every
+     * chunk and every merge round (throws OperationCancelled)
+     * @param keys Keys to sort in place
+     * @param numThreads Worker threads (1 = std::sort)
+     */
+    template <typename Alloc>
+    static void parallelSort(std::vector<std::string_view, Alloc>& keys, size_t numThreads) {
+        sortRange(keys.data(), keys.size(), numThreads);
+    }
+
+    /**
+     * Views of a set's values in ascending byte order
+     * @param values Distinct values (any container of strings)
+     * @param numThreads Worker threads for parallelSort
+     * @return Views into values, valid while values is unchanged
+     */
+    template <typename Container>
+    static std::vector<std::string_view> sortedViews(const Container& values, size_t numThreads) {
+        std::vector<std::string_view> views(values.begin(), values.end());
+        parallelSort(views, numThreads);
+        return views;
+    }
+
+    /**
+     * Move the first key of every run of equal keys to the front
+     * @param keys Sorted keys; resized to the unique prefix
+     * @return Number of distinct keys
+     */
+    template <typename Alloc>
+    static size_t uniqueSorted(std::vector<std::string_view, Alloc>& keys) {
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+        return keys.size();
+    }
+
+    /**
+     * Estimate the fraction of distinct values from an evenly spaced sample
+     * @param columnData Column data
+     * @param sampleSize Maximum number of sampled cells
+     * @return Distinct values in sample / sample size (0 for empty columns)
+     */
+    static double estimateDistinctRatio(const std::vector<std::string>& columnData,
+                                        size_t sampleSize = 4096);
+
+private:
+    static void sortRange(std::string_view* keys, size_t count, size_t numThreads);
+};
+
+#endif //COLUMNANALYZER_SORTDISTINCT_H
@@ -0,0 +1,74 @@
+#include "TableAnalyzer.h"
+#include "Console.h"
+#include <algorithm>
+#include <future>
+
+using namespace std;
+
+TableAnalyzer::TableAnalyzer(TableAnalyzerOptions options)
+    : options_(options), pool_(options.numThreads) {}
+
+TableResult TableAnalyzer::analyzeFile(const string& path,
+                                       const CancellationToken* cancellation) {
+    Console::QuietScope quiet(options_.quiet);
+    CancellationToken::Scope scope(cancellation);
+    return analyzeTable(CSVReader::readTable(path, options_.computeHashes), cancellation);
+}
+
+TableResult TableAnalyzer::analyzeBuffer(string_view csv,
+                                         const CancellationToken* cancellation) {
+    Console::QuietScope quiet(options_.quiet);
+    CancellationToken::Scope scope(cancellation);
+    return analyzeTable(CSVReader::parseBuffer(csv, options_.computeHashes), cancellation);
+}
+
+TableResult TableAnalyzer::analyzeTable(const CSVTable& table,
+                                        const CancellationToken* cancellation) {
+    const auto& columns = table.columns;
+    const bool hashed = table.cellHashes.size() == columns.size();
+
+    AnalyzerOptions options = options_.analyzerOptions;
+    if (options.sortThreads == 0) {
+        // Same split as ParallelProcessor: spare workers sort wide columns
+        options.sortThreads = max<size_t>(1, pool_.size() / max<size_t>(columns.size(), 1));
+    }
+
+    vector<future<ColumnResult>> pending;
+    pending.reserve(columns.size());
+    for (size_t c = 0; c < columns.size(); ++c) {
+        pending.push_back(pool_.submit([&table, &options, hashed, cancellation, c]() {
+            if (cancellation != nullptr && cancellation->isCancelled()) {
+                ColumnResult result(c);
+                result.complete = false;
+                return result;
+            }
+            CancellationToken::Scope scope(cancellation);
+            try {
+                return ColumnAnalyzer::analyze(c, table.columns[c], options,
+                                               hashed ? &table.cellHashes[c] : nullptr);
+            } catch (const OperationCancelled&) {
+                ColumnResult result(c);
+                result.complete = false;
+                return result;
+            }
+        }));
+    }
+
+    // Tasks reference the table and options: let all finish before any rethrow
+    for (auto& column : pending) {
+        column.wait();
+    }
+
+    TableResult result;
+    result.headers = table.headers;
+    result.rowCount = columns.empty() ? 0 : columns[0].size();
+    result.columns.reserve(columns.size());
+    for (size_t c = 0; c < pending.size(); ++c) {
+        result.columns.push_back(pending[c].get());
+        if (c < table.headers.size()) {
+            result.columns.back().columnName = table.headers[c];
+        }
+        result.complete = result.complete && result.columns.back().complete;
+    }
+    return result;
+}
@@ -0,0 +1,90 @@
+#ifndef COLUMNANALYZER_TABLEANALYZER_H
+#define COLUMNANALYZER_TABLEANALYZER_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include "CSVReader.h"
+#include "CancellationToken.h"
+#include "ColumnAnalyzer.h"
+#include "ThreadPool.h"
+
+/**
+ * Settings of an embedded analyzer
+ */
+struct TableAnalyzerOptions {
+    size_t numThreads = 0;            // Pool workers (0 = hardware concurrency)
+    AnalyzerOptions analyzerOptions;  // Passed to ColumnAnalyzer for every column
+    bool computeHashes = true;        // Hash cells while parsing (see CellHash.h)
+    bool quiet = true;                // No console output from reader and analysis
+};
+
+/**
+ * Results of one table
+ */
+struct TableResult {
+    std::vector<std::string> headers;
+    size_t rowCount = 0;
+    std::vector<ColumnResult> columns;  // One per column, columnName set
+    bool complete = true;               // False if cancelled before every column finished
+};
+
+/**
+ * In-process analyzer for embedding (library API of libcolumnanalyzer)
+ *
+ * Takes a file, CSV text in memory or an already parsed table and returns
+ * the results; nothing is printed (unless quiet is off) and no files are
+ * written. One thread pool is created up front and reused by every call.
+ * Calls may come from several threads at once.
+ */
+class TableAnalyzer {
+public:
+    /**
+     * Constructor; starts the worker pool
+     * @param options Analyzer settings
+     */
+    explicit TableAnalyzer(TableAnalyzerOptions options = {});
+
+    TableAnalyzer(const TableAnalyzer&) = delete;
+    TableAnalyzer& operator=(const TableAnalyzer&) = delete;
+
+    /**
+     * Read and analyze a CSV file
+     * @param path CSV file
+     * @param cancellation Optional token; unfinished columns come back incomplete
+     * @throws std::runtime_error if the file cannot be read,
+     *         OperationCancelled if cancelled while parsing
+     */
+    TableResult analyzeFile(const std::string& path,
+                            const CancellationToken* cancellation = nullptr);
+
+    /**
+     * Parse and analyze CSV text held by the caller
+     * @param csv Header line followed by rows; not copied as a whole
+     * @param cancellation Optional token; unfinished columns come back incomplete
+     * @throws OperationCancelled if cancelled while parsing
+     */
+    TableResult analyzeBuffer(std::string_view csv,
+                              const CancellationToken* cancellation = nullptr);
+
+    /**
+     * Analyze a parsed table (e.g. from CSVReader); the table is not copied
+     * @param table Columns, headers and optional cell hashes
+     * @param cancellation Optional token; unfinished columns come back incomplete
+     */
+    TableResult analyzeTable(const CSVTable& table,
+                             const CancellationToken* cancellation = nullptr);
+
+    /**
+     * Worker threads in the shared pool
+     */
+    [[nodiscard]] size_t threads() const { return pool_.size(); }
+
+    [[nodiscard]] const TableAnalyzerOptions& options() const { return options_; }
+
+private:
+    TableAnalyzerOptions options_;
+    ThreadPool pool_;
+};
+
+#endif //COLUMNANALYZER_TABLEANALYZER_H
@@ -0,0 +1,67 @@
+#include "TableCache.h"
+
+using namespace std;
+namespace fs = std::filesystem;
+
+TableCache::TableCache(size_t capacity)
+    : capacity_(capacity == 0 ? 1 : capacity) {}
+
+shared_ptr<const CSVTable> TableCache::get(const string& filename, bool* wasCached) {
+    // Throws for missing files, like CSVReader
+    auto modified = fs::last_write_time(filename);
+    auto fileSize = fs::file_size(filename);
+
+    {
+        lock_guard<mutex> lock(mutex_);
+        auto it = index_.find(filename);
+        if (it != index_.end()) {
+            if (it->second->modified == modified && it->second->fileSize == fileSize) {
+                entries_.splice(entries_.begin(), entries_, it->second);
+                ++hits_;
+                if (wasCached) *wasCached = true;
+                return it->second->table;
+            }
+            // Stale entry: file changed on disk
+            entries_.erase(it->second);
+            index_.erase(it);
+        }
+        ++misses_;
+    }
+
+    // Parse outside the lock so other tables stay available
+    auto table = make_shared<const CSVTable>(CSVReader::readTable(filename));
+    if (wasCached) *wasCached = false;
+
+    lock_guard<mutex> lock(mutex_);
+    auto it = index_.find(filename);
+    if (it != index_.end()) {
+        // Loaded concurrently by another request
+        entries_.erase(it->second);
+        index_.erase(it);
+    }
+
+    entries_.push_front(Entry{filename, modified, fileSize, table});
+    index_[filename] = entries_.begin();
+
+    while (entries_.size() > capacity_) {
+        index_.erase(entries_.back().filename);
+        entries_.pop_back();
+    }
+
+    return table;
+}
+
+size_t TableCache::size() const {
+    lock_guard<mutex> lock(mutex_);
+    return entries_.size();
+}
+
+size_t TableCache::hits() const {
+    lock_guard<mutex> lock(mutex_);
+    return hits_;
+}
+
+size_t TableCache::misses() const {
+    lock_guard<mutex> lock(mutex_);
+    return misses_;
+}
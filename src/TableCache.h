@@ -0,0 +1,52 @@
+#ifndef COLUMNANALYZER_TABLECACHE_H
+#define COLUMNANALYZER_TABLECACHE_H
+
+#include <string>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <filesystem>
+#include "CSVReader.h"
+
+/**
+ * LRU cache of parsed CSV tables keyed by file path
+ * Entries are invalidated when the file size or modification time changes
+ */
+class TableCache {
+public:
+    /**
+     * Constructor
+     * @param capacity Maximum number of cached tables
+     */
+    explicit TableCache(size_t capacity = 16);
+
+    /**
+     * Get a parsed table, reading the file on a miss
+     * @param filename Path to CSV file
+     * @param wasCached Set to true if the table came from the cache
+     * @return Shared immutable table
+     */
+    std::shared_ptr<const CSVTable> get(const std::string& filename, bool* wasCached = nullptr);
+
+    [[nodiscard]] size_t size() const;
+    [[nodiscard]] size_t hits() const;
+    [[nodiscard]] size_t misses() const;
+
+private:
+    struct Entry {
+        std::string filename;
+        std::filesystem::file_time_type modified;
+        uintmax_t fileSize;
+        std::shared_ptr<const CSVTable> table;
+    };
+
+    size_t capacity_;
+    std::list<Entry> entries_;  // Front = most recently used
+    std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+    mutable std::mutex mutex_;
+    size_t hits_ = 0;
+    size_t misses_ = 0;
+};
+
+#endif //COLUMNANALYZER_TABLECACHE_H
@@ -0,0 +1,47 @@
+#include "ThreadPool.h"
+
+using namespace std;
+
+ThreadPool::ThreadPool(size_t numThreads) {
+    if (numThreads == 0) {
+        numThreads = thread::hardware_concurrency();
+        if (numThreads == 0) {
+            numThreads = 8;  // Fallback
+        }
+    }
+
+    workers_.reserve(numThreads);
+    for (size_t i = 0; i < numThreads; ++i) {
+        workers_.emplace_back([this]() { workerLoop(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+void ThreadPool::workerLoop() {
+    while (true) {
+        function<void()> task;
+        {
+            unique_lock<mutex> lock(mutex_);
+            cv_.wait(lock, [this]() { return stopping_ || !tasks_.empty(); });
+
+            if (tasks_.empty()) {
+                return;  // Stopping and drained
+            }
+
+            task = std::move(tasks_.front());
+            tasks_.pop();
+        }
+        task();
+    }
+}
@@ -0,0 +1,69 @@
+#ifndef COLUMNANALYZER_THREADPOOL_H
+#define COLUMNANALYZER_THREADPOOL_H
+
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <type_traits>
+
+/**
+ * Fixed-size pool of worker threads kept warm across requests
+ */
+class ThreadPool {
+public:
+    /**
+     * Constructor
+     * @param numThreads Number of workers (0 = hardware concurrency)
+     */
+    explicit ThreadPool(size_t numThreads = 0);
+
+    /**
+     * Stops accepting tasks, finishes queued ones and joins workers
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * Queue a task
+     * @param task Callable without arguments
+     * @return Future for the task result
+     */
+    template <typename F>
+    std::future<std::invoke_result_t<F>> submit(F&& task) {
+        using Result = std::invoke_result_t<F>;
+
+        auto packaged = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(task));
+        std::future<Result> future = packaged->get_future();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            tasks_.emplace([packaged]() { (*packaged)(); });
+        }
+        cv_.notify_one();
+
+        return future;
+    }
+
+    /**
+     * Number of worker threads
+     */
+    [[nodiscard]] size_t size() const { return workers_.size(); }
+
+private:
+    std::vector<std::thread> workers_;
+    std::queue<std::function<void()>> tasks_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stopping_ = false;
+
+    void workerLoop();
+};
+
+#endif //COLUMNANALYZER_THREADPOOL_H
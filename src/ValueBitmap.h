@@ -0,0 +1,135 @@
+#ifndef COLUMNANALYZER_VALUEBITMAP_H
+#define COLUMNANALYZER_VALUEBITMAP_H
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "RoaringBitmap.h"
+
+/**
+ * How cells of a small-domain column map to 32-bit keys
+ */
+enum class BitmapEncoding : uint8_t {
+    NONE = 0,     // Column is not a small domain
+    BYTE = 1,     // Every cell is one byte; key = byte value
+    INTEGER = 2   // Every cell is a canonical non-negative integer < 2^32; key = value
+};
+
+/**
+ * Distinct values of a small-domain column as a roaring bitmap of keys
+ * Bitmaps of the same encoding merge by union, across chunks and files,
+ * and serialize to a compact byte string
+ */
+struct ValueBitmap {
+    BitmapEncoding encoding = BitmapEncoding::NONE;
+    RoaringBitmap keys;
+
+    // AUTO picks the bitmap kernel for integer columns whose sampled
+    // maximum is below this (the direct bit vector covers 2^16 keys)
+    static constexpr uint32_t kMaxAutoKey = 1u << 20;
+
+    [[nodiscard]] bool valid() const { return encoding != BitmapEncoding::NONE; }
+
+    /**
+     * Key of a cell under an encoding
+     * @return False if the cell does not fit the encoding
+     */
+    static bool encode(BitmapEncoding encoding, std::string_view cell, uint32_t& key) {
+        if (encoding == BitmapEncoding::BYTE) {
+            if (cell.size() != 1) {
+                return false;
+            }
+            key = static_cast<unsigned char>(cell[0]);
+            return true;
+        }
+        // No sign, no leading zeros: the key prints back as the same cell
+        if (cell.empty() || cell.size() > 10 || (cell[0] == '0' && cell.size() > 1)) {
+            return false;
+        }
+        uint64_t value = 0;
+        for (char c : cell) {
+            const auto digit = static_cast<unsigned char>(c - '0');
+            if (digit > 9) {
+                return false;
+            }
+            value = value * 10 + digit;
+        }
+        key = static_cast<uint32_t>(value);
+        return value <= UINT32_MAX;
+    }
+
+    /**
+     * Cell text of a key
+     */
+    static std::string decode(BitmapEncoding encoding, uint32_t key) {
+        if (encoding == BitmapEncoding::BYTE) {
+            return std::string(1, static_cast<char>(key));
+        }
+        return std::to_string(key);
+    }
+
+    /**
+     * Encoding that fits a sample of the column, NONE if neither does
+     * @param columnData Column cells
+     * @param sampleSize Cells checked, spread evenly over the column
+     * @param maxKey Largest integer key accepted in the sample
+     */
+    template <typename Value>
+    static BitmapEncoding detect(const std::vector<Value>& columnData,
+                                 size_t sampleSize = 1024,
+                                 uint32_t maxKey = UINT32_MAX) {
+        if (columnData.empty()) {
+            return BitmapEncoding::NONE;
+        }
+        const size_t n = std::min(sampleSize, columnData.size());
+        const size_t step = columnData.size() / n;
+
+        bool bytes = true;
+        bool integers = true;
+        for (size_t i = 0; i < n && (bytes || integers); ++i) {
+            const std::string_view cell(columnData[i * step]);
+            uint32_t key;
+            bytes = bytes && cell.size() == 1;
+            integers = integers && encode(BitmapEncoding::INTEGER, cell, key) && key <= maxKey;
+        }
+        // Digits fit both; integer keys keep the domain denser
+        if (integers) return BitmapEncoding::INTEGER;
+        if (bytes) return BitmapEncoding::BYTE;
+        return BitmapEncoding::NONE;
+    }
+
+    /**
+     * Union with another part of the same column
+     * Parts with different encodings cannot be combined and leave no bitmap
+     */
+    void merge(const ValueBitmap& other) {
+        if (encoding != other.encoding) {
+            encoding = BitmapEncoding::NONE;
+            keys = RoaringBitmap();
+            return;
+        }
+        keys.merge(other.keys);
+    }
+
+    /**
+     * Encoding byte followed by RoaringBitmap::serialize()
+     */
+    [[nodiscard]] std::string serialize() const {
+        return static_cast<char>(encoding) + keys.serialize();
+    }
+
+    static ValueBitmap deserialize(std::string_view bytes) {
+        if (bytes.empty() || static_cast<uint8_t>(bytes[0]) > static_cast<uint8_t>(BitmapEncoding::INTEGER)) {
+            throw std::runtime_error("Malformed value bitmap");
+        }
+        ValueBitmap bitmap;
+        bitmap.encoding = static_cast<BitmapEncoding>(bytes[0]);
+        bitmap.keys = RoaringBitmap::deserialize(bytes.substr(1));
+        return bitmap;
+    }
+};
+
+#endif //COLUMNANALYZER_VALUEBITMAP_H
@@ -0,0 +1,97 @@
+#include "WorkerArena.h"
+#include "HugePageResource.h"
+#include <algorithm>
+#include <new>
+
+using namespace std;
+
+WorkerArena::~WorkerArena() {
+    release();
+}
+
+WorkerArena& WorkerArena::local() {
+    thread_local WorkerArena arena;
+    return arena;
+}
+
+size_t WorkerArena::sizeClass(size_t bytes) {
+    size_t sizeClass = kMinClass;
+    while ((size_t{1} << sizeClass) < bytes) {
+        ++sizeClass;
+    }
+    return sizeClass;
+}
+
+void WorkerArena::setCacheLimit(size_t bytes) {
+    cacheLimit_ = bytes;
+    trimTo(cacheLimit_);
+}
+
+void WorkerArena::trimTo(size_t limit) {
+    for (size_t c = kClasses; c-- > 0 && bytesCached_ > limit;) {
+        auto& freeList = freeLists_[c];
+        while (!freeList.empty() && bytesCached_ > limit) {
+            HugePageResource::instance().deallocate(freeList.back(), size_t{1} << c);
+            freeList.pop_back();
+            --owned_[c];
+            bytesHeld_ -= size_t{1} << c;
+            bytesCached_ -= size_t{1} << c;
+        }
+    }
+}
+
+void WorkerArena::release() {
+    trimTo(0);
+    for (size_t c = 0; c < kClasses; ++c) {
+        if (owned_[c] == 0) {
+            vector<void*>().swap(freeLists_[c]);  // Blocks in use keep their room
+        }
+    }
+}
+
+void* WorkerArena::do_allocate(size_t bytes, size_t alignment) {
+    if (alignment > alignof(max_align_t)) {
+        throw bad_alloc();
+    }
+
+    const size_t c = sizeClass(bytes);
+    if (c >= kClasses) {
+        throw bad_alloc();
+    }
+
+    auto& freeList = freeLists_[c];
+    if (!freeList.empty()) {
+        void* block = freeList.back();
+        freeList.pop_back();
+        bytesCached_ -= size_t{1} << c;
+        return block;
+    }
+
+    // Room for every block of the class on its free list, so releasing
+    // never allocates; grown geometrically
+    if (freeList.capacity() < owned_[c] + 1) {
+        freeList.reserve(max<size_t>(2 * freeList.capacity(), 4));
+    }
+
+    void* block = HugePageResource::instance().allocate(size_t{1} << c);
+    ++owned_[c];
+    ++upstreamAllocations_;
+    bytesHeld_ += size_t{1} << c;
+    return block;
+}
+
+void WorkerArena::do_deallocate(void* p, size_t bytes, size_t) {
+    const size_t c = sizeClass(bytes);
+    if (bytesCached_ + (size_t{1} << c) > cacheLimit_) {
+        HugePageResource::instance().deallocate(p, size_t{1} << c);
+        --owned_[c];
+        bytesHeld_ -= size_t{1} << c;
+        return;
+    }
+    freeLists_[c].push_back(p);
+    bytesCached_ += size_t{1} << c;
+}
+
+bool WorkerArena::do_is_equal(const memory_resource& other) const noexcept {
+    return this == &other;
+}
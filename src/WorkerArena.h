@@ -0,0 +1,91 @@
+#ifndef COLUMNANALYZER_WORKERARENA_H
+#define COLUMNANALYZER_WORKERARENA_H
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+/**
+ * Per-thread recycling memory resource for analyzer scratch memory
+ * (hash index slots, first-occurrence rows, sort keys)
+ *
+ * Blocks are rounded up to a power of two and kept on per-size free lists
+ * when released, so once a worker has analyzed one column, the scratch of
+ * later columns of similar size is served without touching the global heap.
+ * Blocks of 2 MB and more come from HugePageResource::instance(), so the
+ * large hash tables are backed by huge pages where the kernel allows.
+ * Cached blocks are capped (cacheLimit()); a released block that does not
+ * fit goes back upstream, so long-lived pool threads do not pin the
+ * intermediate slot arrays of every index they ever grew.
+ * Not thread-safe: each thread uses its own instance via local().
+ */
+class WorkerArena : public std::pmr::memory_resource {
+public:
+    static constexpr size_t kDefaultCacheLimit = size_t{64} << 20;
+
+    WorkerArena() = default;
+    ~WorkerArena() override;
+
+    WorkerArena(const WorkerArena&) = delete;
+    WorkerArena& operator=(const WorkerArena&) = delete;
+
+    /**
+     * Arena of the calling thread, created on first use
+     */
+    static WorkerArena& local();
+
+    /**
+     * Blocks obtained from the global heap so far
+     */
+    [[nodiscard]] size_t upstreamAllocations() const { return upstreamAllocations_; }
+
+    /**
+     * Bytes currently owned by the arena (in use or cached)
+     */
+    [[nodiscard]] size_t bytesHeld() const { return bytesHeld_; }
+
+    /**
+     * Bytes of released blocks kept for reuse
+     */
+    [[nodiscard]] size_t bytesCached() const { return bytesCached_; }
+
+    /**
+     * Most bytes kept on the free lists (default kDefaultCacheLimit)
+     */
+    [[nodiscard]] size_t cacheLimit() const { return cacheLimit_; }
+
+    /**
+     * Change the cache cap; cached blocks above it are returned at once
+     * @param bytes New limit (0 = return every block when it is released)
+     */
+    void setCacheLimit(size_t bytes);
+
+    /**
+     * Return all cached blocks to the global heap
+     */
+    void release();
+
+private:
+    static constexpr size_t kMinClass = 6;   // 64 bytes
+    static constexpr size_t kClasses = 48;
+
+    std::vector<void*> freeLists_[kClasses];
+    size_t owned_[kClasses] = {};   // Blocks per class in use or cached
+    size_t upstreamAllocations_ = 0;
+    size_t bytesHeld_ = 0;
+    size_t bytesCached_ = 0;
+    size_t cacheLimit_ = kDefaultCacheLimit;
+
+    /**
+     * Give cached blocks back, largest first, until at most `limit` bytes stay
+     */
+    void trimTo(size_t limit);
+
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    static size_t sizeClass(size_t bytes);
+};
+
+#endif //COLUMNANALYZER_WORKERARENA_H
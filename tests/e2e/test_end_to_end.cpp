@@ -1,10 +1,22 @@
 #include <gtest/gtest.h>
 #include <filesystem>
 #include <fstream>
+#include <cstring>
 #include "DataGenerator.h"
 #include "CSVReader.h"
 #include "ParallelProcessor.h"
 #include "ResultAggregator.h"
+#include "AnalyzerServer.h"
+#include "InputResolver.h"
+#include "MultiFileAnalyzer.h"
+#include "ColumnarFile.h"
+#include "SampleEstimator.h"
+#include "PipelineExecutor.h"
+#include "AsyncFileReader.h"
+#include <thread>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
 
 namespace fs = std::filesystem;
 
@@ -91,6 +103,192 @@ TEST_F(EndToEndTest, SaveAndLoadResults) {
     EXPECT_EQ(lineCount, 4);  // 1 header + 3 data lines
 }
 
+TEST_F(EndToEndTest, BinaryResultsRoundTrip) {
+    DataGenerator generator;
+    generator.generateCSV(testFile, 200, 4);
+
+    auto columns = CSVReader::readColumns(testFile);
+    ParallelProcessor processor(2);
+    auto results = processor.process(columns, ParallelStrategy::THREADS);
+
+    // Values that break the text format
+    ColumnResult tricky;
+    tricky.columnIndex = 4;
+    tricky.columnName = "tricky";
+    tricky.uniqueValues = {"a;b", "line\nbreak", "", std::string("nul\0byte", 8)};
+    tricky.uniqueCount = tricky.uniqueValues.size();
+    results.push_back(tricky);
+
+    std::string binaryFile = testDir + "/full.pcol";
+    ResultAggregator aggregator;
+    aggregator.saveBinaryResultsToFile(results, binaryFile);
+
+    ColumnarFileReader reader(binaryFile);
+    ASSERT_EQ(reader.columns().size(), results.size());
+
+    for (size_t c = 0; c < results.size(); ++c) {
+        const auto& column = reader.columns()[c];
+        EXPECT_EQ(column.columnIndex, results[c].columnIndex);
+        EXPECT_EQ(column.name, results[c].columnName);
+        EXPECT_EQ(column.uniqueCount, results[c].uniqueCount);
+        ASSERT_EQ(column.size(), results[c].uniqueValues.size());
+
+        std::unordered_set<std::string> loaded;
+        for (size_t i = 0; i < column.size(); ++i) {
+            loaded.emplace(column.value(i));
+        }
+        EXPECT_EQ(loaded, results[c].uniqueValues);
+    }
+}
+
+TEST_F(EndToEndTest, BinaryResultsRejectForeignFile) {
+    std::ofstream(testFile) << "Column,UniqueCount,UniqueValues\n0,1,x\n";
+    EXPECT_THROW(ColumnarFileReader reader(testFile), std::runtime_error);
+}
+
+TEST_F(EndToEndTest, BinaryResultsRejectCorruptFiles) {
+    ColumnResult column;
+    column.columnIndex = 0;
+    column.columnName = "c";
+    column.uniqueValues = {"alpha", "beta", "gamma"};
+    column.uniqueCount = 3;
+
+    const std::string binaryFile = testDir + "/full.pcol";
+    ColumnarFileWriter::write({column}, binaryFile);
+    std::string valid;
+    {
+        std::ifstream in(binaryFile, std::ios::binary);
+        valid.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    ASSERT_NO_THROW(ColumnarFileReader reader(binaryFile));
+
+    // Layout: magic, u32 column count, then u64 index, u32 name length,
+    // name, u64 unique count, u64 value count, u64 offsets[count + 1], data
+    const size_t countPos = 8;
+    const size_t valueCountPos = countPos + 4 + 8 + 4 + 1 + 8;
+    const size_t offsetsPos = valueCountPos + 8;
+
+    auto corrupted = [&](size_t pos, uint64_t value, size_t bytes) {
+        std::string data = valid;
+        std::memcpy(&data[pos], &value, bytes);
+        std::ofstream(binaryFile, std::ios::binary | std::ios::trunc) << data;
+    };
+
+    corrupted(countPos, 0xFFFFFFFFu, 4);                 // Column count beyond file size
+    EXPECT_THROW(ColumnarFileReader reader(binaryFile), std::runtime_error);
+
+    corrupted(valueCountPos, ~uint64_t{0}, 8);           // (count + 1) * 8 would overflow
+    EXPECT_THROW(ColumnarFileReader reader(binaryFile), std::runtime_error);
+
+    corrupted(offsetsPos + 8, 1000, 8);                  // Offset past the data, not monotonic
+    EXPECT_THROW(ColumnarFileReader reader(binaryFile), std::runtime_error);
+
+    corrupted(offsetsPos + 3 * 8, 1 << 20, 8);           // Data length beyond file size
+    EXPECT_THROW(ColumnarFileReader reader(binaryFile), std::runtime_error);
+
+    std::ofstream(binaryFile, std::ios::binary | std::ios::trunc) << valid.substr(0, valid.size() - 1);
+    EXPECT_THROW(ColumnarFileReader reader(binaryFile), std::runtime_error);
+}
+
+TEST_F(EndToEndTest, SortedResultsAreIdenticalAcrossStrategies) {
+    // One column large enough for a multi-threaded sort, one small
+    {
+        std::ofstream out(testFile);
+        out << "id,code\n";
+        for (int i = 0; i < 40000; ++i) {
+            out << "id" << (i * 7919) % 40000 << "," << "c" << i % 97 << "\n";
+        }
+    }
+    auto columns = CSVReader::readColumns(testFile);
+
+    auto slurp = [](const std::string& filename) {
+        std::ifstream in(filename, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    };
+
+    std::vector<std::string> textOutputs;
+    std::vector<std::string> binaryOutputs;
+    size_t run = 0;
+    for (auto strategy : {ParallelStrategy::EXECUTION_POLICY, ParallelStrategy::THREADS,
+                          ParallelStrategy::ASYNC}) {
+        ParallelProcessor processor(1 + run);
+        auto results = processor.process(columns, strategy);
+
+        ResultAggregator aggregator(true, 1 + 2 * run);
+        const std::string base = testDir + "/sorted" + std::to_string(run++);
+        aggregator.saveFullResultsToFile(results, base + ".csv");
+        aggregator.saveBinaryResultsToFile(results, base + ".pcol");
+        textOutputs.push_back(slurp(base + ".csv"));
+        binaryOutputs.push_back(slurp(base + ".pcol"));
+
+        ColumnarFileReader reader(base + ".pcol");
+        for (const auto& column : reader.columns()) {
+            for (size_t i = 1; i < column.size(); ++i) {
+                ASSERT_LT(column.value(i - 1), column.value(i));
+            }
+        }
+    }
+
+    for (size_t i = 1; i < textOutputs.size(); ++i) {
+        EXPECT_EQ(textOutputs[i], textOutputs[0]);
+        EXPECT_EQ(binaryOutputs[i], binaryOutputs[0]);
+    }
+    EXPECT_NE(textOutputs[0].find("0,40000,id0;id1;id10;id100;"), std::string::npos);
+}
+
+TEST_F(EndToEndTest, SampledReadEstimatesWholeFile) {
+    DataGenerator generator;
+    generator.generateCSV(testFile, 100000, 4);
+
+    auto full = CSVReader::readTable(testFile);
+    ParallelProcessor processor(2);
+    auto exact = processor.process(full.columns, ParallelStrategy::THREADS);
+
+    SampleOptions options;
+    options.blocks = 32;
+    options.blockSize = 16 * 1024;
+
+    SampleInfo info;
+    auto sample = CSVReader::readSample(testFile, options, &info);
+
+    EXPECT_FALSE(info.exact);
+    EXPECT_EQ(sample.headers, full.headers);
+    EXPECT_EQ(info.blockRows.size(), options.blocks);
+    EXPECT_LT(info.sampledRows, 50000);
+    EXPECT_NEAR(static_cast<double>(info.estimatedRows), 100000.0, 5000.0);
+
+    // Every sampled row is a complete row of the file
+    std::unordered_set<std::string> fullInts(full.columns[0].begin(), full.columns[0].end());
+    for (size_t c = 0; c < sample.columns.size(); ++c) {
+        EXPECT_EQ(sample.columns[c].size(), info.sampledRows);
+    }
+    for (const auto& value : sample.columns[0]) {
+        ASSERT_TRUE(fullInts.count(value)) << value;
+    }
+
+    // Low-cardinality column is found completely
+    auto estimate = SampleEstimator::estimate(sample.columns[3], info);
+    EXPECT_DOUBLE_EQ(estimate.estimate, static_cast<double>(exact[3].uniqueCount));
+
+    // High-cardinality column is extrapolated
+    estimate = SampleEstimator::estimate(sample.columns[2], info);
+    EXPECT_NEAR(estimate.estimate, static_cast<double>(exact[2].uniqueCount),
+                0.2 * static_cast<double>(exact[2].uniqueCount));
+}
+
+TEST_F(EndToEndTest, SampleOfSmallFileIsExact) {
+    DataGenerator generator;
+    generator.generateCSV(testFile, 500, 3);
+
+    SampleInfo info;
+    auto sample = CSVReader::readSample(testFile, SampleOptions{}, &info);
+
+    EXPECT_TRUE(info.exact);
+    EXPECT_EQ(info.sampledRows, 500);
+    EXPECT_EQ(info.estimatedRows, 500);
+    EXPECT_EQ(sample.columns[0].size(), 500);
+}
+
 TEST_F(EndToEndTest, LargeDataset) {
     // Test with larger dataset
     DataGenerator generator;
@@ -113,6 +311,442 @@ TEST_F(EndToEndTest, LargeDataset) {
     }
 }
 
+TEST_F(EndToEndTest, HashOncePipeline) {
+    DataGenerator generator;
+    generator.generateCSV(testFile, 500, 4);
+
+    auto table = CSVReader::readTable(testFile, true);
+
+    ASSERT_EQ(table.headers.size(), 4);
+    EXPECT_EQ(table.headers[0], "col0");
+    ASSERT_EQ(table.cellHashes.size(), 4);
+    EXPECT_EQ(table.cellHashes[0].size(), 500);
+
+    ParallelProcessor processor(2);
+    auto plain = processor.process(table.columns, ParallelStrategy::THREADS);
+    auto hashed = processor.process(table.columns, table.cellHashes, ParallelStrategy::ASYNC);
+
+    ASSERT_EQ(plain.size(), hashed.size());
+    for (size_t i = 0; i < plain.size(); ++i) {
+        EXPECT_EQ(plain[i].uniqueCount, hashed[i].uniqueCount);
+    }
+}
+
+static std::string socketRequest(const std::string& socketPath, const std::string& line) {
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, socketPath.c_str(), sizeof(addr.sun_path) - 1);
+    if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        close(fd);
+        return "";
+    }
+
+    std::string request = line + "\n";
+    send(fd, request.data(), request.size(), 0);
+
+    std::string response;
+    char c;
+    while (recv(fd, &c, 1, 0) == 1 && c != '\n') {
+        response += c;
+    }
+    close(fd);
+    return response;
+}
+
+TEST_F(EndToEndTest, ServerBatchesAndCaches) {
+    DataGenerator generator;
+    generator.generateCSV(testFile, 200, 3);
+
+    ServerOptions options;
+    options.socketPath = testDir + "/server.sock";
+    options.numThreads = 2;
+    options.batchWindow = std::chrono::milliseconds(20);
+
+    AnalyzerServer server(options);
+    std::thread serverThread([&server]() { server.run(); });
+    ASSERT_TRUE(server.waitUntilListening(std::chrono::seconds(5)));
+
+    EXPECT_EQ(socketRequest(options.socketPath, "PING"), R"({"status":"ok"})");
+
+    // Two simultaneous requests for the same table share one batch
+    std::string first;
+    std::string second;
+    std::thread a([&]() { first = socketRequest(options.socketPath, "ANALYZE " + testFile); });
+    std::thread b([&]() { second = socketRequest(options.socketPath, "ANALYZE " + testFile); });
+    a.join();
+    b.join();
+
+    EXPECT_NE(first.find(R"("status":"ok")"), std::string::npos);
+    EXPECT_NE(first.find(R"("rows":200)"), std::string::npos);
+    EXPECT_NE(first.find(R"("name":"col2")"), std::string::npos);
+    EXPECT_NE(second.find(R"("rows":200)"), std::string::npos);
+
+    auto cached = socketRequest(options.socketPath, "ANALYZE " + testFile);
+    EXPECT_NE(cached.find(R"("cached":true)"), std::string::npos);
+
+    auto missing = socketRequest(options.socketPath, "ANALYZE " + testDir + "/missing.csv");
+    EXPECT_NE(missing.find(R"("status":"error")"), std::string::npos);
+
+    auto stats = socketRequest(options.socketPath, "STATS");
+    EXPECT_NE(stats.find(R"("cache_misses":1)"), std::string::npos);
+
+    socketRequest(options.socketPath, "SHUTDOWN");
+    serverThread.join();
+}
+
+TEST_F(EndToEndTest, ServerAnswersAfterFailedAnalysis) {
+    DataGenerator generator;
+    generator.generateCSV(testFile, 200, 3);
+
+    ServerOptions options;
+    options.socketPath = testDir + "/server.sock";
+    options.numThreads = 2;
+    options.analyzerOptions.backend = DistinctBackend::FINGERPRINT;
+    options.analyzerOptions.fingerprintBits = 32;  // Rejected by every column job
+
+    AnalyzerServer server(options);
+    std::thread serverThread([&server]() { server.run(); });
+    ASSERT_TRUE(server.waitUntilListening(std::chrono::seconds(5)));
+
+    auto failed = socketRequest(options.socketPath, "ANALYZE " + testFile);
+    EXPECT_NE(failed.find(R"("status":"error")"), std::string::npos);
+    EXPECT_NE(failed.find("Unsupported fingerprint width"), std::string::npos) << failed;
+
+    // The dispatcher survived: later requests are still answered
+    EXPECT_EQ(socketRequest(options.socketPath, "PING"), R"({"status":"ok"})");
+    auto again = socketRequest(options.socketPath, "ANALYZE " + testFile);
+    EXPECT_NE(again.find(R"("status":"error")"), std::string::npos);
+    EXPECT_NE(socketRequest(options.socketPath, "STATS").find(R"("requests":)"), std::string::npos);
+
+    socketRequest(options.socketPath, "SHUTDOWN");
+    serverThread.join();
+}
+
+static size_t openFdCount() {
+    size_t count = 0;
+    for (const auto& entry : fs::directory_iterator("/proc/self/fd")) {
+        (void)entry;
+        ++count;
+    }
+    return count;
+}
+
+TEST_F(EndToEndTest, ServerReleasesDisconnectedClients) {
+    if (!fs::exists("/proc/self/fd")) {
+        GTEST_SKIP() << "No /proc/self/fd";
+    }
+
+    ServerOptions options;
+    options.socketPath = testDir + "/server.sock";
+    options.numThreads = 2;
+
+    AnalyzerServer server(options);
+    std::thread serverThread([&server]() { server.run(); });
+    ASSERT_TRUE(server.waitUntilListening(std::chrono::seconds(5)));
+    ASSERT_EQ(socketRequest(options.socketPath, "PING"), R"({"status":"ok"})");
+
+    // Disconnected clients are reaped within one accept poll interval
+    auto settledFdCount = [&]() {
+        size_t count = openFdCount();
+        for (int i = 0; i < 20; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            size_t now = openFdCount();
+            if (now == count) break;
+            count = now;
+        }
+        return count;
+    };
+
+    const size_t baseline = settledFdCount();
+    for (int i = 0; i < 1500; ++i) {
+        ASSERT_EQ(socketRequest(options.socketPath, "PING"), R"({"status":"ok"})") << "request " << i;
+    }
+    EXPECT_LE(settledFdCount(), baseline + 2);
+
+    socketRequest(options.socketPath, "SHUTDOWN");
+    serverThread.join();
+}
+
+TEST_F(EndToEndTest, SampledReadClosesFileWhenCancelled) {
+    if (!fs::exists("/proc/self/fd")) {
+        GTEST_SKIP() << "No /proc/self/fd";
+    }
+
+    DataGenerator generator;
+    generator.generateCSV(testFile, 100000, 4);
+
+    SampleOptions options;
+    options.blocks = 4;
+    options.blockSize = 256 * 1024;
+
+    const size_t before = openFdCount();
+    CancellationToken token;
+    token.cancel();
+    {
+        CancellationToken::Scope scope(&token);
+        EXPECT_THROW(CSVReader::readSample(testFile, options), OperationCancelled);
+    }
+    EXPECT_EQ(openFdCount(), before);
+}
+
+TEST_F(EndToEndTest, BlockReadersMatchStreamReader) {
+    DataGenerator generator;
+    generator.generateCSV(testFile, 2000, 4);  // Spans many 4 KiB blocks
+
+    auto expected = CSVReader::readTable(testFile);
+
+    for (IoBackend backend : {IoBackend::PREAD, IoBackend::IO_URING}) {
+        AsyncReadOptions options;
+        options.backend = backend;
+        options.blockSize = 4096;
+        options.queueDepth = 3;
+
+        if (backend == IoBackend::IO_URING && !AsyncFileReader::ioUringAvailable()) {
+            EXPECT_THROW(CSVReader::readTableAsync(testFile, options), std::runtime_error);
+            continue;
+        }
+
+        ReadStats stats;
+        auto table = CSVReader::readTableAsync(testFile, options, false, &stats);
+
+        EXPECT_EQ(table.headers, expected.headers);
+        EXPECT_EQ(table.columns, expected.columns);
+        EXPECT_EQ(stats.bytes, fs::file_size(testFile));
+        EXPECT_NE(stats.backend, IoBackend::AUTO);
+        if (backend == IoBackend::PREAD) {
+            EXPECT_EQ(stats.backend, IoBackend::PREAD);
+        }
+    }
+}
+
+TEST_F(EndToEndTest, BlockHandlerErrorsPropagate) {
+    DataGenerator generator;
+    generator.generateCSV(testFile, 2000, 4);
+
+    std::vector<IoBackend> backends = {IoBackend::AUTO, IoBackend::PREAD};
+    if (AsyncFileReader::ioUringAvailable()) {
+        backends.push_back(IoBackend::IO_URING);
+    }
+    for (IoBackend backend : backends) {
+        AsyncReadOptions options;
+        options.backend = backend;
+        options.blockSize = 4096;
+
+        // Must not be mistaken for io_uring being unavailable and re-read with pread
+        size_t calls = 0;
+        AsyncFileReader reader(options);
+        EXPECT_THROW(reader.read(testFile, [&](const char*, size_t) {
+            ++calls;
+            throw std::invalid_argument("bad block");
+        }), std::invalid_argument);
+        EXPECT_EQ(calls, 1);
+    }
+}
+
+TEST_F(EndToEndTest, BlockReaderWithoutTrailingNewline) {
+    std::ofstream(testFile) << "a,b\n1,2\n\n3,4";
+
+    AsyncReadOptions options;
+    options.blockSize = 4096;
+    auto table = CSVReader::readTableAsync(testFile, options);
+
+    ASSERT_EQ(table.columns.size(), 2);
+    EXPECT_EQ(table.columns[0], (std::vector<std::string>{"1", "3"}));
+    EXPECT_EQ(table.columns[1], (std::vector<std::string>{"2", "4"}));
+}
+
+TEST_F(EndToEndTest, PipelineMatchesMaterializedAnalysis) {
+    DataGenerator generator;
+    generator.generateCSV(testFile, 3000, 5);
+
+    auto table = CSVReader::readTable(testFile);
+    AnalyzerOptions options;
+    options.statistics = STAT_NULLS | STAT_MINMAX | STAT_LENGTHS;
+    auto expected = ParallelProcessor(2, options).process(table.columns, ParallelStrategy::THREADS);
+
+    for (bool hashes : {false, true}) {
+        PipelineOptions pipeline;
+        pipeline.chunkBytes = 4096;  // Many chunks, cut mid-block
+        pipeline.chunksInFlight = 2;
+        pipeline.computeHashes = hashes;
+        pipeline.io.blockSize = 8192;
+
+        PipelineExecutor executor(3, options, pipeline);
+        auto results = executor.run(testFile);
+
+        EXPECT_EQ(executor.headers(), table.headers);
+        EXPECT_EQ(executor.stats().rows, 3000);
+        EXPECT_GT(executor.stats().chunks, 1);
+        ASSERT_EQ(results.size(), expected.size());
+        for (size_t i = 0; i < results.size(); ++i) {
+            EXPECT_EQ(results[i].columnIndex, i);
+            EXPECT_TRUE(results[i].complete);
+            EXPECT_EQ(results[i].uniqueValues, expected[i].uniqueValues);
+            EXPECT_EQ(results[i].statistics.nullCount, expected[i].statistics.nullCount);
+            EXPECT_EQ(results[i].statistics.minValue, expected[i].statistics.minValue);
+            EXPECT_EQ(results[i].statistics.maxValue, expected[i].statistics.maxValue);
+            EXPECT_EQ(results[i].statistics.rowCount, expected[i].statistics.rowCount);
+            EXPECT_EQ(results[i].statistics.lengthHistogram, expected[i].statistics.lengthHistogram);
+        }
+    }
+}
+
+TEST_F(EndToEndTest, PipelineWithoutTrailingNewline) {
+    std::ofstream(testFile) << "a,b\n1,2\n\n3,4\n1,5";
+
+    auto results = PipelineExecutor(2).run(testFile);
+
+    ASSERT_EQ(results.size(), 2);
+    EXPECT_EQ(results[0].uniqueCount, 2);
+    EXPECT_EQ(results[1].uniqueCount, 3);
+}
+
+TEST_F(EndToEndTest, PipelineMissingFileThrows) {
+    PipelineExecutor executor(2);
+    EXPECT_THROW(executor.run(testDir + "/missing.csv"), std::runtime_error);
+}
+
+TEST_F(EndToEndTest, PipelineCancelledMarksColumnsIncomplete) {
+    DataGenerator generator;
+    generator.generateCSV(testFile, 1000, 3);
+
+    CancellationToken token;
+    token.cancel();
+    PipelineOptions pipeline;
+    pipeline.chunkBytes = 4096;
+    PipelineExecutor executor(2, {}, pipeline);
+    executor.setCancellation(&token);
+
+    auto results = executor.run(testFile);
+    ASSERT_EQ(results.size(), 3);
+    EXPECT_EQ(executor.stats().rows, 0);
+    for (const auto& result : results) {
+        EXPECT_FALSE(result.complete);
+    }
+}
+
+TEST_F(EndToEndTest, PipelineStreamsFullResultsInColumnOrder) {
+    DataGenerator generator;
+    generator.generateCSV(testFile, 5000, 6);
+
+    auto table = CSVReader::readTable(testFile);
+    auto expected = ParallelProcessor(2).process(table.columns, ParallelStrategy::THREADS);
+    const std::string expectedFile = testDir + "/expected_full.csv";
+    ResultAggregator(true, 2).saveFullResultsToFile(expected, expectedFile);
+
+    PipelineOptions pipeline;
+    pipeline.chunkBytes = 4096;
+    pipeline.fullResultsFile = testDir + "/pipeline_full.csv";
+    pipeline.sortedValues = true;
+    PipelineExecutor executor(3, {}, pipeline);
+    auto results = executor.run(testFile);
+
+    ASSERT_EQ(results.size(), expected.size());
+    for (size_t i = 0; i < results.size(); ++i) {
+        EXPECT_TRUE(results[i].complete);
+        EXPECT_EQ(results[i].uniqueValues, expected[i].uniqueValues);
+    }
+    EXPECT_TRUE(executor.stats().fullResultsWritten);
+
+    auto slurp = [](const std::string& path) {
+        std::ifstream in(path);
+        return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    };
+    EXPECT_EQ(slurp(pipeline.fullResultsFile), slurp(expectedFile));
+}
+
+TEST_F(EndToEndTest, PipelineCancelledLeavesNoFullResults) {
+    DataGenerator generator;
+    generator.generateCSV(testFile, 1000, 3);
+
+    CancellationToken token;
+    token.cancel();
+    PipelineOptions pipeline;
+    pipeline.fullResultsFile = testDir + "/pipeline_full.csv";
+    PipelineExecutor executor(2, {}, pipeline);
+    executor.setCancellation(&token);
+
+    executor.run(testFile);
+    EXPECT_FALSE(executor.stats().fullResultsWritten);
+    EXPECT_FALSE(fs::exists(pipeline.fullResultsFile));
+}
+
+TEST_F(EndToEndTest, MultiFileMergeByHeaderName) {
+    fs::create_directories(testDir + "/shards");
+    std::ofstream(testDir + "/shards/part-0.csv") << "id,kind\n1,a\n2,b\n3,a\n";
+    std::ofstream(testDir + "/shards/part-1.csv") << "kind,id,extra\nc,3,x\na,4,y\n";
+    std::ofstream(testDir + "/shards/part-2.csv") << "id\n5\n1\n";
+    std::ofstream(testDir + "/shards/notes.txt") << "ignored";
+
+    auto fromGlob = InputResolver::resolve(testDir + "/shards/part-*.csv");
+    auto fromDir = InputResolver::resolve(testDir + "/shards");
+    ASSERT_EQ(fromGlob.size(), 3);
+    EXPECT_EQ(fromGlob, fromDir);
+    EXPECT_TRUE(InputResolver::isMultiInput(testDir + "/shards"));
+    EXPECT_FALSE(InputResolver::isMultiInput(testFile));
+
+    AnalyzerOptions options;
+    options.statistics = STAT_NULLS | STAT_MINMAX;
+    MultiFileAnalyzer analyzer(3, options);
+    auto results = analyzer.analyze(fromGlob);
+
+    ASSERT_EQ(results.size(), 3);
+    EXPECT_EQ(results[0].columnName, "id");
+    EXPECT_EQ(results[0].uniqueCount, 5);              // 1..5
+    EXPECT_EQ(results[0].statistics.rowCount, 7);
+    EXPECT_EQ(results[0].statistics.maxValue, "5");
+    EXPECT_EQ(results[1].columnName, "kind");
+    EXPECT_EQ(results[1].uniqueCount, 3);              // a, b, c
+    EXPECT_EQ(results[2].columnName, "extra");
+    EXPECT_EQ(results[2].uniqueCount, 2);
+    for (size_t i = 0; i < results.size(); ++i) {
+        EXPECT_EQ(results[i].columnIndex, i);
+    }
+
+    std::string countsFile = testDir + "/merged_counts.csv";
+    ResultAggregator().saveCountsToFile(results, countsFile);
+    std::ifstream counts(countsFile);
+    std::string header, first;
+    std::getline(counts, header);
+    std::getline(counts, first);
+    EXPECT_EQ(first, "id,5");
+}
+
+TEST_F(EndToEndTest, MultiFileHonoursCancellation) {
+    DataGenerator generator;
+    std::vector<std::string> files;
+    for (int i = 0; i < 3; ++i) {
+        files.push_back(testDir + "/shard" + std::to_string(i) + ".csv");
+        generator.generateCSV(files.back(), 300, 3);
+    }
+
+    MultiFileAnalyzer analyzer(2);
+    CancellationToken token;
+    {
+        CancellationToken::Scope scope(&token);
+        auto results = analyzer.analyze(files);
+        for (const auto& result : results) {
+            EXPECT_TRUE(result.complete);
+        }
+
+        token.cancel();
+        results = analyzer.analyze(files);  // No shard is read: nothing is complete
+        for (const auto& result : results) {
+            EXPECT_FALSE(result.complete);
+        }
+    }
+
+    // Without a scope the pool tasks are never cancelled
+    for (const auto& result : analyzer.analyze(files)) {
+        EXPECT_TRUE(result.complete);
+    }
+}
+
+TEST_F(EndToEndTest, MultiFileMissingInputThrows) {
+    EXPECT_THROW(InputResolver::resolve(testDir + "/none-*.csv"), std::runtime_error);
+}
+
 TEST_F(EndToEndTest, InvalidFile) {
     // Try to read non-existent file
     EXPECT_THROW(CSVReader::readColumns("nonexistent.csv"), std::runtime_error);
@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include "ColumnAccumulator.h"
+#include "CellHash.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+    std::vector<std::string> sampleColumn() {
+        std::vector<std::string> column;
+        for (int i = 0; i < 9000; ++i) {
+            column.push_back("v" + std::to_string((i * 7919) % 4000));
+        }
+        return column;
+    }
+
+    ColumnResult accumulateInChunks(const std::vector<std::string>& column,
+                                    const AnalyzerOptions& options, bool hashes) {
+        ColumnAccumulator accumulator(2, options);
+        for (size_t begin = 0; begin < column.size(); begin += 2500) {
+            std::vector<std::string> chunk(column.begin() + begin,
+                                           column.begin() + std::min(column.size(), begin + 2500));
+            std::vector<uint64_t> cellHashes;
+            for (const auto& value : chunk) {
+                cellHashes.push_back(CellHash::hash(value));
+            }
+            accumulator.add(chunk, hashes ? &cellHashes : nullptr);
+        }
+        return accumulator.finish();
+    }
+
+} // namespace
+
+TEST(ColumnAccumulatorTest, MatchesWholeColumn) {
+    auto column = sampleColumn();
+    auto whole = ColumnAnalyzer::analyze(2, column);
+
+    for (auto backend : {DistinctBackend::HASH, DistinctBackend::AUTO, DistinctBackend::BITMAP}) {
+        for (bool hashes : {false, true}) {
+            AnalyzerOptions options;
+            options.backend = backend;
+            auto result = accumulateInChunks(column, options, hashes);
+            EXPECT_EQ(result.columnIndex, 2);
+            EXPECT_TRUE(result.complete);
+            EXPECT_EQ(result.uniqueCount, whole.uniqueCount);
+            EXPECT_EQ(result.uniqueValues, whole.uniqueValues);
+        }
+    }
+}
+
+TEST(ColumnAccumulatorTest, StatisticsAnalyzeEachChunk) {
+    AnalyzerOptions options;
+    options.statistics = STAT_NULLS;
+    ColumnAccumulator accumulator(0, options);
+
+    std::vector<std::string> first = {"", "a", "a"};
+    std::vector<std::string> second = {"b", ""};
+    accumulator.add(first);
+    accumulator.add(second);
+    auto result = accumulator.finish();
+
+    EXPECT_EQ(result.uniqueCount, 3);
+    EXPECT_EQ(result.statistics.nullCount, 2);
+}
+
+TEST(ColumnAccumulatorTest, FinishLeavesItEmpty) {
+    ColumnAccumulator accumulator(1, {});
+    std::vector<std::string> chunk = {"x", "y", "x"};
+    accumulator.add(chunk);
+    EXPECT_EQ(accumulator.finish().uniqueCount, 2);
+    EXPECT_EQ(accumulator.finish().uniqueCount, 0);
+
+    std::vector<std::string> values = {"x"};
+    std::vector<uint64_t> hashes;
+    EXPECT_THROW(accumulator.add(values, &hashes), std::invalid_argument);
+}
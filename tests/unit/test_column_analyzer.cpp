@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 #include "ColumnAnalyzer.h"
+#include "CellHash.h"
+#include "SortDistinct.h"
+#include "AnalyzerKernel.h"
 
 class ColumnAnalyzerTest : public ::testing::Test {
 protected:
@@ -71,3 +74,331 @@ TEST_F(ColumnAnalyzerTest, LargeDataset) {
     EXPECT_EQ(result.uniqueCount, 100);
 }
 
+static std::vector<uint64_t> hashAll(const std::vector<std::string>& data) {
+    std::vector<uint64_t> hashes;
+    hashes.reserve(data.size());
+    for (const auto& value : data) {
+        hashes.push_back(CellHash::hash(value));
+    }
+    return hashes;
+}
+
+TEST_F(ColumnAnalyzerTest, PrecomputedHashesMatchPlain) {
+    std::vector<std::string> data;
+    for (int i = 0; i < 5000; ++i) {
+        data.push_back("str_" + std::to_string((i * 7919) % 1234));
+    }
+
+    auto plain = ColumnAnalyzer::analyze(0, data);
+    auto hashed = ColumnAnalyzer::analyze(0, data, hashAll(data));
+
+    EXPECT_EQ(hashed.uniqueCount, plain.uniqueCount);
+    EXPECT_EQ(hashed.uniqueValues, plain.uniqueValues);
+}
+
+TEST_F(ColumnAnalyzerTest, HashCollisionsComparedByValue) {
+    // Every cell gets the same hash: distinctness must come from byte comparison
+    std::vector<std::string> data = {"a", "b", "a", "c", "b"};
+    std::vector<uint64_t> hashes(data.size(), 42);
+
+    auto result = ColumnAnalyzer::analyze(0, data, hashes);
+
+    EXPECT_EQ(result.uniqueCount, 3);
+}
+
+TEST_F(ColumnAnalyzerTest, HashCountMismatchThrows) {
+    std::vector<std::string> data = {"a", "b"};
+    std::vector<uint64_t> hashes = {1};
+
+    EXPECT_THROW(ColumnAnalyzer::analyze(0, data, hashes), std::invalid_argument);
+}
+
+TEST_F(ColumnAnalyzerTest, BatchedInsertMatchesPlain) {
+    std::vector<std::string> data;
+    for (int i = 0; i < 3001; ++i) {
+        data.push_back("v" + std::to_string((i * 31) % 997));
+    }
+    auto hashes = hashAll(data);
+    auto plain = ColumnAnalyzer::analyze(0, data);
+
+    for (size_t batch : {1, 7, 16, 64, 1000}) {
+        auto batched = ColumnAnalyzer::analyzeBatched(0, data, batch);
+        auto batchedHashed = ColumnAnalyzer::analyzeBatched(0, data, batch, &hashes);
+
+        EXPECT_EQ(batched.uniqueCount, plain.uniqueCount) << "batch " << batch;
+        EXPECT_EQ(batched.uniqueValues, plain.uniqueValues) << "batch " << batch;
+        EXPECT_EQ(batchedHashed.uniqueCount, plain.uniqueCount) << "batch " << batch;
+    }
+}
+
+TEST_F(ColumnAnalyzerTest, SortBackendMatchesHash) {
+    std::vector<std::string> data;
+    for (int i = 0; i < 100000; ++i) {
+        data.push_back("id_" + std::to_string((i * 7919) % 60000));
+    }
+    auto plain = ColumnAnalyzer::analyze(0, data);
+
+    for (size_t threads : {1, 4}) {
+        auto sorted = ColumnAnalyzer::analyzeSorted(0, data, threads);
+        EXPECT_EQ(sorted.uniqueCount, plain.uniqueCount) << threads << " threads";
+        EXPECT_EQ(sorted.uniqueValues, plain.uniqueValues) << threads << " threads";
+    }
+}
+
+TEST_F(ColumnAnalyzerTest, ParallelSortOrdersKeys) {
+    std::vector<std::string> storage;
+    for (int i = 0; i < 70000; ++i) {
+        storage.push_back(std::to_string((i * 104729LL) % 70001));
+    }
+    std::vector<std::string_view> keys(storage.begin(), storage.end());
+
+    SortDistinct::parallelSort(keys, 5);
+
+    EXPECT_TRUE(std::is_sorted(keys.begin(), keys.end()));
+    EXPECT_EQ(keys.size(), storage.size());
+}
+
+TEST_F(ColumnAnalyzerTest, ParallelSortChunksLargeInputs) {
+    std::vector<std::string> storage;
+    for (int i = 0; i < 2500000; ++i) {
+        storage.push_back(std::to_string((i * 104729LL) % 2500003));
+    }
+    std::vector<std::string_view> keys(storage.begin(), storage.end());
+
+    // More than one chunk on one thread: chunk sorts plus merge rounds
+    SortDistinct::parallelSort(keys, 1);
+    EXPECT_TRUE(std::is_sorted(keys.begin(), keys.end()));
+
+    // A cancelled caller stops between chunks
+    std::reverse(keys.begin(), keys.end());
+    CancellationToken token;
+    token.cancel();
+    CancellationToken::Scope scope(&token);
+    EXPECT_THROW(SortDistinct::parallelSort(keys, 1), OperationCancelled);
+    EXPECT_THROW(SortDistinct::parallelSort(keys, 3), OperationCancelled);
+}
+
+TEST_F(ColumnAnalyzerTest, AutoBackendFollowsCardinality) {
+    std::vector<std::string> unique;
+    std::vector<std::string> repeated;
+    std::vector<std::string> codes;
+    for (size_t i = 0; i < 2 * ColumnAnalyzer::kMinSortRows; ++i) {
+        unique.push_back("id" + std::to_string(i));
+        repeated.push_back("v" + std::to_string(i % 26));
+        codes.push_back(std::to_string(i % 26));
+    }
+
+    AnalyzerOptions options;
+    options.backend = DistinctBackend::AUTO;
+
+    EXPECT_EQ(ColumnAnalyzer::chooseBackend(unique, options), DistinctBackend::SORT);
+    EXPECT_EQ(ColumnAnalyzer::chooseBackend(repeated, options), DistinctBackend::HASH);
+    EXPECT_EQ(ColumnAnalyzer::chooseBackend({"ab", "cd"}, options), DistinctBackend::HASH);
+
+    // Small domains: single characters and small integer codes
+    EXPECT_EQ(ColumnAnalyzer::chooseBackend({"a", "b"}, options), DistinctBackend::BITMAP);
+    EXPECT_EQ(ColumnAnalyzer::chooseBackend(codes, options), DistinctBackend::BITMAP);
+    EXPECT_EQ(ColumnAnalyzer::chooseBackend({"7", "99999999"}, options), DistinctBackend::HASH);
+    EXPECT_EQ(ColumnAnalyzer::chooseBackend({"7", "007"}, options), DistinctBackend::HASH);
+
+    EXPECT_EQ(backendFromString("bitmap"), DistinctBackend::BITMAP);
+    EXPECT_THROW(backendFromString("btree"), std::invalid_argument);
+}
+
+TEST_F(ColumnAnalyzerTest, KernelOverIntegerValues) {
+    std::vector<int64_t> values = {5, -1, 5, 7, -1, 5};
+
+    auto result = AnalyzerKernel::run<StaticStatistics<STAT_NONE>>(
+            0, values, AnalyzerKernel::HashValues{}, AnalyzerKernel::IndexSet{});
+
+    EXPECT_EQ(result.uniqueCount, 3);
+    EXPECT_EQ(result.uniqueValues, (std::unordered_set<std::string>{"5", "-1", "7"}));
+}
+
+TEST_F(ColumnAnalyzerTest, EveryKernelMatchesReference) {
+    std::vector<std::string> column;
+    std::vector<uint64_t> hashes;
+    for (int i = 0; i < 3000; ++i) {
+        column.push_back(i % 7 == 0 ? "" : std::to_string(i % 401));
+        hashes.push_back(CellHash::hash(column.back()));
+    }
+    std::unordered_set<std::string> expected(column.begin(), column.end());
+
+    for (auto backend : {DistinctBackend::HASH, DistinctBackend::SORT, DistinctBackend::BITMAP}) {
+        for (size_t batch : {0, 16}) {
+            for (unsigned flags : {unsigned{STAT_NONE}, unsigned{STAT_NULLS | STAT_LENGTHS}, unsigned{STAT_ALL}}) {
+                AnalyzerOptions options;
+                options.backend = backend;
+                options.insertBatchSize = batch;
+                options.statistics = flags;
+
+                for (bool reuseHashes : {false, true}) {
+                    const std::vector<uint64_t>* cellHashes = reuseHashes ? &hashes : nullptr;
+                    auto result = ColumnAnalyzer::analyze(0, column, options, cellHashes);
+                    EXPECT_EQ(result.uniqueValues, expected);
+                    EXPECT_EQ(result.statistics.computed, flags);
+                    if (flags & STAT_NULLS) {
+                        EXPECT_EQ(result.statistics.nullCount, 429);
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST_F(ColumnAnalyzerTest, BitmapBackendSmallDomains) {
+    std::vector<std::string> letters;
+    std::vector<std::string> codes;
+    for (int i = 0; i < 100000; ++i) {
+        letters.push_back(std::string(1, static_cast<char>('A' + i % 26)));
+        // Keys on both sides of the direct bit vector
+        codes.push_back(std::to_string(i % 3 == 0 ? 70000 + i % 500 : i % 1000));
+    }
+
+    auto byLetter = ColumnAnalyzer::analyzeBitmap(0, letters);
+    EXPECT_EQ(byLetter.uniqueCount, 26);
+    EXPECT_EQ(byLetter.bitmap.encoding, BitmapEncoding::BYTE);
+    EXPECT_EQ(byLetter.uniqueValues, std::unordered_set<std::string>(letters.begin(), letters.end()));
+
+    auto byCode = ColumnAnalyzer::analyzeBitmap(1, codes);
+    std::unordered_set<std::string> expected(codes.begin(), codes.end());
+    EXPECT_EQ(byCode.uniqueCount, expected.size());
+    EXPECT_EQ(byCode.bitmap.encoding, BitmapEncoding::INTEGER);
+    EXPECT_EQ(byCode.bitmap.keys.cardinality(), expected.size());
+    EXPECT_TRUE(byCode.bitmap.keys.contains(70499));
+    EXPECT_EQ(byCode.uniqueValues, expected);
+}
+
+TEST_F(ColumnAnalyzerTest, BitmapBackendFallsBackOnIrregularCells) {
+    std::vector<std::string> column;
+    std::vector<uint64_t> hashes;
+    for (int i = 0; i < 200000; ++i) {
+        // Past the first chunk, a cell that is not a canonical integer
+        column.push_back(i == 150000 ? "0150" : std::to_string(i % 5000));
+        hashes.push_back(CellHash::hash(column.back()));
+    }
+    std::unordered_set<std::string> expected(column.begin(), column.end());
+
+    AnalyzerOptions options;
+    options.backend = DistinctBackend::BITMAP;
+    options.statistics = STAT_ALL;
+
+    const std::vector<uint64_t>* variants[] = {nullptr, &hashes};
+    for (const auto* cellHashes : variants) {
+        auto result = ColumnAnalyzer::analyze(0, column, options, cellHashes);
+        EXPECT_EQ(result.uniqueCount, 5001);
+        EXPECT_EQ(result.uniqueValues, expected);
+        EXPECT_FALSE(result.bitmap.valid());
+        EXPECT_EQ(result.statistics.rowCount, column.size());
+    }
+}
+
+TEST_F(ColumnAnalyzerTest, BitmapsMergeAcrossChunks) {
+    std::vector<std::string> first;
+    std::vector<std::string> second;
+    for (int i = 0; i < 50000; ++i) {
+        first.push_back(std::to_string(i % 3000));
+        second.push_back(std::to_string(2000 + i % 9000));
+    }
+    std::vector<std::string> whole = first;
+    whole.insert(whole.end(), second.begin(), second.end());
+
+    auto merged = ColumnAnalyzer::analyzeBitmap(0, first);
+    merged.bitmap.merge(ColumnAnalyzer::analyzeBitmap(0, second).bitmap);
+    auto reference = ColumnAnalyzer::analyzeBitmap(0, whole);
+
+    EXPECT_EQ(merged.bitmap.keys, reference.bitmap.keys);
+    EXPECT_EQ(merged.bitmap.keys.cardinality(), 11000);
+
+    auto restored = ValueBitmap::deserialize(merged.bitmap.serialize());
+    EXPECT_EQ(restored.encoding, BitmapEncoding::INTEGER);
+    EXPECT_EQ(restored.keys, reference.bitmap.keys);
+}
+
+namespace {
+
+    ColumnResult analyzeChunk(const std::vector<std::string>& column, size_t begin, size_t end) {
+        AnalyzerOptions options;
+        options.statistics = STAT_ALL;
+        std::vector<std::string> chunk(column.begin() + begin, column.begin() + end);
+        return ColumnAnalyzer::analyze(0, chunk, options);
+    }
+
+    void expectSameResult(const ColumnResult& a, const ColumnResult& b) {
+        EXPECT_EQ(a.uniqueValues, b.uniqueValues);
+        EXPECT_EQ(a.uniqueCount, b.uniqueCount);
+        EXPECT_EQ(a.statistics.rowCount, b.statistics.rowCount);
+        EXPECT_EQ(a.statistics.nullCount, b.statistics.nullCount);
+        EXPECT_EQ(a.statistics.minValue, b.statistics.minValue);
+        EXPECT_EQ(a.statistics.maxValue, b.statistics.maxValue);
+        EXPECT_EQ(a.statistics.lengthHistogram, b.statistics.lengthHistogram);
+        EXPECT_EQ(a.statistics.numericCount, b.statistics.numericCount);
+        EXPECT_NEAR(a.statistics.mean, b.statistics.mean, 1e-9);
+        EXPECT_NEAR(a.statistics.stddev, b.statistics.stddev, 1e-9);
+        EXPECT_EQ(a.bitmap.encoding, b.bitmap.encoding);
+        EXPECT_EQ(a.bitmap.keys, b.bitmap.keys);
+    }
+
+} // namespace
+
+TEST_F(ColumnAnalyzerTest, MergeIsAssociativeAndMatchesWholeColumn) {
+    std::vector<std::string> column;
+    for (int i = 0; i < 9000; ++i) {
+        column.push_back(i % 11 == 0 ? "" : std::to_string((i * 7919) % 2500) + (i % 3 == 0 ? ".5" : ""));
+    }
+    const size_t a = 2000;
+    const size_t b = 5000;
+
+    // (x + y) + z
+    ColumnResult left = analyzeChunk(column, 0, a);
+    left.merge(analyzeChunk(column, a, b));
+    left.merge(analyzeChunk(column, b, column.size()));
+
+    // x + (y + z)
+    ColumnResult tail = analyzeChunk(column, a, b);
+    tail.merge(analyzeChunk(column, b, column.size()));
+    ColumnResult right = analyzeChunk(column, 0, a);
+    right.merge(std::move(tail));
+
+    // z + x + y: commutative up to rounding
+    ColumnResult shuffled = analyzeChunk(column, b, column.size());
+    shuffled.merge(analyzeChunk(column, 0, a));
+    shuffled.merge(analyzeChunk(column, a, b));
+
+    ColumnResult whole = analyzeChunk(column, 0, column.size());
+    expectSameResult(left, right);
+    expectSameResult(left, shuffled);
+    expectSameResult(left, whole);
+    EXPECT_NEAR(left.statistics.sum, whole.statistics.sum, 1e-6);
+}
+
+TEST_F(ColumnAnalyzerTest, MergeKeepsBitmapsAndEmptyIsIdentity) {
+    std::vector<std::string> column;
+    for (int i = 0; i < 6000; ++i) {
+        column.push_back(std::to_string(i % 300));
+    }
+    auto first = ColumnAnalyzer::analyzeBitmap(3, {column.begin(), column.begin() + 3000});
+    auto second = ColumnAnalyzer::analyzeBitmap(3, {column.begin() + 3000, column.end()});
+    auto whole = ColumnAnalyzer::analyzeBitmap(3, column);
+
+    ColumnResult total(3);
+    total.merge(std::move(first));
+    total.merge(ColumnResult(3));
+    total.merge(std::move(second));
+
+    EXPECT_EQ(total.columnIndex, 3);
+    EXPECT_EQ(total.uniqueCount, 300);
+    EXPECT_EQ(total.bitmap.encoding, BitmapEncoding::INTEGER);
+    EXPECT_EQ(total.bitmap.keys, whole.bitmap.keys);
+    EXPECT_TRUE(total.complete);
+
+    // A part with values that do not fit the encoding drops the bitmap
+    total.merge(ColumnAnalyzer::analyze(3, {"x"}));
+    EXPECT_FALSE(total.bitmap.valid());
+    EXPECT_EQ(total.uniqueCount, 301);
+
+    ColumnResult unfinished(3);
+    unfinished.complete = false;
+    total.merge(std::move(unfinished));
+    EXPECT_FALSE(total.complete);
+}
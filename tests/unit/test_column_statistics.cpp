@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include "ColumnStatistics.h"
+#include "ParallelProcessor.h"
+#include <cmath>
+
+TEST(StatisticsFromStringTest, ParsesNames) {
+    EXPECT_EQ(statisticsFromString("all"), STAT_ALL);
+    EXPECT_EQ(statisticsFromString("nulls,numeric"), STAT_NULLS | STAT_NUMERIC);
+    EXPECT_EQ(statisticsFromString(""), STAT_NONE);
+    EXPECT_THROW(statisticsFromString("median"), std::invalid_argument);
+}
+
+TEST(StatisticsAccumulatorTest, AllAggregations) {
+    StatisticsAccumulator acc(STAT_ALL);
+    for (const std::string v : {"1", "2", "", "3", "NULL", "4", "abc"}) {
+        acc.update(v);
+    }
+
+    auto stats = acc.finish();
+
+    EXPECT_EQ(stats.rowCount, 7);
+    EXPECT_EQ(stats.nullCount, 2);
+    EXPECT_EQ(stats.minValue, "");
+    EXPECT_EQ(stats.maxValue, "abc");
+    EXPECT_EQ(stats.numericCount, 4);
+    EXPECT_DOUBLE_EQ(stats.sum, 10.0);
+    EXPECT_DOUBLE_EQ(stats.mean, 2.5);
+    EXPECT_NEAR(stats.stddev, std::sqrt(5.0 / 3.0), 1e-12);
+
+    ASSERT_EQ(stats.lengthHistogram.size(), ColumnStatistics::kLengthBuckets);
+    EXPECT_EQ(stats.lengthHistogram[0], 1);  // ""
+    EXPECT_EQ(stats.lengthHistogram[1], 4);  // "1" .. "4"
+    EXPECT_EQ(stats.lengthHistogram[2], 1);  // "abc"
+    EXPECT_EQ(stats.lengthHistogram[3], 1);  // "NULL"
+}
+
+TEST(StatisticsAccumulatorTest, StaticStatisticsMatchRuntime) {
+    StatisticsAccumulator runtime(STAT_ALL);
+    StaticStatistics<STAT_ALL> fixed;
+    for (const std::string& v : std::vector<std::string>{"10", "-2.5", "", "x", "NULL", "1e3", std::string(200, 'a')}) {
+        runtime.update(v);
+        fixed.update(v);
+    }
+
+    auto a = runtime.finish();
+    auto b = fixed.finish();
+
+    EXPECT_EQ(a.computed, b.computed);
+    EXPECT_EQ(a.rowCount, b.rowCount);
+    EXPECT_EQ(a.nullCount, b.nullCount);
+    EXPECT_EQ(a.minValue, b.minValue);
+    EXPECT_EQ(a.maxValue, b.maxValue);
+    EXPECT_EQ(a.lengthHistogram, b.lengthHistogram);
+    EXPECT_EQ(a.numericCount, b.numericCount);
+    EXPECT_DOUBLE_EQ(a.mean, b.mean);
+    EXPECT_DOUBLE_EQ(a.stddev, b.stddev);
+}
+
+TEST(StatisticsAccumulatorTest, LengthBucketLabels) {
+    EXPECT_EQ(ColumnStatistics::lengthBucketLabel(0), "0");
+    EXPECT_EQ(ColumnStatistics::lengthBucketLabel(3), "4-7");
+    EXPECT_EQ(ColumnStatistics::lengthBucketLabel(8), "128+");
+}
+
+TEST(StatisticsAccumulatorTest, FusedWithEveryStrategy) {
+    std::vector<std::vector<std::string>> columns = {
+            {"10", "20", "10", "", "30"},
+            {"b", "a", "c", "a", "b"}
+    };
+
+    AnalyzerOptions options;
+    options.statistics = STAT_ALL;
+    ParallelProcessor processor(2, options);
+
+    for (auto strategy : {ParallelStrategy::THREADS, ParallelStrategy::ASYNC,
+                          ParallelStrategy::EXECUTION_POLICY}) {
+        auto results = processor.process(columns, strategy);
+
+        ASSERT_EQ(results.size(), 2);
+        EXPECT_EQ(results[0].uniqueCount, 4);
+        EXPECT_EQ(results[0].statistics.nullCount, 1);
+        EXPECT_EQ(results[0].statistics.numericCount, 4);
+        EXPECT_DOUBLE_EQ(results[0].statistics.mean, 17.5);
+        EXPECT_EQ(results[1].statistics.minValue, "a");
+        EXPECT_EQ(results[1].statistics.maxValue, "c");
+    }
+}
+
+TEST(StatisticsAccumulatorTest, MergeMatchesSinglePass) {
+    std::vector<std::string> left = {"1", "5", "", "abc"};
+    std::vector<std::string> right = {"2", "9", "7", "NULL", "zz"};
+
+    StatisticsAccumulator whole(STAT_ALL), a(STAT_ALL), b(STAT_ALL);
+    for (const auto& v : left) { whole.update(v); a.update(v); }
+    for (const auto& v : right) { whole.update(v); b.update(v); }
+
+    auto expected = whole.finish();
+    auto merged = a.finish();
+    merged.merge(b.finish());
+
+    EXPECT_EQ(merged.rowCount, expected.rowCount);
+    EXPECT_EQ(merged.nullCount, expected.nullCount);
+    EXPECT_EQ(merged.minValue, expected.minValue);
+    EXPECT_EQ(merged.maxValue, expected.maxValue);
+    EXPECT_EQ(merged.lengthHistogram, expected.lengthHistogram);
+    EXPECT_EQ(merged.numericCount, expected.numericCount);
+    EXPECT_DOUBLE_EQ(merged.sum, expected.sum);
+    EXPECT_NEAR(merged.mean, expected.mean, 1e-12);
+    EXPECT_NEAR(merged.stddev, expected.stddev, 1e-12);
+}
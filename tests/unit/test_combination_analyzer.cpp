@@ -0,0 +1,181 @@
+#include <gtest/gtest.h>
+#include "CombinationAnalyzer.h"
+#include "ParallelProcessor.h"
+#include "CellHash.h"
+#include <random>
+#include <set>
+#include <thread>
+
+namespace {
+
+    // 3 columns: a (20 values), b (50 values), id (unique per row)
+    std::vector<std::vector<std::string>> makeTable(size_t rows) {
+        std::vector<std::vector<std::string>> columns(3);
+        std::mt19937 rng(5);
+        for (size_t i = 0; i < rows; ++i) {
+            columns[0].push_back("a" + std::to_string(rng() % 20));
+            columns[1].push_back(std::to_string(rng() % 50));
+            columns[2].push_back("id" + std::to_string(i));
+        }
+        return columns;
+    }
+
+    size_t referenceCount(const std::vector<std::vector<std::string>>& columns,
+                          const ColumnGroup& group) {
+        std::set<std::vector<std::string>> tuples;
+        for (size_t row = 0; row < columns[0].size(); ++row) {
+            std::vector<std::string> tuple;
+            for (size_t column : group) {
+                tuple.push_back(columns[column][row]);
+            }
+            tuples.insert(std::move(tuple));
+        }
+        return tuples.size();
+    }
+
+    std::vector<std::vector<uint64_t>> hashesOf(const std::vector<std::vector<std::string>>& columns) {
+        std::vector<std::vector<uint64_t>> hashes(columns.size());
+        for (size_t c = 0; c < columns.size(); ++c) {
+            for (const auto& cell : columns[c]) {
+                hashes[c].push_back(CellHash::hash(cell));
+            }
+        }
+        return hashes;
+    }
+
+} // namespace
+
+TEST(CombinationAnalyzerTest, ParseGroupsByIndexAndName) {
+    std::vector<std::string> headers = {"city", "zip", "7"};
+
+    auto groups = parseColumnGroups("0+1,city+zip+2,zip", headers);
+    ASSERT_EQ(groups.size(), 3);
+    EXPECT_EQ(groups[0], (ColumnGroup{0, 1}));
+    EXPECT_EQ(groups[1], (ColumnGroup{0, 1, 2}));
+    EXPECT_EQ(groups[2], (ColumnGroup{1}));
+
+    // A header name wins over an index
+    EXPECT_EQ(parseColumnGroups("7", headers)[0], (ColumnGroup{2}));
+
+    EXPECT_THROW(parseColumnGroups("0+3", headers), std::invalid_argument);
+    EXPECT_THROW(parseColumnGroups("0++1", headers), std::invalid_argument);
+    EXPECT_THROW(parseColumnGroups("0,", headers), std::invalid_argument);
+    EXPECT_THROW(combinationModeFromString("approx"), std::invalid_argument);
+}
+
+TEST(CombinationAnalyzerTest, TupleBoundariesAndOrderMatter) {
+    // ("ab", "c") and ("a", "bc") are different tuples; so are (x, y) and (y, x)
+    std::vector<std::vector<std::string>> columns = {
+        {"ab", "a", "x", "y", "ab"},
+        {"c", "bc", "y", "x", "c"},
+    };
+    auto result = CombinationAnalyzer::analyze(columns, nullptr, {0, 1}, CombinationMode::EXACT);
+    EXPECT_EQ(result.distinctCount, 4);
+    EXPECT_EQ(result.rowCount, 5);
+    EXPECT_FALSE(result.isUnique());
+}
+
+TEST(CombinationAnalyzerTest, ParallelExactMatchesReference) {
+    auto columns = makeTable(30000);
+    auto hashes = hashesOf(columns);
+    std::vector<ColumnGroup> groups = {{0}, {0, 1}, {1, 0}, {0, 2}, {0, 1, 2}};
+
+    ParallelProcessor processor(4);
+    for (auto strategy : {ParallelStrategy::EXECUTION_POLICY,
+                          ParallelStrategy::THREADS,
+                          ParallelStrategy::ASYNC}) {
+        for (const auto* cellHashes : {&hashes, static_cast<decltype(&hashes)>(nullptr)}) {
+            auto results = processor.processCombinations(
+                    columns, cellHashes ? *cellHashes : std::vector<std::vector<uint64_t>>{},
+                    groups, CombinationMode::EXACT, strategy);
+
+            ASSERT_EQ(results.size(), groups.size());
+            for (size_t g = 0; g < groups.size(); ++g) {
+                EXPECT_TRUE(results[g].complete);
+                EXPECT_EQ(results[g].columns, groups[g]);
+                EXPECT_EQ(results[g].distinctCount, referenceCount(columns, groups[g])) << "group " << g;
+            }
+        }
+    }
+
+    auto results = processor.processCombinations(columns, hashes, groups,
+                                                 CombinationMode::EXACT, ParallelStrategy::THREADS);
+    EXPECT_EQ(results[1].distinctCount, 1000);
+    EXPECT_FALSE(results[1].isUnique());
+    EXPECT_TRUE(results[3].isUnique());
+}
+
+TEST(CombinationAnalyzerTest, ScatteredPartitionsMatchReference) {
+    // Few groups, many workers: every group is split over several key
+    // partitions, each fed by every stripe of rows
+    auto columns = makeTable(30000);
+    std::vector<ColumnGroup> groups = {{0, 1}, {0, 2}};
+
+    ParallelProcessor processor(7);
+    auto results = processor.processCombinations(columns, {}, groups,
+                                                 CombinationMode::EXACT, ParallelStrategy::THREADS);
+    ASSERT_EQ(results.size(), groups.size());
+    for (size_t g = 0; g < groups.size(); ++g) {
+        EXPECT_TRUE(results[g].complete);
+        EXPECT_EQ(results[g].distinctCount, referenceCount(columns, groups[g])) << "group " << g;
+    }
+}
+
+TEST(CombinationAnalyzerTest, HllEstimateWithinError) {
+    auto columns = makeTable(200000);
+    std::vector<ColumnGroup> groups = {{0, 1}, {0, 2}};
+
+    ParallelProcessor processor(3);
+    auto results = processor.processCombinations(columns, {}, groups,
+                                                  CombinationMode::HLL, ParallelStrategy::THREADS);
+
+    for (size_t g = 0; g < groups.size(); ++g) {
+        const double exact = static_cast<double>(referenceCount(columns, groups[g]));
+        EXPECT_EQ(results[g].mode, CombinationMode::HLL);
+        EXPECT_GT(results[g].relativeError, 0.0);
+        EXPECT_NEAR(static_cast<double>(results[g].distinctCount), exact,
+                    exact * 4 * results[g].relativeError);
+        EXPECT_FALSE(results[g].isUnique());
+    }
+
+    // Single-threaded sketch agrees with the merged stripes exactly
+    auto single = CombinationAnalyzer::analyze(columns, nullptr, groups[1], CombinationMode::HLL);
+    EXPECT_EQ(single.distinctCount, results[1].distinctCount);
+}
+
+TEST(CombinationAnalyzerTest, HyperLogLogMergeAndPrecision) {
+    HyperLogLog a;
+    HyperLogLog b;
+    HyperLogLog both;
+    for (uint64_t i = 0; i < 50000; ++i) {
+        uint64_t hash = CellHash::hashBytes(reinterpret_cast<const char*>(&i), sizeof(i));
+        (i % 2 == 0 ? a : b).add(hash);
+        both.add(hash);
+    }
+    a.merge(b);
+    EXPECT_DOUBLE_EQ(a.estimate(), both.estimate());
+    EXPECT_NEAR(a.estimate(), 50000.0, 50000.0 * 4 * a.relativeError());
+
+    HyperLogLog small(10);
+    EXPECT_THROW(a.merge(small), std::invalid_argument);
+    EXPECT_THROW(HyperLogLog(3), std::invalid_argument);
+    EXPECT_EQ(HyperLogLog().estimate(), 0.0);
+}
+
+TEST(CombinationAnalyzerTest, CancelledRunIsIncomplete) {
+    auto columns = makeTable(50000);
+    CancellationToken token;
+    token.cancel();
+
+    ParallelProcessor processor(2);
+    processor.setCancellation(&token);
+    auto results = processor.processCombinations(columns, {}, {{0, 1}},
+                                                 CombinationMode::EXACT, ParallelStrategy::THREADS);
+    ASSERT_EQ(results.size(), 1);
+    EXPECT_FALSE(results[0].complete);
+    EXPECT_FALSE(results[0].isUnique());
+
+    EXPECT_THROW(processor.processCombinations(columns, {}, {{0, 5}},
+                                               CombinationMode::EXACT, ParallelStrategy::THREADS),
+                 std::invalid_argument);
+}
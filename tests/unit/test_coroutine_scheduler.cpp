@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include "CoroutineScheduler.h"
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+    Task addOne(std::atomic<int>& counter, std::atomic<bool>& onWorker) {
+        if (CoroutineScheduler::currentWorker() == CoroutineScheduler::kNotWorker) {
+            onWorker = false;
+        }
+        counter.fetch_add(1);
+        co_return;
+    }
+
+    Task hop(CoroutineScheduler& scheduler, std::atomic<int>& counter) {
+        counter.fetch_add(1);
+        co_await scheduler.schedule();
+        counter.fetch_add(1);
+    }
+
+    Task inTurn(Sequencer& sequencer, size_t ticket, std::mutex& mutex, std::vector<size_t>& order) {
+        co_await sequencer.turn(ticket);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(ticket);
+        }
+        sequencer.advance();
+    }
+
+    Task throwing() {
+        throw std::runtime_error("task failed");
+        co_return;
+    }
+
+} // namespace
+
+TEST(CoroutineSchedulerTest, RunsEverySpawnedTaskOnWorkers) {
+    CoroutineScheduler scheduler(3);
+    EXPECT_EQ(scheduler.size(), 3);
+    EXPECT_EQ(CoroutineScheduler::currentWorker(), CoroutineScheduler::kNotWorker);
+
+    std::atomic<int> counter{0};
+    std::atomic<bool> onWorker{true};
+    for (int i = 0; i < 1000; ++i) {
+        scheduler.spawn(addOne(counter, onWorker));
+    }
+    for (int i = 0; i < 100; ++i) {
+        scheduler.spawn(hop(scheduler, counter));
+    }
+    scheduler.wait();
+
+    EXPECT_EQ(counter.load(), 1200);
+    EXPECT_TRUE(onWorker.load());
+}
+
+TEST(CoroutineSchedulerTest, SequencerResumesInTicketOrder) {
+    // Fewer workers than waiting coroutines: waiting must not hold a thread
+    CoroutineScheduler scheduler(2);
+    Sequencer sequencer(scheduler);
+    std::mutex mutex;
+    std::vector<size_t> order;
+
+    for (size_t ticket = 50; ticket-- > 0;) {
+        scheduler.spawn(inTurn(sequencer, ticket, mutex, order));
+    }
+    scheduler.wait();
+
+    ASSERT_EQ(order.size(), 50);
+    for (size_t i = 0; i < order.size(); ++i) {
+        EXPECT_EQ(order[i], i);
+    }
+}
+
+TEST(CoroutineSchedulerTest, WaitRethrowsTaskException) {
+    CoroutineScheduler scheduler(2);
+    std::atomic<int> counter{0};
+    std::atomic<bool> onWorker{true};
+    scheduler.spawn(throwing());
+    scheduler.spawn(addOne(counter, onWorker));
+
+    EXPECT_THROW(scheduler.wait(), std::runtime_error);
+    EXPECT_EQ(counter.load(), 1);
+    EXPECT_NO_THROW(scheduler.wait());  // Reported once
+}
+
+TEST(CoroutineSchedulerTest, UnspawnedTaskIsFreed) {
+    std::atomic<int> counter{0};
+    std::atomic<bool> onWorker{true};
+    {
+        Task task = addOne(counter, onWorker);
+    }
+    EXPECT_EQ(counter.load(), 0);
+}
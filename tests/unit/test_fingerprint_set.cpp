@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+#include "FingerprintSet.h"
+#include "ColumnAnalyzer.h"
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+TEST(FingerprintSetTest, RejectsUnsupportedWidths) {
+    EXPECT_NO_THROW(FingerprintSet(0));
+    EXPECT_NO_THROW(FingerprintSet(64));
+    EXPECT_NO_THROW(FingerprintSet(128));
+    EXPECT_THROW(FingerprintSet(32), std::invalid_argument);
+    EXPECT_THROW(FingerprintSet(96), std::invalid_argument);
+}
+
+TEST(FingerprintSetTest, DeduplicatesAndGrows) {
+    for (unsigned bits : {64u, 128u}) {
+        FingerprintSet set(bits);
+        for (int round = 0; round < 2; ++round) {
+            for (uint64_t i = 0; i < 10000; ++i) {
+                EXPECT_EQ(set.insert((i + 1) * 0xC2B2AE3D27D4EB4Full, i), round == 0);
+            }
+        }
+        EXPECT_EQ(set.size(), 10000u);
+        EXPECT_GE(set.memoryBytes(), 10000u * bits / 8);
+    }
+}
+
+TEST(FingerprintSetTest, ZeroLowWordIsAValue) {
+    FingerprintSet set(64);
+    EXPECT_TRUE(set.insert(0));
+    EXPECT_FALSE(set.insert(0));
+    EXPECT_EQ(set.size(), 1u);
+}
+
+TEST(FingerprintSetTest, HighWordSeparates128BitFingerprints) {
+    FingerprintSet narrow(64);
+    FingerprintSet wide(128);
+    for (uint64_t high : {1ull, 2ull}) {
+        narrow.insert(42, high);
+        wide.insert(42, high);
+    }
+    EXPECT_EQ(narrow.size(), 1u);
+    EXPECT_EQ(wide.size(), 2u);
+}
+
+TEST(FingerprintSetTest, MergeIsUnion) {
+    FingerprintSet a(128);
+    FingerprintSet b(128);
+    for (uint64_t i = 0; i < 1000; ++i) a.insert(i + 1, i);
+    for (uint64_t i = 500; i < 1500; ++i) b.insert(i + 1, i);
+
+    a.merge(b);
+    EXPECT_EQ(a.size(), 1500u);
+
+    FingerprintSet narrow(64);
+    narrow.insert(7);
+    EXPECT_THROW(a.merge(narrow), std::invalid_argument);
+    EXPECT_NO_THROW(a.merge(FingerprintSet(64)));  // Empty: nothing to merge
+}
+
+TEST(FingerprintSetTest, CollisionProbability) {
+    EXPECT_EQ(FingerprintSet::collisionProbability(1, 64), 0.0);
+    EXPECT_EQ(FingerprintSet::collisionProbability(1000, 0), 0.0);
+
+    // n(n-1)/2 / 2^bits for small values
+    EXPECT_NEAR(FingerprintSet::collisionProbability(1000000, 64), 2.71e-8, 0.01e-8);
+    EXPECT_NEAR(FingerprintSet::collisionProbability(1ull << 32, 64), 0.393, 0.001);
+    EXPECT_GT(FingerprintSet::collisionProbability(1000000, 128), 0.0);
+    EXPECT_LT(FingerprintSet::collisionProbability(1000000, 128), 1e-20);
+}
+
+namespace {
+
+    std::vector<std::string> sampleColumn() {
+        std::vector<std::string> data;
+        for (int i = 0; i < 20000; ++i) {
+            data.push_back("value_" + std::to_string(i % 3217));
+        }
+        return data;
+    }
+
+    AnalyzerOptions fingerprintOptions(unsigned bits, bool verify) {
+        AnalyzerOptions options;
+        options.backend = DistinctBackend::FINGERPRINT;
+        options.fingerprintBits = bits;
+        options.verifyFingerprints = verify;
+        return options;
+    }
+
+} // namespace
+
+TEST(FingerprintBackendTest, CountsMatchHashBackend) {
+    auto data = sampleColumn();
+    auto expected = ColumnAnalyzer::analyze(0, data);
+
+    EXPECT_EQ(backendFromString("fingerprint"), DistinctBackend::FINGERPRINT);
+    for (unsigned bits : {64u, 128u}) {
+        auto result = ColumnAnalyzer::analyze(0, data, fingerprintOptions(bits, false));
+        EXPECT_EQ(result.uniqueCount, expected.uniqueCount);
+        EXPECT_EQ(result.fingerprints.bits(), bits);
+        EXPECT_EQ(result.fingerprints.size(), expected.uniqueCount);
+        EXPECT_TRUE(result.uniqueValues.empty());
+        EXPECT_FALSE(result.fingerprintsVerified);
+    }
+}
+
+TEST(FingerprintBackendTest, VerificationFindsCollisions) {
+    // Reader hashes where two different values share the low word
+    std::vector<std::string> data = {"apple", "banana", "cherry", "apple", "banana"};
+    std::vector<uint64_t> hashes = {7, 7, 9, 7, 7};
+
+    auto unverified = ColumnAnalyzer::analyze(0, data, fingerprintOptions(64, false), &hashes);
+    EXPECT_EQ(unverified.uniqueCount, 2u);  // apple and banana collide
+
+    auto verified = ColumnAnalyzer::analyze(0, data, fingerprintOptions(64, true), &hashes);
+    EXPECT_TRUE(verified.fingerprintsVerified);
+    EXPECT_EQ(verified.uniqueCount, 3u);
+    EXPECT_EQ(verified.fingerprintCollisions, 1u);
+
+    // The independent high word separates them
+    auto wide = ColumnAnalyzer::analyze(0, data, fingerprintOptions(128, true), &hashes);
+    EXPECT_EQ(wide.uniqueCount, 3u);
+    EXPECT_EQ(wide.fingerprintCollisions, 0u);
+}
+
+TEST(FingerprintBackendTest, MergeUnionsFingerprints) {
+    std::vector<std::string> first = {"a", "b", "c"};
+    std::vector<std::string> second = {"c", "d"};
+    auto options = fingerprintOptions(128, true);
+
+    ColumnResult total(0);
+    total.merge(ColumnAnalyzer::analyze(0, first, options));
+    EXPECT_EQ(total.uniqueCount, 3u);
+    EXPECT_TRUE(total.fingerprintsVerified);
+
+    total.merge(ColumnAnalyzer::analyze(0, second, options));
+    EXPECT_EQ(total.uniqueCount, 4u);
+    EXPECT_EQ(total.fingerprints.size(), 4u);
+    EXPECT_FALSE(total.fingerprintsVerified);  // Per-part checks do not cover the union
+}
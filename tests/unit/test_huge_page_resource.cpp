@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+#include "HugePageResource.h"
+#include "DistinctIndex.h"
+#include "CellHash.h"
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+TEST(HugePageResourceTest, ModeNames) {
+    EXPECT_EQ(hugePageModeFromString("off"), HugePageMode::OFF);
+    EXPECT_EQ(hugePageModeFromString("thp"), HugePageMode::TRANSPARENT);
+    EXPECT_EQ(hugePageModeFromString("explicit"), HugePageMode::EXPLICIT);
+    EXPECT_THROW(hugePageModeFromString("2mb"), std::invalid_argument);
+}
+
+TEST(HugePageResourceTest, SmallBlocksComeFromUpstream) {
+    HugePageResource resource(HugePageMode::TRANSPARENT);
+    void* p = resource.allocate(4096);
+    auto stats = resource.stats();
+    EXPECT_EQ(stats.transparentBytes + stats.explicitBytes, 0u);
+    resource.deallocate(p, 4096);
+}
+
+TEST(HugePageResourceTest, LargeBlocksAreHugePageAligned) {
+    for (auto mode : {HugePageMode::TRANSPARENT, HugePageMode::EXPLICIT}) {
+        HugePageResource resource(mode);
+        const size_t bytes = 3 * HugePageResource::kHugePageSize + 123;
+        auto* p = static_cast<unsigned char*>(resource.allocate(bytes));
+
+        auto stats = resource.stats();
+        if (stats.fallbacks == 0) {
+            EXPECT_EQ(reinterpret_cast<uintptr_t>(p) % HugePageResource::kHugePageSize, 0u);
+            EXPECT_EQ(stats.transparentBytes + stats.explicitBytes, 4 * HugePageResource::kHugePageSize);
+        }
+        std::memset(p, 0xAB, bytes);
+        EXPECT_EQ(p[bytes - 1], 0xAB);
+
+        resource.deallocate(p, bytes);
+        stats = resource.stats();
+        EXPECT_EQ(stats.transparentBytes + stats.explicitBytes, 0u);
+    }
+}
+
+TEST(HugePageResourceTest, OffUsesUpstreamForLargeBlocks) {
+    HugePageResource resource(HugePageMode::OFF);
+    void* p = resource.allocate(HugePageResource::kMinBytes * 2);
+    EXPECT_EQ(resource.stats().transparentBytes, 0u);
+    resource.deallocate(p, HugePageResource::kMinBytes * 2);
+}
+
+TEST(HugePageResourceTest, BlocksOutliveModeChanges) {
+    HugePageResource resource(HugePageMode::TRANSPARENT);
+    void* mapped = resource.allocate(HugePageResource::kMinBytes);
+    resource.setMode(HugePageMode::OFF);
+    void* heap = resource.allocate(HugePageResource::kMinBytes);
+
+    // Each block goes back to where it came from
+    resource.deallocate(mapped, HugePageResource::kMinBytes);
+    resource.deallocate(heap, HugePageResource::kMinBytes);
+    EXPECT_EQ(resource.stats().transparentBytes, 0u);
+}
+
+TEST(HugePageResourceTest, DistinctIndexOnHugePages) {
+    HugePageResource resource(HugePageMode::TRANSPARENT);
+    std::vector<std::string> column;
+    std::vector<uint64_t> hashes;
+    for (size_t i = 0; i < 200000; ++i) {
+        column.push_back("v" + std::to_string(i % 150000));
+        hashes.push_back(CellHash::hash(column.back()));
+    }
+
+    DistinctIndex index(0, &resource);
+    for (size_t row = 0; row < column.size(); ++row) {
+        index.insert(hashes[row], row, [&](size_t other) { return column[other] == column[row]; });
+    }
+    EXPECT_EQ(index.size(), 150000u);
+}
@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+#include "NumericParser.h"
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <random>
+#include <sstream>
+
+namespace {
+    template <typename T>
+    bool reference(const std::string& text, T& value) {
+        const char* end = text.data() + text.size();
+        auto [ptr, ec] = std::from_chars(text.data(), end, value);
+        return ec == std::errc() && ptr == end;
+    }
+
+    bool sameBits(double a, double b) {
+        if (std::isnan(a) && std::isnan(b)) return true;
+        return std::memcmp(&a, &b, sizeof(a)) == 0;
+    }
+
+    void expectMatchesReference(const std::string& text) {
+        int64_t expectedInt = 0;
+        int64_t actualInt = 0;
+        const bool expectedIntOk = reference(text, expectedInt);
+        ASSERT_EQ(NumericParser::parseInt64(text, actualInt), expectedIntOk) << "'" << text << "'";
+        if (expectedIntOk) {
+            ASSERT_EQ(actualInt, expectedInt) << "'" << text << "'";
+        }
+
+        double expectedDouble = 0.0;
+        double actualDouble = 0.0;
+        const bool expectedDoubleOk = reference(text, expectedDouble);
+        ASSERT_EQ(NumericParser::parseDouble(text, actualDouble), expectedDoubleOk) << "'" << text << "'";
+        if (expectedDoubleOk) {
+            ASSERT_TRUE(sameBits(actualDouble, expectedDouble))
+                << "'" << text << "': " << actualDouble << " vs " << expectedDouble;
+        }
+    }
+} // namespace
+
+TEST(NumericParserTest, Integers) {
+    int64_t value = 0;
+    EXPECT_TRUE(NumericParser::parseInt64("0", value));
+    EXPECT_EQ(value, 0);
+    EXPECT_TRUE(NumericParser::parseInt64("-12345678901", value));
+    EXPECT_EQ(value, -12345678901);
+    EXPECT_TRUE(NumericParser::parseInt64("9223372036854775807", value));
+    EXPECT_EQ(value, INT64_MAX);
+    EXPECT_TRUE(NumericParser::parseInt64("-9223372036854775808", value));
+    EXPECT_EQ(value, INT64_MIN);
+
+    EXPECT_FALSE(NumericParser::parseInt64("9223372036854775808", value));
+    EXPECT_FALSE(NumericParser::parseInt64("", value));
+    EXPECT_FALSE(NumericParser::parseInt64("-", value));
+    EXPECT_FALSE(NumericParser::parseInt64("+1", value));
+    EXPECT_FALSE(NumericParser::parseInt64("12a", value));
+    EXPECT_FALSE(NumericParser::parseInt64("1.5", value));
+}
+
+TEST(NumericParserTest, Decimals) {
+    double value = 0.0;
+    EXPECT_TRUE(NumericParser::parseDouble("4417.50", value));
+    EXPECT_DOUBLE_EQ(value, 4417.5);
+    EXPECT_TRUE(NumericParser::parseDouble("-0.01", value));
+    EXPECT_DOUBLE_EQ(value, -0.01);
+    EXPECT_TRUE(NumericParser::parseDouble(".5", value));
+    EXPECT_DOUBLE_EQ(value, 0.5);
+    EXPECT_TRUE(NumericParser::parseDouble("1e3", value));  // Fallback
+    EXPECT_DOUBLE_EQ(value, 1000.0);
+
+    EXPECT_FALSE(NumericParser::parseDouble("", value));
+    EXPECT_FALSE(NumericParser::parseDouble(".", value));
+    EXPECT_FALSE(NumericParser::parseDouble("1.2.3", value));
+    EXPECT_FALSE(NumericParser::parseDouble("str_12", value));
+}
+
+TEST(NumericParserTest, FuzzRandomCharacters) {
+    const std::string alphabet = "0123456789999.-+eE xn";
+    std::mt19937_64 rng(2024);
+    std::uniform_int_distribution<size_t> length(0, 26);
+    std::uniform_int_distribution<size_t> pick(0, alphabet.size() - 1);
+
+    for (size_t i = 0; i < 200000; ++i) {
+        std::string text;
+        for (size_t n = length(rng); n > 0; --n) {
+            text += alphabet[pick(rng)];
+        }
+        expectMatchesReference(text);
+    }
+}
+
+TEST(NumericParserTest, FuzzWellFormedNumbers) {
+    std::mt19937_64 rng(7);
+    std::uniform_int_distribution<int> digits(1, 24);
+    std::uniform_int_distribution<int> precision(0, 8);
+
+    for (size_t i = 0; i < 100000; ++i) {
+        // Random digit strings of every length around the fast-path limits
+        std::string text = (rng() & 1) ? "-" : "";
+        for (int n = digits(rng); n > 0; --n) {
+            text += static_cast<char>('0' + rng() % 10);
+        }
+        expectMatchesReference(text);
+
+        text.insert(text.size() - rng() % (text.size() - (text[0] == '-')), ".");
+        expectMatchesReference(text);
+
+        // Fixed-point formatting, as DataGenerator writes floats
+        std::ostringstream oss;
+        oss << std::fixed << std::setprecision(precision(rng))
+            << static_cast<double>(static_cast<int64_t>(rng() % 20000001) - 10000000) * 0.5;
+        expectMatchesReference(oss.str());
+
+        expectMatchesReference(std::to_string(static_cast<int64_t>(rng())));
+    }
+}
+
+TEST(NumericParserTest, ColumnConversion) {
+    std::vector<std::string> column = {"1.50", "x", "-3", "", "2e2"};
+
+    std::vector<double> doubles;
+    std::vector<uint8_t> parsed;
+    EXPECT_EQ(NumericParser::parseColumn(column, doubles, parsed), 3);
+    EXPECT_EQ(parsed, (std::vector<uint8_t>{1, 0, 1, 0, 1}));
+    EXPECT_EQ(doubles, (std::vector<double>{1.5, 0.0, -3.0, 0.0, 200.0}));
+
+    std::vector<int64_t> integers;
+    EXPECT_EQ(NumericParser::parseColumn(column, integers, parsed), 1);
+    EXPECT_EQ(parsed, (std::vector<uint8_t>{0, 0, 1, 0, 0}));
+    EXPECT_EQ(integers[2], -3);
+}
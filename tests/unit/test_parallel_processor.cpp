@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 #include "ParallelProcessor.h"
 #include <algorithm>
+#include <chrono>
+#include <thread>
 
 class ParallelProcessorTest : public ::testing::Test {
 protected:
@@ -89,15 +91,160 @@ TEST_F(ParallelProcessorTest, AllStrategiesProduceSameResults) {
     }
 }
 
+TEST_F(ParallelProcessorTest, CancelledTokenLeavesColumnsIncomplete) {
+    CancellationToken token;
+    token.cancel();
+
+    ParallelProcessor processor(4);
+    processor.setCancellation(&token);
+
+    for (auto strategy : {ParallelStrategy::THREADS, ParallelStrategy::ASYNC,
+                          ParallelStrategy::EXECUTION_POLICY}) {
+        auto results = processor.process(testData, strategy);
+
+        ASSERT_EQ(results.size(), 5);
+        for (size_t i = 0; i < results.size(); ++i) {
+            EXPECT_EQ(results[i].columnIndex, i);
+            EXPECT_FALSE(results[i].complete);
+        }
+        EXPECT_EQ(processor.incompleteColumns(), (std::vector<size_t>{0, 1, 2, 3, 4}));
+    }
+
+    token.reset();
+    auto results = processor.process(testData, ParallelStrategy::THREADS);
+    EXPECT_TRUE(processor.incompleteColumns().empty());
+    EXPECT_TRUE(results[0].complete);
+    EXPECT_EQ(results[0].uniqueCount, 10);
+}
+
+TEST(ParallelProcessorCancellationTest, DeadlineStopsLongColumnsAndKeepsFinishedOnes) {
+    // One short column, then columns far too long for the deadline
+    std::vector<std::vector<std::string>> columns(4);
+    columns[0] = {"a", "b", "a"};
+    for (size_t col = 1; col < columns.size(); ++col) {
+        for (size_t row = 0; row < 3000000; ++row) {
+            columns[col].push_back(std::to_string(row * 7919 % 1000003));
+        }
+    }
+
+    CancellationToken token;
+    ParallelProcessor processor(1);
+    processor.setCancellation(&token);
+
+    auto start = std::chrono::steady_clock::now();
+    token.setTimeout(std::chrono::milliseconds(20));
+    auto results = processor.process(columns, ParallelStrategy::THREADS);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_TRUE(token.deadlineExpired());
+    EXPECT_TRUE(results[0].complete);
+    EXPECT_EQ(results[0].uniqueCount, 2);
+    EXPECT_EQ(processor.incompleteColumns(), (std::vector<size_t>{1, 2, 3}));
+    EXPECT_LT(elapsed, std::chrono::milliseconds(1000));
+}
+
+TEST(ParallelProcessorCancellationTest, CancelFromAnotherThread) {
+    std::vector<std::vector<std::string>> columns(2);
+    for (auto& column : columns) {
+        for (size_t row = 0; row < 4000000; ++row) {
+            column.push_back(std::to_string(row));
+        }
+    }
+
+    CancellationToken token;
+    ParallelProcessor processor(2);
+    processor.setCancellation(&token);
+
+    std::thread canceller([&token]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        token.cancel();
+    });
+    auto results = processor.process(columns, ParallelStrategy::ASYNC);
+    canceller.join();
+
+    EXPECT_FALSE(token.deadlineExpired());
+    EXPECT_EQ(processor.incompleteColumns().size(), 2);
+}
+
+TEST(ParallelProcessorCancellationTest, ScopedTokenCancelsAnalyzer) {
+    std::vector<std::string> column(10, "x");
+    CancellationToken token;
+    token.cancel();
+
+    {
+        CancellationToken::Scope scope(&token);
+        EXPECT_EQ(CancellationToken::current(), &token);
+        EXPECT_THROW(ColumnAnalyzer::analyze(0, column), OperationCancelled);
+    }
+
+    EXPECT_EQ(CancellationToken::current(), nullptr);
+    EXPECT_EQ(ColumnAnalyzer::analyze(0, column).uniqueCount, 1);
+}
+
+TEST(ParallelProcessorMergeTest, TreeMatchesSerialFold) {
+    // Parts overlap so merging both splices and drops duplicates
+    auto part = [](size_t i) {
+        std::vector<std::string> column;
+        for (size_t row = 0; row < 1000; ++row) {
+            column.push_back(std::to_string(i * 500 + row));
+        }
+        AnalyzerOptions options;
+        options.statistics = STAT_ALL;
+        return ColumnAnalyzer::analyze(0, column, options);
+    };
+
+    ParallelProcessor processor(4);
+    for (size_t count : {1, 2, 3, 5, 8, 13}) {
+        ColumnResult serial = part(0);
+        std::vector<ColumnResult> parts;
+        parts.push_back(part(0));
+        for (size_t i = 1; i < count; ++i) {
+            serial.merge(part(i));
+            parts.push_back(part(i));
+        }
+
+        for (auto strategy : {ParallelStrategy::THREADS, ParallelStrategy::ASYNC}) {
+            std::vector<ColumnResult> copy;
+            for (size_t i = 0; i < count; ++i) {
+                copy.push_back(part(i));
+            }
+            ColumnResult tree = processor.mergeTree(std::move(copy), strategy);
+
+            EXPECT_EQ(tree.uniqueValues, serial.uniqueValues) << count << " parts";
+            EXPECT_EQ(tree.uniqueCount, count * 500 + 500);
+            EXPECT_EQ(tree.statistics.rowCount, count * 1000);
+            EXPECT_EQ(tree.statistics.minValue, serial.statistics.minValue);
+            EXPECT_EQ(tree.statistics.maxValue, serial.statistics.maxValue);
+            EXPECT_NEAR(tree.statistics.mean, serial.statistics.mean, 1e-9);
+            EXPECT_NEAR(tree.statistics.stddev, serial.statistics.stddev, 1e-9);
+            EXPECT_TRUE(tree.complete);
+        }
+    }
+
+    EXPECT_EQ(processor.mergeTree({}).uniqueCount, 0);
+}
+
+TEST(ParallelProcessorMergeTest, CancelledTreeIsIncomplete) {
+    CancellationToken token;
+    token.cancel();
+    ParallelProcessor processor(2);
+    processor.setCancellation(&token);
+
+    std::vector<ColumnResult> parts(4);
+    parts[3].uniqueValues = {"a"};
+    EXPECT_FALSE(processor.mergeTree(std::move(parts)).complete);
+}
+
 TEST(StrategyConversionTest, ValidStrategies) {
     EXPECT_EQ(strategyFromInt(1), ParallelStrategy::EXECUTION_POLICY);
     EXPECT_EQ(strategyFromInt(2), ParallelStrategy::THREADS);
     EXPECT_EQ(strategyFromInt(3), ParallelStrategy::ASYNC);
+    EXPECT_EQ(strategyFromInt(4), ParallelStrategy::PIPELINE);
 }
 
 TEST(StrategyConversionTest, InvalidStrategy) {
     EXPECT_THROW(strategyFromInt(0), std::invalid_argument);
-    EXPECT_THROW(strategyFromInt(4), std::invalid_argument);
+    EXPECT_THROW(strategyFromInt(5), std::invalid_argument);
     EXPECT_THROW(strategyFromInt(-1), std::invalid_argument);
 }
 
@@ -105,5 +252,6 @@ TEST(StrategyToStringTest, AllStrategies) {
     EXPECT_EQ(strategyToString(ParallelStrategy::EXECUTION_POLICY), "execution-policy");
     EXPECT_EQ(strategyToString(ParallelStrategy::THREADS), "threads");
     EXPECT_EQ(strategyToString(ParallelStrategy::ASYNC), "async");
+    EXPECT_EQ(strategyToString(ParallelStrategy::PIPELINE), "pipeline");
 }
 
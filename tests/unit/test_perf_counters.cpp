@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+#include "PerfCounters.h"
+#include <cstdint>
+#include <thread>
+
+namespace {
+    // Keeps the loop from being folded away
+    volatile uint64_t sink = 0;
+
+    void busyLoop() {
+        uint64_t x = 1;
+        for (int i = 0; i < 5000000; ++i) {
+            x = x * 6364136223846793005ull + 1442695040888963407ull;
+        }
+        sink = x;
+    }
+} // namespace
+
+TEST(PerfCountersTest, StopReportsWallTimeWithOrWithoutCounters) {
+    PerfCounters counters;
+    counters.start();
+    busyLoop();
+    PerfSample sample = counters.stop();
+
+    EXPECT_GT(sample.seconds, 0.0);
+    if (!counters.available()) {
+        EXPECT_FALSE(counters.error().empty());
+        for (size_t e = 0; e < PERF_EVENT_COUNT; ++e) {
+            EXPECT_FALSE(sample.has(static_cast<PerfEvent>(e)));
+        }
+    }
+}
+
+TEST(PerfCountersTest, TaskClockCountsInheritedThreads) {
+    PerfCounters counters;
+    counters.start();
+    std::thread worker(busyLoop);
+    worker.join();
+    PerfSample sample = counters.stop();
+
+    if (!sample.has(PERF_TASK_CLOCK)) {
+        GTEST_SKIP() << "task-clock unavailable: " << counters.error();
+    }
+    EXPECT_GT(sample[PERF_TASK_CLOCK], 0u);
+}
+
+TEST(PerfCountersTest, DerivedMetricsNeedTheirCounters) {
+    PerfSample sample;
+    EXPECT_EQ(sample.ipc(), 0.0);
+    EXPECT_EQ(sample.perRow(PERF_CACHE_MISSES, 100), 0.0);
+
+    sample.values[PERF_CYCLES] = 200;
+    sample.values[PERF_INSTRUCTIONS] = 300;
+    sample.valid[PERF_CYCLES] = true;
+    EXPECT_EQ(sample.ipc(), 0.0);
+
+    sample.valid[PERF_INSTRUCTIONS] = true;
+    EXPECT_DOUBLE_EQ(sample.ipc(), 1.5);
+    EXPECT_DOUBLE_EQ(sample.perRow(PERF_INSTRUCTIONS, 100), 3.0);
+    EXPECT_EQ(sample.perRow(PERF_INSTRUCTIONS, 0), 0.0);
+}
+
+TEST(PerfCountersTest, EventNames) {
+    EXPECT_STREQ(PerfCounters::eventName(PERF_CYCLES), "cycles");
+    EXPECT_STREQ(PerfCounters::eventName(PERF_INSTRUCTIONS), "instructions");
+}
@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+#include "ProgressReporter.h"
+#include "ParallelProcessor.h"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+namespace {
+    std::string readFile(const std::string& path) {
+        std::ifstream file(path);
+        std::stringstream content;
+        content << file.rdbuf();
+        return content.str();
+    }
+} // namespace
+
+TEST(ProgressReporterTest, AnalysisPublishesRowsAndColumns) {
+    std::vector<std::vector<std::string>> columns(3);
+    for (size_t i = 0; i < 100000; ++i) {
+        for (auto& column : columns) {
+            column.push_back(std::to_string(i % 97));
+        }
+    }
+
+    ProgressReporter::counters().reset();
+    ParallelProcessor processor(2);
+    processor.process(columns, ParallelStrategy::THREADS);
+
+    EXPECT_EQ(ProgressReporter::counters().rows.load(), 300000);
+    EXPECT_EQ(ProgressReporter::counters().columns.load(), 3);
+}
+
+TEST(ProgressReporterTest, WritesStatusFile) {
+    const std::string statusFile = "test_progress_status.json";
+    {
+        ProgressReporter reporter(std::chrono::milliseconds(5), false, statusFile);
+        reporter.beginPhase("analyze", 1000, 0, 2);
+        ProgressReporter::counters().addRows(250);
+        ProgressReporter::counters().addColumns(1);
+
+        // Wait for a periodic sample taken after the updates
+        std::string status;
+        for (int i = 0; i < 200 && status.find("\"rows\":250") == std::string::npos; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            status = readFile(statusFile);
+        }
+        EXPECT_NE(status.find("\"phase\":\"analyze\""), std::string::npos);
+        EXPECT_NE(status.find("\"rows\":250"), std::string::npos);
+        EXPECT_NE(status.find("\"total_rows\":1000"), std::string::npos);
+        EXPECT_NE(status.find("\"done\":false"), std::string::npos);
+
+        ProgressReporter::counters().addRows(750);
+        reporter.endPhase();
+    }
+
+    std::string status = readFile(statusFile);
+    EXPECT_NE(status.find("\"rows\":1000"), std::string::npos);
+    EXPECT_NE(status.find("\"done\":true"), std::string::npos);
+    EXPECT_NE(status.find("\"eta_seconds\":0.000"), std::string::npos);
+    fs::remove(statusFile);
+}
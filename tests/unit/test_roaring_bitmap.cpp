@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+#include "RoaringBitmap.h"
+#include <random>
+#include <set>
+
+TEST(RoaringBitmapTest, AddContainsAcrossContainerKinds) {
+    RoaringBitmap bitmap;
+    std::set<uint32_t> reference;
+    std::mt19937 rng(3);
+
+    // Container 0 becomes a bitmap, container 5 stays an array
+    for (int i = 0; i < 20000; ++i) {
+        uint32_t value = i % 2 == 0 ? rng() % 65536 : (5u << 16) | (rng() % 1000);
+        bitmap.add(value);
+        reference.insert(value);
+    }
+
+    EXPECT_EQ(bitmap.cardinality(), reference.size());
+    for (uint32_t value : reference) {
+        ASSERT_TRUE(bitmap.contains(value));
+    }
+    EXPECT_FALSE(bitmap.contains(4u << 16));
+    EXPECT_FALSE(bitmap.contains(UINT32_MAX));
+
+    std::vector<uint32_t> values;
+    bitmap.forEach([&](uint32_t value) { values.push_back(value); });
+    EXPECT_EQ(values, std::vector<uint32_t>(reference.begin(), reference.end()));
+}
+
+TEST(RoaringBitmapTest, MergeIsUnion) {
+    std::mt19937 rng(11);
+    for (auto [sizeA, sizeB] : {std::pair<int, int>{100, 200}, std::pair<int, int>{3000, 3000},
+                                std::pair<int, int>{10000, 50}, std::pair<int, int>{0, 500}}) {
+        RoaringBitmap a;
+        RoaringBitmap b;
+        RoaringBitmap both;
+        for (int i = 0; i < sizeA; ++i) {
+            uint32_t value = rng() % 200000;
+            a.add(value);
+            both.add(value);
+        }
+        for (int i = 0; i < sizeB; ++i) {
+            uint32_t value = rng() % 200000;
+            b.add(value);
+            both.add(value);
+        }
+
+        a.merge(b);
+        EXPECT_EQ(a, both);
+        EXPECT_EQ(a.cardinality(), both.cardinality());
+    }
+}
+
+TEST(RoaringBitmapTest, FromBitsMatchesAdds) {
+    std::vector<uint64_t> words(2048 + 10, 0);
+    RoaringBitmap expected;
+    for (uint32_t value = 0; value < words.size() * 64; value += 7) {
+        words[value / 64] |= uint64_t{1} << (value % 64);
+        expected.add(value);
+    }
+
+    EXPECT_EQ(RoaringBitmap::fromBits(words.data(), words.size()), expected);
+    EXPECT_TRUE(RoaringBitmap::fromBits(words.data(), 0).empty());
+}
+
+TEST(RoaringBitmapTest, SerializeRoundTrip) {
+    RoaringBitmap bitmap;
+    for (uint32_t value = 0; value < 100000; value += 3) {
+        bitmap.add(value);
+    }
+    bitmap.add(UINT32_MAX);
+
+    std::string bytes = bitmap.serialize();
+    EXPECT_EQ(RoaringBitmap::deserialize(bytes), bitmap);
+
+    EXPECT_THROW(RoaringBitmap::deserialize(bytes.substr(0, bytes.size() - 1)), std::runtime_error);
+    EXPECT_THROW(RoaringBitmap::deserialize(bytes + "x"), std::runtime_error);
+    EXPECT_TRUE(RoaringBitmap::deserialize(RoaringBitmap().serialize()).empty());
+}
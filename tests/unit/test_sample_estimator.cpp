@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include "SampleEstimator.h"
+#include <algorithm>
+#include <random>
+
+namespace {
+    /**
+     * Sample of `blocks` contiguous runs from a shuffled population where
+     * value v occurs `copies` times
+     */
+    std::vector<std::string> samplePopulation(size_t distinct, size_t copies,
+                                              size_t blocks, size_t blockRows,
+                                              SampleInfo& info) {
+        std::vector<size_t> population;
+        for (size_t v = 0; v < distinct; ++v) {
+            population.insert(population.end(), copies, v);
+        }
+        std::mt19937_64 rng(7);
+        std::shuffle(population.begin(), population.end(), rng);
+
+        std::vector<std::string> sample;
+        const size_t stride = population.size() / blocks;
+        for (size_t b = 0; b < blocks; ++b) {
+            for (size_t r = 0; r < blockRows; ++r) {
+                sample.push_back("v" + std::to_string(population[b * stride + r]));
+            }
+            info.blockRows.push_back(blockRows);
+        }
+        info.sampledRows = sample.size();
+        info.estimatedRows = population.size();
+        return sample;
+    }
+} // namespace
+
+TEST(SampleEstimatorTest, HaasStokesLimits) {
+    // Every sampled value unique: looks like a key column
+    EXPECT_NEAR(SampleEstimator::haasStokes(1000, 100000, 1000, 1000), 100000.0, 1e-6);
+    // No singletons: everything has been seen
+    EXPECT_DOUBLE_EQ(SampleEstimator::haasStokes(1000, 100000, 40, 0), 40.0);
+    // Whole population sampled
+    EXPECT_DOUBLE_EQ(SampleEstimator::haasStokes(500, 500, 123, 100), 123.0);
+    EXPECT_DOUBLE_EQ(SampleEstimator::haasStokes(0, 100, 0, 0), 0.0);
+}
+
+TEST(SampleEstimatorTest, EstimatesWithinInterval) {
+    for (auto [distinct, copies] : {std::pair<size_t, size_t>{5000, 200},
+                                    std::pair<size_t, size_t>{200000, 5},
+                                    std::pair<size_t, size_t>{1000000, 1}}) {
+        SampleInfo info;
+        auto sample = samplePopulation(distinct, copies, 64, 500, info);
+
+        auto estimate = SampleEstimator::estimate(sample, info);
+        const auto truth = static_cast<double>(distinct);
+
+        EXPECT_TRUE(estimate.sampled);
+        EXPECT_NEAR(estimate.estimate, truth, 0.1 * truth) << distinct;
+        EXPECT_LE(estimate.lower, estimate.estimate);
+        EXPECT_GE(estimate.upper, estimate.estimate);
+        EXPECT_GE(estimate.lower, static_cast<double>(estimate.sampleDistinct));
+        EXPECT_LE(estimate.upper, static_cast<double>(info.estimatedRows));
+    }
+}
+
+TEST(SampleEstimatorTest, FrequentValueShares) {
+    std::vector<std::string> column;
+    SampleInfo info;
+    for (size_t b = 0; b < 16; ++b) {
+        for (size_t r = 0; r < 100; ++r) {
+            column.push_back(r % 2 == 0 ? "A" : (r % 4 == 1 ? "B" : "x" + std::to_string(b * 100 + r)));
+        }
+        info.blockRows.push_back(100);
+    }
+    info.sampledRows = column.size();
+    info.estimatedRows = 1000000;
+
+    auto estimate = SampleEstimator::estimate(column, info, 2);
+
+    ASSERT_EQ(estimate.topValues.size(), 2);
+    EXPECT_EQ(estimate.topValues[0].value, "A");
+    EXPECT_DOUBLE_EQ(estimate.topValues[0].share, 0.5);
+    EXPECT_LT(estimate.topValues[0].lower, 0.5);
+    EXPECT_GT(estimate.topValues[0].upper, 0.5);
+    EXPECT_EQ(estimate.topValues[1].value, "B");
+    EXPECT_DOUBLE_EQ(estimate.topValues[1].share, 0.25);
+}
+
+TEST(SampleEstimatorTest, ExactSampleHasNoUncertainty) {
+    SampleInfo info;
+    info.exact = true;
+    info.sampledRows = info.estimatedRows = 6;
+    info.blockRows = {6};
+
+    auto estimate = SampleEstimator::estimate({"a", "b", "a", "c", "a", "b"}, info);
+
+    EXPECT_DOUBLE_EQ(estimate.estimate, 3.0);
+    EXPECT_DOUBLE_EQ(estimate.lower, 3.0);
+    EXPECT_DOUBLE_EQ(estimate.upper, 3.0);
+    EXPECT_DOUBLE_EQ(estimate.topValues[0].share, 0.5);
+}
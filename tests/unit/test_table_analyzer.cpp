@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include "TableAnalyzer.h"
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+namespace {
+
+    std::string makeCsv(size_t rows) {
+        std::string csv = "id,city,score\n";
+        for (size_t i = 0; i < rows; ++i) {
+            csv += std::to_string(i) + ",city" + std::to_string(i % 7) + "," +
+                   std::to_string(i % 100) + ".5\n";
+        }
+        return csv;
+    }
+
+} // namespace
+
+TEST(TableAnalyzerTest, BufferMatchesFile) {
+    const std::string csv = makeCsv(5000);
+    const std::string path = "table_analyzer_test.csv";
+    std::ofstream(path) << csv;
+
+    TableAnalyzerOptions options;
+    options.numThreads = 2;
+    options.analyzerOptions.statistics = STAT_ALL;
+    TableAnalyzer analyzer(options);
+
+    auto fromBuffer = analyzer.analyzeBuffer(csv);
+    auto fromFile = analyzer.analyzeFile(path);
+    std::filesystem::remove(path);
+
+    ASSERT_EQ(fromBuffer.columns.size(), 3);
+    EXPECT_EQ(fromBuffer.headers, (std::vector<std::string>{"id", "city", "score"}));
+    EXPECT_EQ(fromBuffer.rowCount, 5000);
+    EXPECT_TRUE(fromBuffer.complete);
+
+    const size_t expected[] = {5000, 7, 100};
+    for (size_t c = 0; c < 3; ++c) {
+        EXPECT_EQ(fromBuffer.columns[c].uniqueCount, expected[c]);
+        EXPECT_EQ(fromBuffer.columns[c].uniqueValues, fromFile.columns[c].uniqueValues);
+        EXPECT_EQ(fromBuffer.columns[c].columnName, fromBuffer.headers[c]);
+        EXPECT_EQ(fromBuffer.columns[c].statistics.rowCount, 5000);
+    }
+    EXPECT_NEAR(fromBuffer.columns[2].statistics.mean, 50.0, 1e-9);
+
+    EXPECT_THROW(analyzer.analyzeFile("missing_table.csv"), std::runtime_error);
+}
+
+TEST(TableAnalyzerTest, QuietByDefault) {
+    TableAnalyzer analyzer(TableAnalyzerOptions{});
+
+    testing::internal::CaptureStdout();
+    testing::internal::CaptureStderr();
+    // Second row has a missing cell: the reader's warning is silenced too
+    auto result = analyzer.analyzeBuffer("a,b\n1,2\n3\n4,5");
+    EXPECT_EQ(testing::internal::GetCapturedStdout(), "");
+    EXPECT_EQ(testing::internal::GetCapturedStderr(), "");
+
+    EXPECT_EQ(result.rowCount, 2);  // No trailing newline, bad row skipped
+    EXPECT_EQ(result.columns[1].uniqueCount, 2);
+
+    // Quiet is scoped to the call
+    testing::internal::CaptureStdout();
+    std::cout << "after";
+    EXPECT_EQ(testing::internal::GetCapturedStdout(), "after");
+
+    EXPECT_TRUE(analyzer.analyzeBuffer("").columns.empty());
+}
+
+TEST(TableAnalyzerTest, PoolIsSharedAcrossConcurrentCalls) {
+    TableAnalyzerOptions options;
+    options.numThreads = 3;
+    TableAnalyzer analyzer(options);
+    EXPECT_EQ(analyzer.threads(), 3);
+
+    const std::string csv = makeCsv(2000);
+    std::vector<std::thread> callers;
+    std::vector<size_t> unique(4);
+    for (size_t t = 0; t < unique.size(); ++t) {
+        callers.emplace_back([&, t]() {
+            unique[t] = analyzer.analyzeBuffer(csv).columns[1].uniqueCount;
+        });
+    }
+    for (auto& caller : callers) {
+        caller.join();
+    }
+    EXPECT_EQ(unique, std::vector<size_t>(4, 7));
+}
+
+TEST(TableAnalyzerTest, CancelledCallIsIncomplete) {
+    TableAnalyzer analyzer(TableAnalyzerOptions{});
+    CSVTable table = CSVReader::parseBuffer(makeCsv(100));
+
+    CancellationToken token;
+    token.cancel();
+    auto result = analyzer.analyzeTable(table, &token);
+    EXPECT_FALSE(result.complete);
+    EXPECT_FALSE(result.columns[0].complete);
+
+    EXPECT_THROW(analyzer.analyzeBuffer(makeCsv(5000), &token), OperationCancelled);
+}
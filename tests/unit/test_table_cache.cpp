@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include "TableCache.h"
+#include "ThreadPool.h"
+#include <filesystem>
+#include <fstream>
+
+namespace fs = std::filesystem;
+
+class TableCacheTest : public ::testing::Test {
+protected:
+    std::string testDir = "test_cache_data";
+
+    void SetUp() override {
+        fs::create_directories(testDir);
+    }
+
+    void TearDown() override {
+        fs::remove_all(testDir);
+    }
+
+    std::string writeCsv(const std::string& name, const std::string& content) {
+        std::string path = testDir + "/" + name;
+        std::ofstream(path) << content;
+        return path;
+    }
+};
+
+TEST_F(TableCacheTest, HitAfterMiss) {
+    auto path = writeCsv("a.csv", "x,y\n1,2\n3,4\n");
+    TableCache cache(2);
+
+    bool cached = true;
+    auto first = cache.get(path, &cached);
+    EXPECT_FALSE(cached);
+    auto second = cache.get(path, &cached);
+    EXPECT_TRUE(cached);
+
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(first->headers, (std::vector<std::string>{"x", "y"}));
+    EXPECT_EQ(cache.hits(), 1);
+    EXPECT_EQ(cache.misses(), 1);
+}
+
+TEST_F(TableCacheTest, EvictsLeastRecentlyUsed) {
+    auto a = writeCsv("a.csv", "x\n1\n");
+    auto b = writeCsv("b.csv", "x\n2\n");
+    auto c = writeCsv("c.csv", "x\n3\n");
+    TableCache cache(2);
+
+    cache.get(a);
+    cache.get(b);
+    cache.get(a);  // a is now most recent
+    cache.get(c);  // evicts b
+
+    bool cached = false;
+    cache.get(a, &cached);
+    EXPECT_TRUE(cached);
+    cache.get(b, &cached);
+    EXPECT_FALSE(cached);
+    EXPECT_EQ(cache.size(), 2);
+}
+
+TEST_F(TableCacheTest, ReloadsChangedFile) {
+    auto path = writeCsv("a.csv", "x\n1\n");
+    TableCache cache(2);
+    cache.get(path);
+
+    writeCsv("a.csv", "x\n1\n2\n3\n");
+    bool cached = true;
+    auto table = cache.get(path, &cached);
+
+    EXPECT_FALSE(cached);
+    EXPECT_EQ(table->columns[0].size(), 3);
+}
+
+TEST_F(TableCacheTest, MissingFileThrows) {
+    TableCache cache(2);
+    EXPECT_THROW(cache.get(testDir + "/missing.csv"), fs::filesystem_error);
+}
+
+TEST(ThreadPoolTest, RunsSubmittedTasks) {
+    ThreadPool pool(3);
+    std::vector<std::future<int>> futures;
+    for (int i = 0; i < 20; ++i) {
+        futures.push_back(pool.submit([i]() { return i * i; }));
+    }
+
+    for (int i = 0; i < 20; ++i) {
+        EXPECT_EQ(futures[i].get(), i * i);
+    }
+    EXPECT_EQ(pool.size(), 3);
+}
@@ -0,0 +1,201 @@
+#include <gtest/gtest.h>
+#include "WorkerArena.h"
+#include "DistinctIndex.h"
+#include "ColumnAnalyzer.h"
+#include "CellHash.h"
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Allocation-counting hook: counts global operator new calls made by the
+// current thread while counting is enabled
+namespace {
+    thread_local bool countAllocations = false;
+    thread_local size_t allocationCount = 0;
+
+    class AllocationCounter {
+    public:
+        AllocationCounter() {
+            allocationCount = 0;
+            countAllocations = true;
+        }
+
+        ~AllocationCounter() { countAllocations = false; }
+
+        [[nodiscard]] size_t count() const { return allocationCount; }
+    };
+} // namespace
+
+void* operator new(size_t size) {
+    if (countAllocations) {
+        ++allocationCount;
+    }
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+    std::vector<std::string> lowCardinalityColumn(size_t rows) {
+        std::vector<std::string> column;
+        column.reserve(rows);
+        for (size_t i = 0; i < rows; ++i) {
+            column.push_back("v" + std::to_string(i % 4));
+        }
+        return column;
+    }
+
+    std::vector<std::string> uniqueColumn(size_t rows) {
+        std::vector<std::string> column;
+        column.reserve(rows);
+        for (size_t i = 0; i < rows; ++i) {
+            column.push_back("unique-value-" + std::to_string(i));
+        }
+        return column;
+    }
+} // namespace
+
+TEST(WorkerArenaTest, ReusesReleasedBlocks) {
+    WorkerArena arena;
+    std::pmr::vector<int> first(1000, 0, &arena);
+    EXPECT_EQ(arena.upstreamAllocations(), 1);
+
+    first = std::pmr::vector<int>(&arena);  // Block goes back to the arena
+    std::pmr::vector<int> second(900, 0, &arena);  // Same size class
+
+    EXPECT_EQ(arena.upstreamAllocations(), 1);
+    EXPECT_GE(arena.bytesHeld(), 1000 * sizeof(int));
+}
+
+TEST(WorkerArenaTest, IndexBuildIsAllocationFreeAfterWarmUp) {
+    auto column = uniqueColumn(50000);
+    std::vector<uint64_t> hashes;
+    for (const auto& value : column) {
+        hashes.push_back(CellHash::hash(value));
+    }
+
+    auto build = [&]() {
+        DistinctIndex index(0, &WorkerArena::local());
+        for (size_t row = 0; row < column.size(); ++row) {
+            index.insert(hashes[row], row, [&](size_t other) {
+                return column[other] == column[row];
+            });
+        }
+        return index.size();
+    };
+
+    EXPECT_EQ(build(), column.size());  // Warm-up
+
+    size_t distinct;
+    size_t allocations;
+    {
+        AllocationCounter counter;
+        distinct = build();
+        allocations = counter.count();
+    }
+    EXPECT_EQ(distinct, column.size());
+    EXPECT_EQ(allocations, 0);
+}
+
+TEST(WorkerArenaTest, AnalyzeAllocationsDoNotGrowWithRows) {
+    auto small = lowCardinalityColumn(10000);
+    auto large = lowCardinalityColumn(200000);
+
+    AnalyzerOptions options;
+    options.statistics = STAT_ALL;
+
+    for (auto backend : {DistinctBackend::HASH, DistinctBackend::SORT}) {
+        options.backend = backend;
+
+        // Warm-up: scratch blocks of both sizes end up cached in the arena
+        ColumnAnalyzer::analyze(0, small, options);
+        ColumnAnalyzer::analyze(0, large, options);
+
+        // Counts are read before asserting: gtest messages allocate too
+        size_t smallAllocations;
+        {
+            AllocationCounter counter;
+            auto result = ColumnAnalyzer::analyze(0, small, options);
+            smallAllocations = counter.count();
+            EXPECT_EQ(result.uniqueCount, 4);
+        }
+
+        size_t largeAllocations;
+        {
+            AllocationCounter counter;
+            auto result = ColumnAnalyzer::analyze(0, large, options);
+            largeAllocations = counter.count();
+            EXPECT_EQ(result.uniqueCount, 4);
+        }
+
+        // Only the result set and per-column setup allocate
+        EXPECT_EQ(largeAllocations, smallAllocations);
+        EXPECT_LT(largeAllocations, 32);
+    }
+}
+
+TEST(WorkerArenaTest, HighCardinalityAllocatesOnlyForResult) {
+    auto column = uniqueColumn(20000);
+    ColumnAnalyzer::analyze(0, column);  // Warm-up
+
+    size_t allocations;
+    ColumnResult result;
+    {
+        AllocationCounter counter;
+        result = ColumnAnalyzer::analyze(0, column);
+        allocations = counter.count();
+    }
+    EXPECT_EQ(result.uniqueCount, column.size());
+
+    // One node and one string per distinct value, plus the bucket array
+    EXPECT_LE(allocations, 2 * result.uniqueCount + 8);
+}
+
+TEST(WorkerArenaTest, CachedBytesAreCapped) {
+    WorkerArena arena;
+    arena.setCacheLimit(1 << 20);
+
+    // An index grown by doubling frees every intermediate slot array
+    {
+        DistinctIndex index(0, &arena);
+        for (size_t row = 0; row < 200000; ++row) {
+            index.insert(row * 0x9E3779B97F4A7C15ull + 1, row, [](size_t) { return false; });
+        }
+        EXPECT_GT(arena.bytesHeld(), size_t{1} << 20);
+    }
+    EXPECT_LE(arena.bytesCached(), arena.cacheLimit());
+    EXPECT_EQ(arena.bytesHeld(), arena.bytesCached());
+
+    // Small blocks are still reused
+    {
+        std::pmr::vector<int> block(1000, 0, &arena);
+    }
+    const size_t upstream = arena.upstreamAllocations();
+    {
+        std::pmr::vector<int> block(1000, 0, &arena);
+    }
+    EXPECT_EQ(arena.upstreamAllocations(), upstream);
+
+    arena.setCacheLimit(0);
+    EXPECT_EQ(arena.bytesHeld(), 0u);
+}
+
+TEST(WorkerArenaTest, EachThreadHasItsOwnArena) {
+    WorkerArena* mainArena = &WorkerArena::local();
+    WorkerArena* otherArena = nullptr;
+    std::thread([&]() { otherArena = &WorkerArena::local(); }).join();
+
+    EXPECT_NE(mainArena, otherArena);
+    EXPECT_EQ(mainArena, &WorkerArena::local());
+}